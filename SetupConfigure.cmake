@@ -206,6 +206,7 @@ endif()
 
 if (MUSE_COMPILE_ASAN)
     set(MUSE_ENABLE_CUSTOM_ALLOCATOR OFF)
+    set(MUSE_ENABLE_ARENA_ALLOCATOR OFF)
 endif()
 
 if (NOT MUE_BUILD_NOTATION_MODULE)
@@ -27,7 +27,9 @@ enum class DiagnosticType {
     GenDrawData,
     ComDrawData,
     DrawDataToPng,
-    DrawDiffToPng
+    DrawDiffToPng,
+    AudioMixerBenchmark,
+    EngravingBenchmark
 };
 
 struct CmdOptions {
@@ -38,6 +40,9 @@ struct CmdOptions {
         ScoreTransposeOptions,
         ForceMode,
         SoundProfile,
+        BatchWorkersCount,
+        BatchReportPath,
+        BatchWorkerArgs,
 
         // Video
     };
@@ -55,6 +60,7 @@ struct CmdOptions {
 
     struct {
         std::optional<bool> fullMigration;
+        std::optional<bool> layoutCacheEnabled;
     } project;
 
     struct {
@@ -90,6 +96,7 @@ struct CmdOptions {
     struct {
         std::optional<bool> revertToFactorySettings;
         std::optional<muse::logger::Level> loggerLevel;
+        std::optional<muse::io::path_t> traceFilePath;
     } app;
 
     struct {
@@ -21,6 +21,8 @@
  */
 #include "commandlineparser.h"
 
+#include <algorithm>
+
 #include <QDir>
 
 #include "global/io/dir.h"
@@ -66,59 +68,69 @@ void CommandLineParser::init()
 
     m_parser.addPositionalArgument("scorefiles", "The files to open", "[scorefile...]");
 
-    m_parser.addOption(QCommandLineOption("long-version", "Print detailed version information"));
-    m_parser.addOption(QCommandLineOption({ "d", "debug" }, "Debug mode"));
+    addOption(QCommandLineOption("long-version", "Print detailed version information"));
+    addOption(QCommandLineOption({ "d", "debug" }, "Debug mode"));
+    addOption(QCommandLineOption("trace", "Record a timeline of the app threads and save it on exit "
+                                          "as Chrome trace JSON (for ui.perfetto.dev)", "file"));
 
-    m_parser.addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
-    m_parser.addOption(QCommandLineOption({ "T", "trim-image" },
-                                          "Use with '-o <file>.png' and '-o <file.svg>'. Trim exported image with specified margin (in pixels)",
-                                          "margin"));
+    addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
+    addOption(QCommandLineOption({ "T", "trim-image" },
+                                 "Use with '-o <file>.png' and '-o <file.svg>'. Trim exported image with specified margin (in pixels)",
+                                 "margin"));
 
-    m_parser.addOption(QCommandLineOption({ "b", "bitrate" }, "Use with '-o <file>.mp3', sets bitrate, in kbps", "bitrate"));
+    addOption(QCommandLineOption({ "b", "bitrate" }, "Use with '-o <file>.mp3', sets bitrate, in kbps", "bitrate"));
 
-    m_parser.addOption(QCommandLineOption("template-mode", "Save template mode, no page size")); // and no platform and creationDate tags
-    m_parser.addOption(QCommandLineOption({ "t", "test-mode" }, "Set test mode flag for all files")); // this includes --template-mode
+    addOption(QCommandLineOption("template-mode", "Save template mode, no page size")); // and no platform and creationDate tags
+    addOption(QCommandLineOption({ "t", "test-mode" }, "Set test mode flag for all files")); // this includes --template-mode
 
-    m_parser.addOption(QCommandLineOption("session-type", "Startup with given session type", "type")); // see StartupScenario::sessionTypeTromString
+    addOption(QCommandLineOption("session-type", "Startup with given session type", "type")); // see StartupScenario::sessionTypeTromString
 
     // Converter mode
-    m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
-    m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
-    m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
-    m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
-    m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
-    m_parser.addOption(QCommandLineOption({ "M", "midi-operations" }, "Specify MIDI import operations file", "file"));
-    m_parser.addOption(QCommandLineOption({ "P", "export-score-parts" }, "Use with '-o <file>.pdf', export score and parts"));
-    m_parser.addOption(QCommandLineOption({ "f", "force" },
-                                          "Use with '-o <file>', ignore warnings reg. score being corrupted or from wrong version"));
-
-    m_parser.addOption(QCommandLineOption("score-media",
-                                          "Export all media (excepting mp3) for a given score in a single JSON file and print it to stdout"));
-    m_parser.addOption(QCommandLineOption("highlight-config", "Set highlight to svg, generated from a given score", "highlight-config"));
-    m_parser.addOption(QCommandLineOption("score-meta", "Export score metadata to JSON document and print it to stdout"));
-    m_parser.addOption(QCommandLineOption("score-parts", "Generate parts data for the given score and save them to separate mscz files"));
-    m_parser.addOption(QCommandLineOption("score-parts-pdf",
-                                          "Generate parts data for the given score and export the data to a single JSON file, print it to stdout"));
-    m_parser.addOption(QCommandLineOption("score-transpose",
-                                          "Transpose the given score and export the data to a single JSON file, print it to stdout",
-                                          "options"));
-    m_parser.addOption(QCommandLineOption("source-update", "Update the source in the given score"));
-
-    m_parser.addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
-
-    m_parser.addOption(QCommandLineOption("sound-profile",
-                                          "Use with '-o <file>.mp3' or with '-j <file>', override the sound profile in the given score(s). "
-                                          "Possible values: \"MuseScore Basic\", \"Muse Sounds\"", "sound-profile"));
+    addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
+    addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    addOption(QCommandLineOption("job-workers",
+                                 "Use with '-j <file>', process the jobs in N parallel worker processes. "
+                                 "0 - use all CPU cores", "N"));
+    addOption(QCommandLineOption("job-report",
+                                 "Use with '-j <file>', write a JSON summary with per-job status and timings", "file"));
+    addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
+    addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
+    addOption(QCommandLineOption({ "M", "midi-operations" }, "Specify MIDI import operations file", "file"));
+    addOption(QCommandLineOption({ "P", "export-score-parts" }, "Use with '-o <file>.pdf', export score and parts"));
+    addOption(QCommandLineOption("layout-cache",
+                                 "Use with '-o <file>' or '-j <file>', reuse the system breaks of the previous conversion "
+                                 "of an unchanged score, stored next to it in '<scorefile>.layoutcache'"));
+    addOption(QCommandLineOption({ "f", "force" },
+                                 "Use with '-o <file>', ignore warnings reg. score being corrupted or from wrong version"));
+
+    addOption(QCommandLineOption("score-media",
+                                 "Export all media (excepting mp3) for a given score in a single JSON file and print it to stdout"));
+    addOption(QCommandLineOption("highlight-config", "Set highlight to svg, generated from a given score", "highlight-config"));
+    addOption(QCommandLineOption("score-meta", "Export score metadata to JSON document and print it to stdout"));
+    addOption(QCommandLineOption("score-parts", "Generate parts data for the given score and save them to separate mscz files"));
+    addOption(QCommandLineOption("score-parts-pdf",
+                                 "Generate parts data for the given score and export the data to a single JSON file, print it to stdout"));
+    addOption(QCommandLineOption("score-transpose",
+                                 "Transpose the given score and export the data to a single JSON file, print it to stdout",
+                                 "options"));
+    addOption(QCommandLineOption("source-update", "Update the source in the given score"));
+
+    addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
+
+    addOption(QCommandLineOption("sound-profile",
+                                 "Use with '-o <file>.mp3' or with '-j <file>', override the sound profile in the given score(s). "
+                                 "Possible values: \"MuseScore Basic\", \"Muse Sounds\"", "sound-profile"));
 
     // MusicXML
-    m_parser.addOption(QCommandLineOption("musicxml-use-default-font",
-                                          "Apply default typeface (Edwin) to imported scores"));
-    m_parser.addOption(QCommandLineOption("musicxml-infer-text-type",
-                                          "Infer text type based on content where possible"));
+    addOption(QCommandLineOption("musicxml-use-default-font",
+                                 "Apply default typeface (Edwin) to imported scores"));
+    addOption(QCommandLineOption("musicxml-infer-text-type",
+                                 "Infer text type based on content where possible"));
 
     // Video export
 #ifdef MUE_BUILD_VIDEOEXPORT_MODULE
-    m_parser.addOption(QCommandLineOption("score-video", "Generate video for the given score and export it to file"));
+    addOption(QCommandLineOption("score-video", "Generate video for the given score and export it to file"));
 // not implemented
 //    m_parser.addOption(QCommandLineOption("view-mode",
 //                                          "View mode [paged-float, paged-original, paged-float-height, pano, auto]. Auto (default) will choose the best mode according to number of instruments etc... Will show piano for piano score only",
@@ -126,40 +138,53 @@ void CommandLineParser::init()
 // not implemented
 //    m_parser.addOption(QCommandLineOption("piano", "Show Piano, works only if one part and not auto or float modes"));
 //    m_parser.addOption(QCommandLineOption("piano-position", "Show Piano top or bottom. Default bottom", "bottom"));
-    m_parser.addOption(QCommandLineOption("resolution", "Resolution [2160p, 1440p, 1080p, 720p, 480p, 360p]", "1080p"));
-    m_parser.addOption(QCommandLineOption("fps", "Frame per second [60, 30, 24]", "24"));
-    m_parser.addOption(QCommandLineOption("ls", "Pause before playback in seconds (3.0)", "3.0"));
-    m_parser.addOption(QCommandLineOption("ts", "Pause before end of video in seconds (3.0)", "3.0"));
+    addOption(QCommandLineOption("resolution", "Resolution [2160p, 1440p, 1080p, 720p, 480p, 360p]", "1080p"));
+    addOption(QCommandLineOption("fps", "Frame per second [60, 30, 24]", "24"));
+    addOption(QCommandLineOption("ls", "Pause before playback in seconds (3.0)", "3.0"));
+    addOption(QCommandLineOption("ts", "Pause before end of video in seconds (3.0)", "3.0"));
 #endif
 
-    m_parser.addOption(QCommandLineOption("gp-linked", "create tabulature linked staves for guitar pro"));
-    m_parser.addOption(QCommandLineOption("gp-experimental", "experimental features for guitar pro import"));
+    addOption(QCommandLineOption("gp-linked", "create tabulature linked staves for guitar pro"));
+    addOption(QCommandLineOption("gp-experimental", "experimental features for guitar pro import"));
 
     //! NOTE Currently only implemented `full` mode
-    m_parser.addOption(QCommandLineOption("migration", "Whether to do migration with given mode, `full` - full migration", "mode"));
+    addOption(QCommandLineOption("migration", "Whether to do migration with given mode, `full` - full migration", "mode"));
 
     // Diagnostic
-    m_parser.addOption(QCommandLineOption("diagnostic-output", "Diagnostic output", "output"));
-    m_parser.addOption(QCommandLineOption("diagnostic-gen-drawdata", "Generate engraving draw data", "scores-dir"));
-    m_parser.addOption(QCommandLineOption("diagnostic-com-drawdata", "Compare engraving draw data"));
-    m_parser.addOption(QCommandLineOption("diagnostic-drawdata-to-png", "Convert draw data to png", "file"));
-    m_parser.addOption(QCommandLineOption("diagnostic-drawdiff-to-png", "Convert draw diff to png"));
+    addOption(QCommandLineOption("diagnostic-output", "Diagnostic output", "output"));
+    addOption(QCommandLineOption("diagnostic-gen-drawdata", "Generate engraving draw data", "scores-dir"));
+    addOption(QCommandLineOption("diagnostic-com-drawdata", "Compare engraving draw data"));
+    addOption(QCommandLineOption("diagnostic-drawdata-to-png", "Convert draw data to png", "file"));
+    addOption(QCommandLineOption("diagnostic-drawdiff-to-png", "Convert draw diff to png"));
+    addOption(QCommandLineOption("diagnostic-audio-mixer-benchmark",
+                                 "Render the given number of synthesized tracks through the mixer and print the block times",
+                                 "tracks"));
+    addOption(QCommandLineOption("diagnostic-engraving-benchmark",
+                                 "Read, lay out, draw and write the given scores (or the scores in the given dirs) "
+                                 "the given number of times and write the median timings to the diagnostic output as JSON",
+                                 "iterations"));
 
     // Autobot
-    m_parser.addOption(QCommandLineOption("test-case", "Run test case by name or file", "nameOrFile"));
-    m_parser.addOption(QCommandLineOption("test-case-context", "Set test case context by name or file", "nameOrFile"));
-    m_parser.addOption(QCommandLineOption("test-case-context-value", "Set test case context value", "value"));
-    m_parser.addOption(QCommandLineOption("test-case-func", "Call test case function", "name"));
-    m_parser.addOption(QCommandLineOption("test-case-func-args", "Call test case function args", "args"));
+    addOption(QCommandLineOption("test-case", "Run test case by name or file", "nameOrFile"));
+    addOption(QCommandLineOption("test-case-context", "Set test case context by name or file", "nameOrFile"));
+    addOption(QCommandLineOption("test-case-context-value", "Set test case context value", "value"));
+    addOption(QCommandLineOption("test-case-func", "Call test case function", "name"));
+    addOption(QCommandLineOption("test-case-func-args", "Call test case function args", "args"));
 
     // Audio plugins
-    m_parser.addOption(QCommandLineOption("register-audio-plugin",
-                                          "Check an audio plugin for compatibility with the application and register it", "path"));
-    m_parser.addOption(QCommandLineOption("register-failed-audio-plugin", "Register an incompatible audio plugin", "path"));
+    addOption(QCommandLineOption("register-audio-plugin",
+                                 "Check an audio plugin for compatibility with the application and register it", "path"));
+    addOption(QCommandLineOption("register-failed-audio-plugin", "Register an incompatible audio plugin", "path"));
 
     // Internal
-    m_parser.addOption(internalCommandLineOption("score-display-name-override",
-                                                 "Display name to be shown in splash screen for the score that is being opened", "name"));
+    addOption(internalCommandLineOption("score-display-name-override",
+                                        "Display name to be shown in splash screen for the score that is being opened", "name"));
+}
+
+void CommandLineParser::addOption(const QCommandLineOption& option)
+{
+    m_parser.addOption(option);
+    m_parserOptions.push_back(option);
 }
 
 void CommandLineParser::parse(int argc, char** argv)
@@ -212,6 +237,10 @@ void CommandLineParser::parse(int argc, char** argv)
         m_options.app.loggerLevel = logger::Level::Debug;
     }
 
+    if (m_parser.isSet("trace")) {
+        m_options.app.traceFilePath = fromUserInputPath(m_parser.value("trace"));
+    }
+
     if (m_parser.isSet("D")) {
         std::optional<double> val = doubleValue("D");
         if (val) {
@@ -243,6 +272,10 @@ void CommandLineParser::parse(int argc, char** argv)
         }
     }
 
+    if (m_parser.isSet("layout-cache")) {
+        m_options.project.layoutCacheEnabled = true;
+    }
+
     if (m_parser.isSet("template-mode")) {
         m_options.notation.templateModeEnabled = true;
     }
@@ -305,6 +338,23 @@ void CommandLineParser::parse(int argc, char** argv)
         m_options.runMode = IApplication::RunMode::ConsoleApp;
         m_options.converterTask.type = ConvertType::Batch;
         m_options.converterTask.inputFile = fromUserInputPath(m_parser.value("j"));
+
+        if (m_parser.isSet("job-workers")) {
+            std::optional<int> val = intValue("job-workers");
+            if (val && val.value() >= 0) {
+                m_options.converterTask.params[CmdOptions::ParamKey::BatchWorkersCount] = val.value();
+            } else {
+                LOGE() << "Option: --job-workers not recognized value: " << m_parser.value("job-workers");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_options.converterTask.params[CmdOptions::ParamKey::BatchReportPath] = fromUserInputPath(m_parser.value("job-report"));
+        }
+
+        //! NOTE The trace is recorded by the batch process only, otherwise all the workers would write the same file
+        m_options.converterTask.params[CmdOptions::ParamKey::BatchWorkerArgs]
+            = workerArguments({ "j", "job-workers", "job-report", "trace" });
     }
 
     if (m_parser.isSet("score-media")) {
@@ -463,6 +513,19 @@ void CommandLineParser::parse(int argc, char** argv)
         m_options.diagnostic.input = scorefiles;
     }
 
+    if (m_parser.isSet("diagnostic-audio-mixer-benchmark")) {
+        m_options.runMode = IApplication::RunMode::ConsoleApp;
+        m_options.diagnostic.type = DiagnosticType::AudioMixerBenchmark;
+        m_options.diagnostic.input << m_parser.value("diagnostic-audio-mixer-benchmark");
+    }
+
+    if (m_parser.isSet("diagnostic-engraving-benchmark")) {
+        m_options.runMode = IApplication::RunMode::ConsoleApp;
+        m_options.diagnostic.type = DiagnosticType::EngravingBenchmark;
+        m_options.diagnostic.input << m_parser.value("diagnostic-engraving-benchmark");
+        m_options.diagnostic.input << scorefiles;
+    }
+
     // Autobot
     if (m_parser.isSet("test-case")) {
         m_options.runMode = IApplication::RunMode::ConsoleApp;
@@ -543,3 +606,41 @@ void CommandLineParser::printLongVersion() const
                BaseApplication::appVersion().toStdString().c_str(), BaseApplication::appRevision().toStdString().c_str());
     }
 }
+
+QStringList CommandLineParser::workerArguments(const QStringList& excludedOptions) const
+{
+    //! NOTE The options of this process (style, force mode, sound profile, image resolution, etc.),
+    //! rebuilt from the parsed values, so that every value stays with its option
+    QStringList result;
+
+    for (const QCommandLineOption& option : m_parserOptions) {
+        const QStringList names = option.names();
+        if (!m_parser.isSet(names.front())) {
+            continue;
+        }
+
+        const bool isExcluded = std::any_of(names.cbegin(), names.cend(), [&excludedOptions](const QString& name) {
+            return excludedOptions.contains(name);
+        });
+
+        if (isExcluded) {
+            continue;
+        }
+
+        const QString& name = names.back();
+        const QString arg = (name.size() == 1 ? "-" : "--") + name;
+
+        if (option.valueName().isEmpty()) {
+            result << arg;
+            continue;
+        }
+
+        for (const QString& value : m_parser.values(names.front())) {
+            result << arg << value;
+        }
+    }
+
+    result << m_parser.positionalArguments();
+
+    return result;
+}
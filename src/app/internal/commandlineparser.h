@@ -22,6 +22,8 @@
 #ifndef MU_APP_COMMANDLINEPARSER_H
 #define MU_APP_COMMANDLINEPARSER_H
 
+#include <vector>
+
 #include <QCommandLineParser>
 #include <QStringList>
 
@@ -53,9 +55,13 @@ public:
     CmdOptions::AudioPluginRegistration audioPluginRegistration() const;
 
 private:
+    void addOption(const QCommandLineOption& option);
     void printLongVersion() const;
 
+    QStringList workerArguments(const QStringList& excludedOptions) const;
+
     QCommandLineParser m_parser;
+    std::vector<QCommandLineOption> m_parserOptions;
     CmdOptions m_options;
 };
 }
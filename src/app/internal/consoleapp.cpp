@@ -23,6 +23,7 @@
 #include "consoleapp.h"
 
 #include <QApplication>
+#include <QEventLoop>
 #ifndef Q_OS_WASM
 #include <QThreadPool>
 #endif
@@ -230,6 +231,10 @@ void ConsoleApp::applyCommandLineOptions(const CmdOptions& options, IApplication
         for (project::MigrationType type : project::allMigrationTypes()) {
             projectConfiguration()->setMigrationOptions(type, migration, false);
         }
+
+        if (options.project.layoutCacheEnabled) {
+            projectConfiguration()->setLayoutCacheEnabled(options.project.layoutCacheEnabled.value());
+        }
     }
 
 #ifdef MUE_BUILD_IMAGESEXPORT_MODULE
@@ -260,6 +265,10 @@ void ConsoleApp::applyCommandLineOptions(const CmdOptions& options, IApplication
     if (options.app.loggerLevel) {
         m_globalModule.setLoggerLevel(options.app.loggerLevel.value());
     }
+
+    if (options.app.traceFilePath) {
+        m_globalModule.setTraceFilePath(options.app.traceFilePath.value());
+    }
 }
 
 int ConsoleApp::processConverter(const CmdOptions::ConverterTask& task)
@@ -275,9 +284,22 @@ int ConsoleApp::processConverter(const CmdOptions::ConverterTask& task)
     }
 
     switch (task.type) {
-    case ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, soundProfile);
-        break;
+    case ConvertType::Batch: {
+        //! NOTE 1 - sequential conversion in this process, 0 - one worker per CPU core
+        size_t workersCount = 1;
+        if (task.params.contains(CmdOptions::ParamKey::BatchWorkersCount)) {
+            workersCount = static_cast<size_t>(task.params[CmdOptions::ParamKey::BatchWorkersCount].toInt());
+        }
+
+        muse::io::path_t reportPath = task.params[CmdOptions::ParamKey::BatchReportPath].toString();
+
+        muse::StringList workerArgs;
+        for (const QString& arg : task.params[CmdOptions::ParamKey::BatchWorkerArgs].toStringList()) {
+            workerArgs.push_back(muse::String::fromQString(arg));
+        }
+
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, soundProfile, workersCount, reportPath, workerArgs);
+    } break;
     case ConvertType::File:
         ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode, soundProfile);
         break;
@@ -319,6 +341,14 @@ int ConsoleApp::processConverter(const CmdOptions::ConverterTask& task)
 
 int ConsoleApp::processDiagnostic(const CmdOptions::Diagnostic& task)
 {
+    if (task.type == DiagnosticType::AudioMixerBenchmark) {
+        return processAudioMixerBenchmark(task);
+    }
+
+    if (task.type == DiagnosticType::EngravingBenchmark) {
+        return processEngravingBenchmark(task);
+    }
+
     if (!diagnosticDrawProvider()) {
         return make_ret(Ret::Code::NotSupported);
     }
@@ -372,6 +402,94 @@ int ConsoleApp::processDiagnostic(const CmdOptions::Diagnostic& task)
     return ret.code();
 }
 
+int ConsoleApp::processAudioMixerBenchmark(const CmdOptions::Diagnostic& task)
+{
+    if (!playback()) {
+        return make_ret(Ret::Code::NotSupported).code();
+    }
+
+    audio::MixerBenchmarkParams params;
+    if (!task.input.isEmpty()) {
+        bool ok = false;
+        int tracksCount = task.input.front().toInt(&ok);
+        if (!ok || tracksCount <= 0) {
+            LOGE() << "Option: --diagnostic-audio-mixer-benchmark not recognized value: " << task.input.front();
+            return make_ret(Ret::Code::UnknownError).code();
+        }
+        params.tracksCount = static_cast<size_t>(tracksCount);
+    }
+
+    bool isCompleted = false;
+    Ret ret = make_ret(Ret::Code::Ok);
+    QEventLoop loop;
+
+    playback()->audioOutput()->runMixerBenchmark(params)
+    .onResolve(this, [&isCompleted, &loop](const audio::MixerBenchmarkResult& result) {
+        LOGI() << "mixer benchmark: tracks: " << result.params.tracksCount
+               << ", samples per channel: " << result.params.samplesPerChannel
+               << ", blocks: " << result.params.blocksCount
+               << ", block budget: " << result.blockBudgetMsecs << " ms"
+               << ", avg: " << result.avgBlockMsecs << " ms"
+               << ", worst: " << result.worstBlockMsecs << " ms"
+               << ", overruns: " << result.overrunsCount;
+        isCompleted = true;
+        loop.quit();
+    })
+    .onReject(this, [&isCompleted, &loop, &ret](int code, const std::string& msg) {
+        ret = Ret(code, msg);
+        isCompleted = true;
+        loop.quit();
+    });
+
+    //! NOTE Sleeps until the result is delivered to this thread
+    if (!isCompleted) {
+        loop.exec();
+    }
+
+    if (!ret) {
+        LOGE() << "diagnostic ret: " << ret.toString();
+    }
+
+    return ret.code();
+}
+
+int ConsoleApp::processEngravingBenchmark(const CmdOptions::Diagnostic& task)
+{
+    if (!engravingBenchmark()) {
+        return make_ret(Ret::Code::NotSupported).code();
+    }
+
+    if (task.input.size() < 2) {
+        LOGE() << "Option: --diagnostic-engraving-benchmark requires scores or score dirs";
+        return make_ret(Ret::Code::UnknownError).code();
+    }
+
+    engraving::BenchmarkOpt opt;
+    bool ok = false;
+    opt.iterations = task.input.front().toInt(&ok);
+    if (!ok || opt.iterations <= 0) {
+        LOGE() << "Option: --diagnostic-engraving-benchmark not recognized value: " << task.input.front();
+        return make_ret(Ret::Code::UnknownError).code();
+    }
+
+    io::paths_t input;
+    for (int i = 1; i < task.input.size(); ++i) {
+        input.push_back(task.input.at(i));
+    }
+
+    muse::io::path_t output = task.output;
+    if (output.empty()) {
+        output = "./engraving_benchmark.json";
+    }
+
+    Ret ret = engravingBenchmark()->runBenchmark(input, output, opt);
+    if (!ret) {
+        LOGE() << "diagnostic ret: " << ret.toString();
+    }
+
+    return ret.code();
+}
+
 int ConsoleApp::processAudioPluginRegistration(const CmdOptions::AudioPluginRegistration& task)
 {
     Ret ret = make_ret(Ret::Code::Ok);
@@ -30,14 +30,17 @@
 #include "../cmdoptions.h"
 
 #include "global/globalmodule.h"
+#include "global/async/asyncable.h"
 
 #include "modularity/imodulesetup.h"
 #include "modularity/ioc.h"
 #include "global/iapplication.h"
 #include "converter/iconvertercontroller.h"
 #include "engraving/devtools/drawdata/idiagnosticdrawprovider.h"
+#include "engraving/devtools/benchmark/iengravingbenchmark.h"
 #include "autobot/iautobot.h"
 #include "audioplugins/iregisteraudiopluginsscenario.h"
+#include "audio/iplayback.h"
 #include "multiinstances/imultiinstancesprovider.h"
 
 #include "ui/iuiconfiguration.h"
@@ -54,13 +57,15 @@
 #include "importexport/musicxml/imusicxmlconfiguration.h"
 
 namespace mu::app {
-class ConsoleApp : public muse::BaseApplication, public std::enable_shared_from_this<ConsoleApp>
+class ConsoleApp : public muse::BaseApplication, public muse::async::Asyncable, public std::enable_shared_from_this<ConsoleApp>
 {
     muse::Inject<muse::IApplication> muapplication;
     muse::Inject<converter::IConverterController> converter;
     muse::Inject<engraving::IDiagnosticDrawProvider> diagnosticDrawProvider;
+    muse::Inject<engraving::IEngravingBenchmark> engravingBenchmark;
     muse::Inject<muse::autobot::IAutobot> autobot;
     muse::Inject<muse::audioplugins::IRegisterAudioPluginsScenario> registerAudioPluginsScenario;
+    muse::Inject<muse::audio::IPlayback> playback;
     muse::Inject<muse::mi::IMultiInstancesProvider> multiInstancesProvider;
     muse::Inject<muse::ui::IUiConfiguration> uiConfiguration;
     muse::Inject<appshell::IAppShellConfiguration> appshellConfiguration;
@@ -87,6 +92,8 @@ private:
     void applyCommandLineOptions(const CmdOptions& options, muse::IApplication::RunMode runMode);
     int processConverter(const CmdOptions::ConverterTask& task);
     int processDiagnostic(const CmdOptions::Diagnostic& task);
+    int processAudioMixerBenchmark(const CmdOptions::Diagnostic& task);
+    int processEngravingBenchmark(const CmdOptions::Diagnostic& task);
     int processAudioPluginRegistration(const CmdOptions::AudioPluginRegistration& task);
     void processAutobot(const CmdOptions::Autobot& task);
 
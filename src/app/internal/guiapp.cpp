@@ -261,4 +261,8 @@ void GuiApp::applyCommandLineOptions(const CmdOptions& options)
     if (options.app.loggerLevel) {
         m_globalModule.setLoggerLevel(options.app.loggerLevel.value());
     }
+
+    if (options.app.traceFilePath) {
+        m_globalModule.setTraceFilePath(options.app.traceFilePath.value());
+    }
 }
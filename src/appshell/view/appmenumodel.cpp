@@ -350,6 +350,9 @@ MenuItem* AppMenuModel::makeDiagnosticMenu()
     MenuItemList systemItems {
         makeMenuItem("diagnostic-show-paths"),
         makeMenuItem("diagnostic-show-profiler"),
+        makeSeparator(),
+        makeMenuItem("diagnostic-start-tracing"),
+        makeMenuItem("diagnostic-stop-tracing"),
     };
 
     MenuItemList items {
@@ -372,6 +375,7 @@ MenuItem* AppMenuModel::makeDiagnosticMenu()
     if (globalConfiguration()->devModeEnabled()) {
         MenuItemList engravingItems {
             makeMenuItem("diagnostic-show-engraving-elements"),
+            makeMenuItem("diagnostic-print-memory-state"),
             makeSeparator(),
             makeMenuItem("show-element-bounding-rects"),
             makeMenuItem("color-element-shapes"),
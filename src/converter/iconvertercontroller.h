@@ -38,7 +38,9 @@ public:
                                   const muse::String& soundProfile = muse::String()) = 0;
     virtual muse::Ret batchConvert(const muse::io::path_t& batchJobFile,
                                    const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
-                                   const muse::String& soundProfile = muse::String()) = 0;
+                                   const muse::String& soundProfile = muse::String(), size_t workersCount = 1,
+                                   const muse::io::path_t& reportPath = muse::io::path_t(),
+                                   const muse::StringList& workerArgs = muse::StringList()) = 0;
 
     virtual muse::Ret convertScoreParts(const muse::io::path_t& in, const muse::io::path_t& out,
                                         const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false) = 0;
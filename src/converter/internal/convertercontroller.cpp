@@ -21,10 +21,18 @@
  */
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <functional>
+
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QProcess>
+#include <QThread>
 
 #include "global/io/file.h"
 #include "global/io/dir.h"
@@ -46,7 +54,8 @@ static const std::string PNG_SUFFIX = "png";
 static const std::string SVG_SUFFIX = "svg";
 
 Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, const muse::io::path_t& stylePath, bool forceMode,
-                                      const String& soundProfile)
+                                      const String& soundProfile, size_t workersCount, const muse::io::path_t& reportPath,
+                                      const StringList& workerArgs)
 {
     TRACEFUNC;
 
@@ -56,13 +65,39 @@ Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, cons
         return batchJob.ret;
     }
 
+    if (workersCount == 0) {
+        workersCount = static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+    }
+
+    workersCount = std::min(workersCount, std::max(batchJob.val.size(), size_t(1)));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    //! NOTE The engraving and the global context are not thread-safe,
+    //! so the jobs are processed in separate worker processes, each of them has its own MasterScore
+    BatchResult result = workersCount > 1
+                         ? runJobsInWorkerProcesses(batchJob.val, workersCount, workerArgs)
+                         : runJobsSequentially(batchJob.val, stylePath, forceMode, soundProfile);
+
+    int64_t totalElapsedMs = timer.elapsed();
+
     StringList errors;
 
-    for (const Job& job : batchJob.val) {
-        Ret ret = fileConvert(job.in, job.out, stylePath, forceMode, soundProfile);
-        if (!ret) {
+    for (const JobResult& r : result) {
+        if (!r.ret) {
             errors.emplace_back(String(u"failed convert, err: %1, in: %2, out: %3")
-                                .arg(String::fromStdString(ret.toString())).arg(job.in.toString()).arg(job.out.toString()));
+                                .arg(String::fromStdString(r.ret.toString())).arg(r.job.in.toString()).arg(r.job.out.toString()));
+        }
+    }
+
+    LOGI() << "batch converted: " << result.size() - errors.size() << "/" << result.size()
+           << ", workers: " << workersCount << ", elapsed: " << totalElapsedMs << " ms";
+
+    if (!reportPath.empty()) {
+        Ret ret = writeBatchReport(reportPath, result, workersCount, totalElapsedMs);
+        if (!ret) {
+            LOGE() << "failed write batch report, err: " << ret.toString() << ", path: " << reportPath;
         }
     }
 
@@ -73,6 +108,166 @@ Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, cons
     return make_ret(Ret::Code::Ok);
 }
 
+ConverterController::BatchResult ConverterController::runJobsSequentially(const BatchJob& batchJob, const muse::io::path_t& stylePath,
+                                                                          bool forceMode, const String& soundProfile)
+{
+    BatchResult result;
+    result.reserve(batchJob.size());
+
+    QElapsedTimer timer;
+
+    for (const Job& job : batchJob) {
+        timer.start();
+
+        JobResult& r = result.emplace_back();
+        r.job = job;
+        r.ret = fileConvert(job.in, job.out, stylePath, forceMode, soundProfile);
+        r.elapsedMs = timer.elapsed();
+    }
+
+    return result;
+}
+
+ConverterController::BatchResult ConverterController::runJobsInWorkerProcesses(const BatchJob& batchJob, size_t workersCount,
+                                                                               const StringList& workerArgs) const
+{
+    TRACEFUNC;
+
+    const QString program = QCoreApplication::applicationFilePath();
+
+    //! NOTE The options of the batch process, except the batch ones (see the command line parser)
+    QStringList baseArgs;
+    for (const String& arg : workerArgs) {
+        baseArgs << arg.toQString();
+    }
+
+    const size_t jobsCount = batchJob.size();
+
+    BatchResult result(jobsCount);
+    std::vector<qint64> startedAt(jobsCount, 0);
+
+    auto jobIt = batchJob.cbegin();
+    size_t nextJobIdx = 0;
+    size_t finishedCount = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QEventLoop loop;
+
+    std::function<void()> startNextJob;
+
+    auto onJobFinished = [&](size_t idx, const Ret& ret) {
+        JobResult& r = result[idx];
+        r.ret = ret;
+        r.elapsedMs = timer.elapsed() - startedAt[idx];
+
+        ++finishedCount;
+
+        LOGI() << "[" << finishedCount << "/" << jobsCount << "] " << (ret ? "done" : "failed")
+               << ", in: " << r.job.in << ", elapsed: " << r.elapsedMs << " ms";
+
+        if (nextJobIdx < jobsCount) {
+            startNextJob();
+        } else if (finishedCount == jobsCount) {
+            loop.quit();
+        }
+    };
+
+    startNextJob = [&]() {
+        const size_t idx = nextJobIdx++;
+        const Job& job = *jobIt++;
+
+        result[idx].job = job;
+        startedAt[idx] = timer.elapsed();
+
+        QStringList args = baseArgs;
+        args << "-o" << job.out.toQString() << job.in.toQString();
+
+        QProcess* process = new QProcess();
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+        QObject::connect(process, &QProcess::finished, [&, process, idx](int exitCode, QProcess::ExitStatus exitStatus) {
+            process->deleteLater();
+
+            if (exitStatus != QProcess::NormalExit) {
+                onJobFinished(idx, make_ret(Err::ConvertFailed, "worker process crashed"));
+            } else if (exitCode != 0) {
+                onJobFinished(idx, make_ret(Err::ConvertFailed, "worker process exit code: " + std::to_string(exitCode)));
+            } else {
+                onJobFinished(idx, make_ret(Ret::Code::Ok));
+            }
+        });
+
+        QObject::connect(process, &QProcess::errorOccurred, [&, process, idx](QProcess::ProcessError error) {
+            //! NOTE In other cases `finished` will be emitted
+            if (error != QProcess::FailedToStart) {
+                return;
+            }
+
+            process->deleteLater();
+            onJobFinished(idx, make_ret(Err::ConvertFailed, "failed start worker process"));
+        });
+
+        process->start(program, args);
+    };
+
+    if (jobsCount == 0) {
+        return result;
+    }
+
+    for (size_t i = 0; i < workersCount; ++i) {
+        startNextJob();
+    }
+
+    loop.exec();
+
+    return result;
+}
+
+Ret ConverterController::writeBatchReport(const muse::io::path_t& reportPath, const BatchResult& result, size_t workersCount,
+                                          int64_t totalElapsedMs) const
+{
+    TRACEFUNC;
+
+    QJsonArray jobs;
+    size_t failedCount = 0;
+
+    for (const JobResult& r : result) {
+        QJsonObject obj;
+        obj["in"] = r.job.in.toQString();
+        obj["out"] = r.job.out.toQString();
+        obj["success"] = r.ret.success();
+        obj["elapsedMs"] = static_cast<qint64>(r.elapsedMs);
+
+        if (!r.ret) {
+            obj["errorCode"] = r.ret.code();
+            obj["error"] = QString::fromStdString(r.ret.toString());
+            ++failedCount;
+        }
+
+        jobs.append(obj);
+    }
+
+    QJsonObject root;
+    root["workers"] = static_cast<qint64>(workersCount);
+    root["total"] = static_cast<qint64>(result.size());
+    root["failed"] = static_cast<qint64>(failedCount);
+    root["elapsedMs"] = static_cast<qint64>(totalElapsedMs);
+    root["jobs"] = jobs;
+
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    if (file.write(QJsonDocument(root).toJson()) < 0) {
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 Ret ConverterController::fileConvert(const muse::io::path_t& in, const muse::io::path_t& out, const muse::io::path_t& stylePath,
                                      bool forceMode,
                                      const String& soundProfile)
@@ -23,6 +23,9 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
+
+#include <QStringList>
 
 #include "../iconvertercontroller.h"
 
@@ -51,7 +54,9 @@ public:
                           const muse::String& soundProfile = muse::String()) override;
     muse::Ret batchConvert(const muse::io::path_t& batchJobFile,
                            const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
-                           const muse::String& soundProfile = muse::String()) override;
+                           const muse::String& soundProfile = muse::String(), size_t workersCount = 1,
+                           const muse::io::path_t& reportPath = muse::io::path_t(),
+                           const muse::StringList& workerArgs = muse::StringList()) override;
 
     muse::Ret convertScoreParts(const muse::io::path_t& in, const muse::io::path_t& out,
                                 const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false) override;
@@ -81,8 +86,23 @@ private:
 
     using BatchJob = std::list<Job>;
 
+    struct JobResult {
+        Job job;
+        muse::Ret ret;
+        int64_t elapsedMs = 0;
+    };
+
+    using BatchResult = std::vector<JobResult>;
+
     muse::RetVal<BatchJob> parseBatchJob(const muse::io::path_t& batchJobFile) const;
 
+    BatchResult runJobsSequentially(const BatchJob& batchJob, const muse::io::path_t& stylePath, bool forceMode,
+                                    const muse::String& soundProfile);
+    BatchResult runJobsInWorkerProcesses(const BatchJob& batchJob, size_t workersCount, const muse::StringList& workerArgs) const;
+
+    muse::Ret writeBatchReport(const muse::io::path_t& reportPath, const BatchResult& result, size_t workersCount,
+                               int64_t totalElapsedMs) const;
+
     bool isConvertPageByPage(const std::string& suffix) const;
     muse::Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const muse::io::path_t& out) const;
     muse::Ret convertFullNotation(project::INotationWriterPtr writer, notation::INotationPtr notation, const muse::io::path_t& out) const;
@@ -30,6 +30,7 @@
 using namespace mu::engraving::apiv1;
 Score* Excerpt::partScore()
 {
+    e->readDeferred();
     return wrap<mu::engraving::apiv1::Score>(e->excerptScore(), Ownership::SCORE);
 }
 
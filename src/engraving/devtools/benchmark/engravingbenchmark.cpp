@@ -0,0 +1,510 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "engravingbenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#if defined(Q_OS_WIN) || defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "global/io/buffer.h"
+#include "global/io/dir.h"
+#include "global/io/file.h"
+#include "global/io/fileinfo.h"
+#include "global/memoryarena.h"
+#include "global/serialization/json.h"
+
+#include "draw/painter.h"
+#include "draw/ipaintprovider.h"
+
+#include "engraving/engravingproject.h"
+#include "engraving/infrastructure/localfileinfoprovider.h"
+#include "engraving/infrastructure/mscreader.h"
+#include "engraving/infrastructure/mscwriter.h"
+#include "engraving/dom/masterscore.h"
+#include "engraving/types/propertyvalue.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::draw;
+using namespace mu::engraving;
+
+// --diagnostic-engraving-benchmark 5 ./vtest/scores ./engraving/tests --diagnostic-output ./engraving_benchmark.json
+
+static const std::vector<std::string> FILES_FILTER = { "*.mscz", "*.mscx" };
+
+namespace {
+//! NOTE Keeps the state the painter may ask for, draws nothing
+class NullPaintProvider : public IPaintProvider
+{
+public:
+    bool isActive() const override { return m_isActive; }
+    void beginTarget(const std::string&) override { m_isActive = true; }
+    void beforeEndTargetHook(Painter*) override {}
+    bool endTarget(bool) override
+    {
+        m_isActive = false;
+        return true;
+    }
+
+    void beginObject(const std::string&) override {}
+    void endObject() override {}
+
+    void setAntialiasing(bool) override {}
+    void setCompositionMode(CompositionMode) override {}
+    void setWindow(const RectF&) override {}
+    void setViewport(const RectF&) override {}
+
+    void setFont(const Font& font) override { m_state.font = font; }
+    const Font& font() const override { return m_state.font; }
+
+    void setPen(const Pen& pen) override { m_state.pen = pen; }
+    void setNoPen() override { m_state.pen.setStyle(PenStyle::NoPen); }
+    const Pen& pen() const override { return m_state.pen; }
+
+    void setBrush(const Brush& brush) override { m_state.brush = brush; }
+    const Brush& brush() const override { return m_state.brush; }
+
+    void save() override { m_states.push_back(m_state); }
+    void restore() override
+    {
+        IF_ASSERT_FAILED(!m_states.empty()) {
+            return;
+        }
+        m_state = m_states.back();
+        m_states.pop_back();
+    }
+
+    void setTransform(const Transform& transform) override { m_state.transform = transform; }
+    const Transform& transform() const override { return m_state.transform; }
+
+    void drawPath(const PainterPath&) override {}
+    void drawPolygon(const PointF*, size_t, PolygonMode) override {}
+
+    void drawText(const PointF&, const String&) override {}
+    void drawText(const RectF&, int, const String&) override {}
+    void drawTextWorkaround(const Font&, const PointF&, const String&) override {}
+
+    void drawSymbol(const PointF&, char32_t) override {}
+
+    void drawPixmap(const PointF&, const Pixmap&) override {}
+    void drawTiledPixmap(const RectF&, const Pixmap&, const PointF&) override {}
+
+#ifndef NO_QT_SUPPORT
+    void drawPixmap(const PointF&, const QPixmap&) override {}
+    void drawTiledPixmap(const RectF&, const QPixmap&, const PointF&) override {}
+#endif
+
+    bool hasClipping() const override { return m_state.isClipping; }
+    void setClipRect(const RectF&) override { m_state.isClipping = true; }
+    void setClipping(bool enable) override { m_state.isClipping = enable; }
+
+private:
+    struct State {
+        Font font;
+        Pen pen;
+        Brush brush;
+        Transform transform;
+        bool isClipping = false;
+    };
+
+    bool m_isActive = false;
+    State m_state;
+    std::vector<State> m_states;
+};
+
+class Timer
+{
+public:
+    Timer()
+        : m_start(std::chrono::steady_clock::now()) {}
+
+    double elapsedMs() const
+    {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+        return elapsed.count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+}
+
+static double peakRssBytes()
+{
+#if defined(Q_OS_WIN) || defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<double>(counters.PeakWorkingSetSize);
+    }
+    return 0.0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+#if defined(Q_OS_MAC) || defined(__APPLE__)
+    return static_cast<double>(usage.ru_maxrss); // bytes
+#else
+    return static_cast<double>(usage.ru_maxrss) * 1024.0; // kilobytes
+#endif
+#endif
+}
+
+static double median(std::vector<double> values)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    if (values.size() % 2 == 0) {
+        return (values.at(mid - 1) + values.at(mid)) / 2.0;
+    }
+
+    return values.at(mid);
+}
+
+Ret EngravingBenchmark::runBenchmark(const io::paths_t& dirsOrFiles, const io::path_t& outFile, const BenchmarkOpt& opt)
+{
+    IF_ASSERT_FAILED(opt.iterations > 0) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    io::paths_t scores = scanScores(dirsOrFiles);
+    if (scores.empty()) {
+        LOGE() << "no scores found";
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    using Field = double Sample::*;
+    static const std::vector<std::pair<std::string, Field> > FIELDS = {
+        { "read", &Sample::read },
+        { "layout", &Sample::layout },
+        { "layoutResetPass", &Sample::layoutResetPass },
+        { "layoutIndependentItemsPass", &Sample::layoutIndependentItemsPass },
+        { "layoutMeasures", &Sample::layoutMeasures },
+        { "layoutSystems", &Sample::layoutSystems },
+        { "layoutPages", &Sample::layoutPages },
+        { "draw", &Sample::draw },
+        { "propertySweep", &Sample::propertySweep },
+        { "write", &Sample::write },
+        { "writeSerialize", &Sample::writeSerialize },
+        { "writePack", &Sample::writePack },
+        { "writtenBytes", &Sample::writtenBytes },
+        { "readPropertyAllocations", &Sample::readPropertyAllocations },
+        { "sweepPropertyAllocations", &Sample::sweepPropertyAllocations },
+        { "sweepPropertyValues", &Sample::sweepPropertyValues },
+        { "sweepNonDefaultPropertyValues", &Sample::sweepNonDefaultPropertyValues },
+        { "allocatedCount", &Sample::allocatedCount },
+        { "allocatedBytes", &Sample::allocatedBytes },
+    };
+
+    Sample total;
+    int failed = 0;
+    JsonArray scoresJson;
+
+    for (size_t i = 0; i < scores.size(); ++i) {
+        const io::path_t& scorePath = scores.at(i);
+        LOGI() << "benchmark: " << (i + 1) << "/" << scores.size() << " " << scorePath;
+
+        JsonObject scoreJson;
+        scoreJson["file"] = scorePath.toStdString();
+
+        std::vector<Sample> samples;
+        Ret ret = make_ok();
+        for (int n = 0; n < opt.iterations && ret; ++n) {
+            Sample sample;
+            ret = runOnce(scorePath, sample);
+            samples.push_back(sample);
+        }
+
+        if (!ret) {
+            LOGE() << "failed: " << scorePath << ", err: " << ret.toString();
+            scoreJson["error"] = ret.toString();
+            scoresJson.append(scoreJson);
+            ++failed;
+            continue;
+        }
+
+        Sample med;
+        med.measures = samples.front().measures;
+        med.pages = samples.front().pages;
+        med.parts = samples.front().parts;
+        for (const auto& f : FIELDS) {
+            std::vector<double> values;
+            for (const Sample& s : samples) {
+                values.push_back(s.*(f.second));
+            }
+            med.*(f.second) = median(values);
+            total.*(f.second) += med.*(f.second);
+        }
+        total.measures += med.measures;
+        total.pages += med.pages;
+        total.parts += med.parts;
+
+        scoreJson["median"] = sampleToJson(med);
+        scoresJson.append(scoreJson);
+    }
+
+    JsonObject root;
+    root["iterations"] = opt.iterations;
+    root["arenaEnabled"] = MemoryArena::enabled();
+    root["peakRssBytes"] = peakRssBytes();
+    root["scoresCount"] = static_cast<int>(scores.size());
+    root["failedCount"] = failed;
+    root["total"] = sampleToJson(total);
+    root["scores"] = scoresJson;
+
+    LOGI() << "benchmark: scores: " << scores.size() << ", failed: " << failed
+           << ", read: " << total.read << " ms"
+           << ", layout: " << total.layout << " ms"
+           << ", draw: " << total.draw << " ms"
+           << ", property sweep: " << total.propertySweep << " ms"
+           << ", write: " << total.write << " ms"
+           << " (serialize: " << total.writeSerialize << " ms"
+           << ", pack: " << total.writePack << " ms)"
+           << ", property values allocated on read: " << total.readPropertyAllocations
+           << ", on sweep: " << total.sweepPropertyAllocations;
+
+    ByteArray data = JsonDocument(root).toJson();
+    Ret ret = io::File::writeFile(outFile, data);
+    if (!ret) {
+        LOGE() << "failed write: " << outFile << ", err: " << ret.toString();
+        return ret;
+    }
+
+    return failed == 0 ? make_ok() : make_ret(Ret::Code::UnknownError);
+}
+
+io::paths_t EngravingBenchmark::scanScores(const io::paths_t& dirsOrFiles) const
+{
+    io::paths_t scores;
+    for (const io::path_t& path : dirsOrFiles) {
+        if (io::FileInfo(path).entryType() == io::EntryType::File) {
+            scores.push_back(path);
+            continue;
+        }
+
+        RetVal<io::paths_t> files = io::Dir::scanFiles(path, FILES_FILTER);
+        if (!files.ret) {
+            LOGE() << "failed scan: " << path << ", err: " << files.ret.toString();
+            continue;
+        }
+
+        for (const io::path_t& file : files.val) {
+            std::string str = file.toStdString();
+            if (str.find("disabled") != std::string::npos || str.find("DISABLED") != std::string::npos) {
+                continue;
+            }
+            scores.push_back(file);
+        }
+    }
+
+    return scores;
+}
+
+Ret EngravingBenchmark::runOnce(const io::path_t& scorePath, Sample& sample) const
+{
+    // Read
+    Timer readTimer;
+    const uint64_t readAllocatedStart = PropertyValue::heapAllocatedCount();
+
+    EngravingProjectPtr project = EngravingProject::create(iocContext());
+    project->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(scorePath));
+
+    MscReader::Params readParams;
+    readParams.filePath = scorePath;
+    readParams.mode = mscIoModeBySuffix(io::suffix(scorePath));
+
+    MscReader reader(readParams);
+    Ret ret = reader.open();
+    if (!ret) {
+        return ret;
+    }
+
+    SettingsCompat settingsCompat;
+    ret = project->loadMscz(reader, settingsCompat, true);
+    if (!ret) {
+        return ret;
+    }
+
+    sample.read = readTimer.elapsedMs();
+    sample.readPropertyAllocations = static_cast<double>(PropertyValue::heapAllocatedCount() - readAllocatedStart);
+
+    MasterScore* score = project->masterScore();
+
+    // Layout
+    {
+        MemoryArena::Scope arenaScope(project->memoryArena());
+
+        Timer layoutTimer;
+        score->doLayout();
+        sample.layout = layoutTimer.elapsedMs();
+    }
+
+    //! NOTE Every step is timed without the steps nested in it
+    const LayoutStatistics& stat = score->layoutStatistics();
+    sample.layoutResetPass = stat.resetPassMs;
+    sample.layoutIndependentItemsPass = stat.independentItemsPassMs;
+    sample.layoutMeasures = stat.measureLayoutMs;
+    sample.layoutSystems = stat.systemLayoutMs;
+    sample.layoutPages = stat.pageLayoutMs;
+
+    sample.measures = static_cast<int>(score->nmeasures());
+    sample.pages = static_cast<int>(score->npages());
+    sample.parts = static_cast<int>(score->excerpts().size());
+
+    // Property sweep
+    //! NOTE Gets each property and its default of each element, as the inspector and the writer do
+    {
+        Timer sweepTimer;
+        const uint64_t sweepAllocatedStart = PropertyValue::heapAllocatedCount();
+
+        struct SweepData {
+            uint64_t values = 0;
+            uint64_t nonDefaultValues = 0;
+        };
+
+        SweepData data;
+        score->scanElements(&data, [](void* d, EngravingItem* item) {
+            SweepData* data = static_cast<SweepData*>(d);
+            for (int i = 0; i < static_cast<int>(Pid::END); ++i) {
+                const Pid pid = static_cast<Pid>(i);
+                PropertyValue value = item->getProperty(pid);
+                if (!value.isValid()) {
+                    continue;
+                }
+
+                ++data->values;
+                if (value != item->propertyDefault(pid)) {
+                    ++data->nonDefaultValues;
+                }
+            }
+        }, true);
+
+        sample.propertySweep = sweepTimer.elapsedMs();
+        sample.sweepPropertyAllocations = static_cast<double>(PropertyValue::heapAllocatedCount() - sweepAllocatedStart);
+        sample.sweepPropertyValues = static_cast<double>(data.values);
+        sample.sweepNonDefaultPropertyValues = static_cast<double>(data.nonDefaultValues);
+    }
+
+    // Draw
+    {
+        Timer drawTimer;
+
+        Painter painter(std::make_shared<NullPaintProvider>(), "EngravingBenchmark");
+        rendering::IScoreRenderer::PaintOptions option;
+        option.isMultiPage = true;
+        option.printPageBackground = true;
+        option.isSetViewport = true;
+        option.isPrinting = true;
+
+        scoreRenderer()->paintScore(&painter, score, option);
+
+        sample.draw = drawTimer.elapsedMs();
+    }
+
+    // Write
+    //! NOTE The writer is deferred, so serializing the score (and the parts)
+    //! and packing the files into the zip are timed separately
+    {
+        Timer writeTimer;
+
+        ByteArray data;
+        io::Buffer buf(&data);
+        buf.open(io::IODevice::OpenMode::WriteOnly);
+
+        MscWriter::Params writeParams;
+        writeParams.device = &buf;
+        writeParams.filePath = scorePath;
+        writeParams.mode = MscIoMode::Zip;
+        writeParams.deferred = true;
+
+        MscWriter writer(writeParams);
+        ret = writer.open();
+        if (!ret) {
+            return ret;
+        }
+
+        bool ok = project->writeMscz(writer, false, false);
+        sample.writeSerialize = writeTimer.elapsedMs();
+
+        Timer packTimer;
+        writer.close();
+        if (!ok || writer.hasError()) {
+            return make_ret(Ret::Code::UnknownError);
+        }
+
+        sample.writePack = packTimer.elapsedMs();
+        sample.write = writeTimer.elapsedMs();
+        sample.writtenBytes = static_cast<double>(data.size());
+    }
+
+    if (const MemoryArena* arena = project->memoryArena()) {
+        MemoryArena::Info info = arena->stateInfo();
+        sample.allocatedCount = static_cast<double>(info.totalAllocatedCount);
+        sample.allocatedBytes = static_cast<double>(info.allocatedBytes);
+    }
+
+    return make_ok();
+}
+
+JsonObject EngravingBenchmark::sampleToJson(const Sample& sample)
+{
+    JsonObject ms;
+    ms["read"] = sample.read;
+    ms["layout"] = sample.layout;
+    ms["layoutResetPass"] = sample.layoutResetPass;
+    ms["layoutIndependentItemsPass"] = sample.layoutIndependentItemsPass;
+    ms["layoutMeasures"] = sample.layoutMeasures;
+    ms["layoutSystems"] = sample.layoutSystems;
+    ms["layoutPages"] = sample.layoutPages;
+    ms["draw"] = sample.draw;
+    ms["propertySweep"] = sample.propertySweep;
+    ms["write"] = sample.write;
+    ms["writeSerialize"] = sample.writeSerialize;
+    ms["writePack"] = sample.writePack;
+
+    JsonObject obj;
+    obj["ms"] = ms;
+    obj["allocatedCount"] = sample.allocatedCount;
+    obj["allocatedBytes"] = sample.allocatedBytes;
+    obj["measures"] = sample.measures;
+    obj["pages"] = sample.pages;
+    obj["parts"] = sample.parts;
+    obj["writtenBytes"] = sample.writtenBytes;
+    obj["readPropertyAllocations"] = sample.readPropertyAllocations;
+    obj["sweepPropertyAllocations"] = sample.sweepPropertyAllocations;
+    obj["sweepPropertyValues"] = sample.sweepPropertyValues;
+    obj["sweepNonDefaultPropertyValues"] = sample.sweepNonDefaultPropertyValues;
+
+    return obj;
+}
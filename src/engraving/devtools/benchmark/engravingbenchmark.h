@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ENGRAVINGBENCHMARK_H
+#define MU_ENGRAVING_ENGRAVINGBENCHMARK_H
+
+#include "iengravingbenchmark.h"
+
+#include "modularity/ioc.h"
+#include "engraving/rendering/iscorerenderer.h"
+
+namespace muse {
+class JsonObject;
+}
+
+namespace mu::engraving {
+class EngravingBenchmark : public IEngravingBenchmark, public muse::Injectable
+{
+    muse::Inject<rendering::IScoreRenderer> scoreRenderer = { this };
+public:
+    EngravingBenchmark(const muse::modularity::ContextPtr& iocCtx)
+        : muse::Injectable(iocCtx) {}
+
+    muse::Ret runBenchmark(const muse::io::paths_t& dirsOrFiles, const muse::io::path_t& outFile,
+                           const BenchmarkOpt& opt = BenchmarkOpt()) override;
+
+private:
+
+    //! NOTE Times in ms
+    struct Sample {
+        double read = 0.0;
+        double layout = 0.0;
+        double layoutResetPass = 0.0;
+        double layoutIndependentItemsPass = 0.0;
+        double layoutMeasures = 0.0;
+        double layoutSystems = 0.0;
+        double layoutPages = 0.0;
+        double draw = 0.0;
+        double propertySweep = 0.0; // getting every property of every element of the master score
+        double write = 0.0;
+        double writeSerialize = 0.0; // writing the score files into memory
+        double writePack = 0.0;      // compressing them and writing the zip
+
+        double writtenBytes = 0.0;
+
+        // property values allocated on the heap
+        double readPropertyAllocations = 0.0;
+        double sweepPropertyAllocations = 0.0;
+        double sweepPropertyValues = 0.0;
+        double sweepNonDefaultPropertyValues = 0.0;
+
+        // from the memory arena of the score, if arenas are enabled
+        double allocatedCount = 0.0;
+        double allocatedBytes = 0.0;
+
+        int measures = 0;
+        int pages = 0;
+        int parts = 0;
+    };
+
+    muse::io::paths_t scanScores(const muse::io::paths_t& dirsOrFiles) const;
+    muse::Ret runOnce(const muse::io::path_t& scorePath, Sample& sample) const;
+
+    static muse::JsonObject sampleToJson(const Sample& sample);
+};
+}
+
+#endif // MU_ENGRAVING_ENGRAVINGBENCHMARK_H
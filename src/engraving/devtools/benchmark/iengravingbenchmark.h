@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_IENGRAVINGBENCHMARK_H
+#define MU_ENGRAVING_IENGRAVINGBENCHMARK_H
+
+#include "modularity/imoduleinterface.h"
+#include "global/types/ret.h"
+#include "global/io/path.h"
+
+namespace mu::engraving {
+struct BenchmarkOpt {
+    int iterations = 5;
+};
+
+class IEngravingBenchmark : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IEngravingBenchmark)
+public:
+    virtual ~IEngravingBenchmark() = default;
+
+    //! NOTE Reads, lays out, draws (to a null painter) and writes (to memory) each given score,
+    //! or each score found in the given dirs, and writes the median timings as JSON to outFile
+    virtual muse::Ret runBenchmark(const muse::io::paths_t& dirsOrFiles, const muse::io::path_t& outFile,
+                                   const BenchmarkOpt& opt = BenchmarkOpt()) = 0;
+};
+}
+
+#endif // MU_ENGRAVING_IENGRAVINGBENCHMARK_H
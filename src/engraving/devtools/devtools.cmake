@@ -20,4 +20,8 @@ set(DEVTOOLS_SRC
     ${CMAKE_CURRENT_LIST_DIR}/drawdata/drawdataconverter.h
     ${CMAKE_CURRENT_LIST_DIR}/drawdata/drawdatacomparator.cpp
     ${CMAKE_CURRENT_LIST_DIR}/drawdata/drawdatacomparator.h
+
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/iengravingbenchmark.h
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/engravingbenchmark.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/benchmark/engravingbenchmark.h
 )
@@ -321,6 +321,9 @@ void CmdState::setUpdateMode(UpdateMode m)
 
 void Score::startCmd()
 {
+    //! NOTE Edits are propagated to the linked elements of all the parts
+    masterScore()->readDeferredExcerpts();
+
     if (undoStack()->locked()) {
         return;
     }
@@ -340,6 +343,7 @@ void Score::startCmd()
         return;
     }
     undoStack()->beginMacro(this);
+    masterScore()->setMemoryArenaActive(true);
 }
 
 //---------------------------------------------------------
@@ -357,6 +361,8 @@ void Score::undoRedo(bool undo, EditData* ed)
     //! 2. for the redo operation, the list of changed elements will be available after redo()
     UndoMacro::ChangesInfo changes = changesInfo(undoStack());
 
+    muse::MemoryArena::Scope arenaScope(masterScore()->memoryArena());
+
     cmdState().reset();
     if (undo) {
         undoStack()->undo(ed);
@@ -422,6 +428,7 @@ void Score::endCmd(bool rollback, bool layoutAllParts)
 
     const bool noUndo = undoStack()->current()->empty(); // nothing to undo?
     undoStack()->endMacro(noUndo);
+    masterScore()->setMemoryArenaActive(false);
 
     if (dirty()) {
         masterScore()->setPlaylistDirty(); // TODO: flag individual operations
@@ -475,6 +482,8 @@ void Score::update(bool resetCmdState, bool layoutAllParts)
 
     TRACEFUNC;
 
+    muse::MemoryArena::Scope arenaScope(masterScore()->memoryArena());
+
     bool updateAll = false;
     {
         MasterScore* ms = masterScore();
@@ -72,6 +72,9 @@ Excerpt::Excerpt(const Excerpt& ex, bool copyContents)
 {
     if (copyContents) {
         m_tracksMapping = ex.m_tracksMapping;
+
+        //! NOTE A deferred excerpt must be read before its contents are copied
+        DO_ASSERT(!ex.isDeferred());
         m_excerptScore = ex.m_excerptScore ? ex.m_excerptScore->clone() : nullptr;
 
         if (m_excerptScore) {
@@ -125,6 +128,57 @@ void Excerpt::setExcerptScore(Score* s)
     }
 }
 
+bool Excerpt::isDeferred() const
+{
+    return m_deferredRead != nullptr;
+}
+
+void Excerpt::setDeferredRead(std::function<muse::Ret(Excerpt*)> read)
+{
+    m_deferredRead = std::move(read);
+}
+
+void Excerpt::readDeferred()
+{
+    if (!m_deferredRead) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    std::function<muse::Ret(Excerpt*)> read;
+    std::swap(read, m_deferredRead);
+
+    muse::MemoryArena::Scope arenaScope(m_masterScore->memoryArena());
+
+    //! NOTE Until now, the parts were those listed in the excerpt file,
+    //! after reading they are found by the links to the master score, as for any other excerpt
+    std::vector<Part*> listedParts;
+    std::swap(listedParts, m_parts);
+
+    muse::Ret ret = read(this);
+
+    if (ret) {
+        m_masterScore->initParts(this);
+
+        // the excerpt may have been renamed since it was listed
+        writeNameToMetaTags();
+    } else {
+        //! NOTE The excerpt is already shown in the list of parts, so it is not dropped,
+        //! but created anew from the listed parts
+        LOGE() << "failed to read excerpt " << m_fileName << ", err: " << ret.toString() << ", creating it anew";
+
+        m_parts = std::move(listedParts);
+        m_inited = false;
+        m_masterScore->initExcerpt(this);
+    }
+
+    // the same setup as for the excerpts read together with the master score
+    m_masterScore->rebuildMidiMapping();
+    m_excerptScore->setPlaylistDirty();
+    m_excerptScore->setLayoutAll();
+}
+
 const String& Excerpt::name() const
 {
     return m_name;
@@ -217,6 +271,8 @@ void Excerpt::removePart(const ID& id)
         return;
     }
 
+    readDeferred();
+
     excerptScore()->undoRemovePart(excerptScore()->parts().at(index), index);
 }
 
@@ -231,6 +287,10 @@ size_t Excerpt::nstaves() const
 
 bool Excerpt::isEmpty() const
 {
+    if (isDeferred()) {
+        return m_parts.empty();
+    }
+
     return excerptScore() ? excerptScore()->parts().empty() : true;
 }
 
@@ -495,6 +555,10 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
 void MasterScore::deleteExcerpt(Excerpt* excerpt)
 {
     assert(excerpt->masterScore() == this);
+
+    //! NOTE The removal is undoable, so the excerpt needs its score
+    excerpt->readDeferred();
+
     Score* partScore = excerpt->excerptScore();
 
     if (!partScore) {
@@ -629,6 +693,15 @@ void MasterScore::initEmptyExcerpt(Excerpt* excerpt)
     excerpt->setInited(true);
 }
 
+void MasterScore::readDeferredExcerpts()
+{
+    for (Excerpt* excerpt : excerpts()) {
+        if (excerpt->isDeferred()) {
+            excerpt->readDeferred();
+        }
+    }
+}
+
 static bool scoreContainsSpanner(const Score* score, Spanner* spanner)
 {
     const std::multimap<int, Spanner*>& spanners = score->spanner();
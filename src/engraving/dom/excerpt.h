@@ -23,9 +23,12 @@
 #ifndef MU_ENGRAVING_EXCERPT_H
 #define MU_ENGRAVING_EXCERPT_H
 
+#include <functional>
+
 #include "../types/fraction.h"
 #include "../types/types.h"
 #include "types/string.h"
+#include "types/ret.h"
 
 #include "async/notification.h"
 
@@ -54,9 +57,16 @@ public:
     void setInitialPartId(const ID& id);
 
     MasterScore* masterScore() const { return m_masterScore; }
-    Score* excerptScore() const { return m_excerptScore; }
+    Score* excerptScore() const { return m_excerptScore; } // nullptr if the excerpt is deferred
     void setExcerptScore(Score* s);
 
+    // A deferred excerpt has been listed, but not read yet (see MScore::deferExcerpts).
+    // It is read by readDeferred, where its score is first needed, and before the first edit of the master score.
+    // If it can't be read, it is created anew from its parts, as a new excerpt is.
+    bool isDeferred() const;
+    void setDeferredRead(std::function<muse::Ret(Excerpt*)> read);
+    void readDeferred();
+
     const String& name() const;
     void setName(const String& name, bool saveAndNotify = true);
     muse::async::Notification nameChanged() const;
@@ -107,6 +117,7 @@ private:
 
     MasterScore* m_masterScore = nullptr;
     Score* m_excerptScore = nullptr;
+    std::function<muse::Ret(Excerpt*)> m_deferredRead;
     String m_name;
     String m_fileName;
     muse::async::Notification m_nameChanged;
@@ -58,6 +58,10 @@ MasterScore::MasterScore(const muse::modularity::ContextPtr& iocCtx, std::weak_p
     : Score(iocCtx)
 {
     m_project = project;
+    if (std::shared_ptr<EngravingProject> p = project.lock()) {
+        m_memoryArena = p->memoryArena();
+    }
+
     m_undoStack   = new UndoStack();
     m_tempomap    = new TempoMap;
     m_sigmap      = new TimeSigMap();
@@ -99,6 +103,8 @@ MasterScore::~MasterScore()
         m_project.lock()->m_masterScore = nullptr;
     }
 
+    setMemoryArenaActive(false);
+
     delete m_expandedRepeatList;
     delete m_nonExpandedRepeatList;
     delete m_sigmap;
@@ -107,6 +113,29 @@ MasterScore::~MasterScore()
     muse::DeleteAll(m_excerpts);
 }
 
+//---------------------------------------------------------
+//   setMemoryArenaActive
+//    make the project arena current between startCmd() and endCmd(),
+//    so that elements created by the command are placed there
+//---------------------------------------------------------
+
+void MasterScore::setMemoryArenaActive(bool arg)
+{
+    if (!m_memoryArena || m_memoryArenaActive == arg) {
+        return;
+    }
+
+    if (arg) {
+        m_prevMemoryArena = muse::MemoryArena::current();
+        muse::MemoryArena::setCurrent(m_memoryArena);
+    } else {
+        muse::MemoryArena::setCurrent(m_prevMemoryArena);
+        m_prevMemoryArena = nullptr;
+    }
+
+    m_memoryArenaActive = arg;
+}
+
 //---------------------------------------------------------
 //   setTempomap
 //---------------------------------------------------------
@@ -219,7 +248,8 @@ const RepeatList& MasterScore::repeatList(bool expandRepeats) const
 
 void MasterScore::addExcerpt(Excerpt* ex, size_t index)
 {
-    if (!ex->inited()) {
+    //! NOTE The parts of a deferred excerpt are initialized when it is read
+    if (!ex->inited() && !ex->isDeferred()) {
         initParts(ex);
     }
 
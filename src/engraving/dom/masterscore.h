@@ -89,6 +89,9 @@ public:
 
     std::weak_ptr<EngravingProject> project() const { return m_project; }
 
+    muse::MemoryArena* memoryArena() const { return m_memoryArena; }
+    void setMemoryArenaActive(bool arg);
+
     bool isMaster() const override { return true; }
 
     GetEID* getEID() { return &m_getEID; }
@@ -166,6 +169,7 @@ public:
     void initAndAddExcerpt(Excerpt*, bool);
     void initExcerpt(Excerpt*);
     void initEmptyExcerpt(Excerpt*);
+    void readDeferredExcerpts();
 
     void setPlaybackScore(Score*);
     Score* playbackScore() { return m_playbackScore; }
@@ -201,6 +205,7 @@ private:
     int updateMidiMapping();
 
     friend class EngravingProject;
+    friend class Excerpt;
     friend class compat::ScoreAccess;
     friend class read114::Read114;
     friend class read400::Read400;
@@ -240,6 +245,10 @@ private:
 
     std::weak_ptr<EngravingProject> m_project;
 
+    muse::MemoryArena* m_memoryArena = nullptr;
+    muse::MemoryArena* m_prevMemoryArena = nullptr;
+    bool m_memoryArenaActive = false;
+
     // FIXME: Move to EngravingProject
     // We can't yet, because m_project is not set on every MasterScore
     IFileInfoProviderPtr m_fileInfoProvider;
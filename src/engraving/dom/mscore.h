@@ -232,6 +232,7 @@ public:
 
     static bool noExcerpts;
     static bool noImages;
+    static bool deferExcerpts;
 
     static bool pdfPrinting;
     static bool svgPrinting;
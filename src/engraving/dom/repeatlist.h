@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_REPEATLIST_H
 #define MU_ENGRAVING_REPEATLIST_H
 
+#include <atomic>
 #include <set>
 #include <vector>
 
@@ -111,7 +112,10 @@ private:
     void flatten();
 
     Score* m_score = nullptr;
-    mutable unsigned m_idx1, m_idx2 = 0;     // cached values
+    //! NOTE: cached lookup hints; playback events are rendered concurrently,
+    //! so each lookup reads the hint exactly once
+    mutable std::atomic<unsigned> m_idx1 { 0 };
+    mutable std::atomic<unsigned> m_idx2 { 0 };
 
     bool m_expanded = false;
     bool m_scoreChanged = true;
@@ -4348,7 +4348,8 @@ std::list<Score*> Score::scoreList()
     MasterScore* root = masterScore();
     scores.push_back(root);
     for (const Excerpt* ex : root->excerpts()) {
-        if (ex->excerptScore()) {
+        // a deferred excerpt has no score until it is read
+        if (!ex->isDeferred() && ex->excerptScore()) {
             scores.push_back(ex->excerptScore());
         }
     }
@@ -4829,6 +4830,26 @@ size_t Score::nmeasures() const
     return n;
 }
 
+//---------------------------------------------------------
+//   layoutBreaks
+//---------------------------------------------------------
+
+LayoutBreaks Score::layoutBreaks() const
+{
+    LayoutBreaks breaks;
+    breaks.systemMeasureCounts.reserve(m_systems.size());
+    for (const System* system : m_systems) {
+        breaks.systemMeasureCounts.push_back(system->measures().size());
+    }
+
+    breaks.pageSystemCounts.reserve(m_pages.size());
+    for (const Page* page : m_pages) {
+        breaks.pageSystemCounts.push_back(page->systems().size());
+    }
+
+    return breaks;
+}
+
 //---------------------------------------------------------
 //   firstTrailingMeasure
 //---------------------------------------------------------
@@ -856,6 +856,15 @@ public:
     double noteHeadWidth() const { return m_layoutOptions.noteHeadWidth; }
     void setNoteHeadWidth(double n) { m_layoutOptions.noteHeadWidth = n; }
 
+    const LayoutStatistics& layoutStatistics() const { return m_layoutStatistics; }
+    void setLayoutStatistics(const LayoutStatistics& s) { m_layoutStatistics = s; }
+
+    //! NOTE The breaks of a previous layout of exactly the same content,
+    //! the next full page view layout follows them instead of searching for the breaks
+    const LayoutBreaks& layoutBreaksHint() const { return m_layoutBreaksHint; }
+    void setLayoutBreaksHint(const LayoutBreaks& b) { m_layoutBreaksHint = b; }
+    LayoutBreaks layoutBreaks() const;
+
     // temporary methods
     bool isLayoutMode(LayoutMode lm) const { return m_layoutOptions.isMode(lm); }
     LayoutMode layoutMode() const { return m_layoutOptions.mode; }
@@ -1139,6 +1148,8 @@ private:
 
     RootItem* m_rootItem = nullptr;
     LayoutOptions m_layoutOptions;
+    LayoutStatistics m_layoutStatistics;
+    LayoutBreaks m_layoutBreaksHint;
 
     muse::async::Channel<EngravingItem*> m_elementDestroyed;
 
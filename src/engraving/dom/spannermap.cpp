@@ -98,6 +98,23 @@ const SpannerMap::IntervalList& SpannerMap::findOverlapping(int start, int stop,
     return m_results;
 }
 
+//---------------------------------------------------------
+//   collectOverlapping
+//---------------------------------------------------------
+
+SpannerMap::IntervalList SpannerMap::collectOverlapping(int start, int stop, bool excludeCollisions) const
+{
+    if (m_dirty) {
+        update();
+    }
+
+    if (excludeCollisions) {
+        return m_collisionFreeTree.findOverlapping(start, stop);
+    }
+
+    return m_tree.findOverlapping(start, stop);
+}
+
 void SpannerMap::collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const
 {
     using IntervalsByType = std::map<ElementType, IntervalList>;
@@ -46,6 +46,10 @@ public:
 
     const IntervalList& findContained(int start, int stop, bool excludeCollisions = false) const;
     const IntervalList& findOverlapping(int start, int stop, bool excludeCollisions = false) const;
+
+    //! NOTE: Unlike findOverlapping, does not share the result buffer between calls,
+    //! so it may be used from several threads at once, as long as the lookup tree is up to date (see update)
+    IntervalList collectOverlapping(int start, int stop, bool excludeCollisions = false) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
 
     void collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const;
@@ -59,6 +63,7 @@ public:
     void clear() { std::multimap<int, Spanner*>::clear(); m_dirty = true; }
     bool empty() const { return std::multimap<int, Spanner*>::empty(); }
     void update() const;
+    bool isDirty() const { return m_dirty; }
     void setDirty() const { m_dirty = true; }     // must be called if a spanner changes start/length
 #ifndef NDEBUG
     void dump() const;
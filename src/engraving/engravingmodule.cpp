@@ -64,6 +64,7 @@
 #include "devtools/engravingelementsmodel.h"
 #include "devtools/corruptscoredevtoolsmodel.h"
 #include "devtools/drawdata/diagnosticdrawprovider.h"
+#include "devtools/benchmark/engravingbenchmark.h"
 #endif
 
 #include "muse_framework_config.h"
@@ -129,6 +130,7 @@ Versions:
 #ifdef MUE_BUILD_ENGRAVING_DEVTOOLS
     ioc()->registerExport<IEngravingElementsProvider>(moduleName(), new EngravingElementsProvider());
     ioc()->registerExport<IDiagnosticDrawProvider>(moduleName(), new DiagnosticDrawProvider(iocContext()));
+    ioc()->registerExport<IEngravingBenchmark>(moduleName(), new EngravingBenchmark(iocContext()));
 #endif
 }
 
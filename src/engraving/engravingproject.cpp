@@ -59,11 +59,19 @@ EngravingProject::EngravingProject(const modularity::ContextPtr& iocCtx)
     : muse::Injectable(iocCtx)
 {
     muse::ObjectAllocator::used();
+
+    if (muse::MemoryArena::enabled()) {
+        m_memoryArena = std::make_unique<muse::MemoryArena>("score");
+    }
 }
 
 EngravingProject::~EngravingProject()
 {
+    //! NOTE The score must be deleted before its memory arena.
+    //! If some of its objects are still alive, the arena is detached until they are deleted
     delete m_masterScore;
+    m_masterScore = nullptr;
+    muse::MemoryArena::release(m_memoryArena.release());
 
     muse::ObjectAllocator::unused();
 
@@ -74,6 +82,7 @@ EngravingProject::~EngravingProject()
 
 void EngravingProject::init(const MStyle& style)
 {
+    muse::MemoryArena::Scope arenaScope(m_memoryArena.get());
     m_masterScore = new MasterScore(iocContext(), style, weak_from_this());
 }
 
@@ -111,6 +120,8 @@ Ret EngravingProject::doSetupMasterScore(bool forceMode)
 {
     TRACEFUNC;
 
+    muse::MemoryArena::Scope arenaScope(m_memoryArena.get());
+
     m_masterScore->createPaddingTable();
     m_masterScore->connectTies();
 
@@ -139,10 +150,21 @@ MasterScore* EngravingProject::masterScore() const
     return m_masterScore;
 }
 
+muse::MemoryArena* EngravingProject::memoryArena() const
+{
+    return m_memoryArena.get();
+}
+
 Ret EngravingProject::loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError)
 {
     TRACEFUNC;
 
+    if (m_memoryArena) {
+        m_memoryArena->setName(muse::io::filename(msc.params().filePath).toStdString());
+    }
+
+    muse::MemoryArena::Scope arenaScope(m_memoryArena.get());
+
     MScore::setError(MsError::MS_NO_ERROR);
     MscLoader loader;
     return loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError);
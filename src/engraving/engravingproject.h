@@ -43,6 +43,10 @@
 //! we need to strive to ensure that there is work with the project everywhere;
 //! accordingly, only the project should create and load the master score.
 
+namespace muse {
+class MemoryArena;
+}
+
 namespace mu::engraving {
 class MasterScore;
 class MStyle;
@@ -69,6 +73,9 @@ public:
     MasterScore* masterScore() const;
     muse::Ret setupMasterScore(bool forceMode);
 
+    //! NOTE The memory of the master score, its excerpts and their elements (if arenas are enabled, they are off by default)
+    muse::MemoryArena* memoryArena() const;
+
     muse::Ret loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError);
     bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail);
 
@@ -84,6 +91,7 @@ private:
 
     muse::Ret doSetupMasterScore(bool forceMode);
 
+    std::unique_ptr<muse::MemoryArena> m_memoryArena;
     MasterScore* m_masterScore = nullptr;
 
     bool m_isCorruptedUponLoading = false;
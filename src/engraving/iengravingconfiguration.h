@@ -42,6 +42,10 @@ public:
 
     virtual muse::io::path_t appDataPath() const = 0;
 
+    //! NOTE The dir where the precomputed glyph metrics of the engraving fonts are stored,
+    //! an empty path disables the cache
+    virtual muse::io::path_t fontMetricsCachePath() const = 0;
+
     virtual muse::io::path_t defaultStyleFilePath() const = 0;
     virtual void setDefaultStyleFilePath(const muse::io::path_t& path) = 0;
 
@@ -119,6 +119,11 @@ ByteArray MscReader::fileData(const String& fileName) const
     return reader()->fileData(fileName);
 }
 
+ZipReader::PackedFile MscReader::packedFileData(const String& fileName) const
+{
+    return reader()->packedFileData(fileName);
+}
+
 ByteArray MscReader::readStyleFile() const
 {
     if (!fileExists(u"score_style.mss")) {
@@ -193,6 +198,18 @@ ByteArray MscReader::readExcerptFile(const String& excerptFileName) const
     return fileData(u"Excerpts/" + excerptFileName + u"/" + fileName);
 }
 
+ZipReader::PackedFile MscReader::readPackedExcerptStyleFile(const String& excerptFileName) const
+{
+    String fileName = excerptFileName + u".mss";
+    return packedFileData(u"Excerpts/" + excerptFileName + u"/" + fileName);
+}
+
+ZipReader::PackedFile MscReader::readPackedExcerptFile(const String& excerptFileName) const
+{
+    String fileName = excerptFileName + u".mscx";
+    return packedFileData(u"Excerpts/" + excerptFileName + u"/" + fileName);
+}
+
 ByteArray MscReader::readChordListFile() const
 {
     if (!fileExists(u"chordlist.xml")) {
@@ -345,6 +362,20 @@ ByteArray MscReader::ZipFileReader::fileData(const String& fileName) const
     return data;
 }
 
+ZipReader::PackedFile MscReader::ZipFileReader::packedFileData(const String& fileName) const
+{
+    IF_ASSERT_FAILED(m_zip) {
+        return ZipReader::PackedFile();
+    }
+
+    ZipReader::PackedFile file = m_zip->packedFileData(fileName.toStdString());
+    if (m_zip->hasError()) {
+        LOGE() << "failed read data for filename " << fileName;
+        return ZipReader::PackedFile();
+    }
+    return file;
+}
+
 Ret MscReader::DirReader::open(IODevice* device, const path_t& filePath)
 {
     if (device) {
@@ -456,6 +487,8 @@ bool MscReader::XmlFileReader::isContainer() const
 
 StringList MscReader::XmlFileReader::fileList() const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     if (!m_device) {
         return StringList();
     }
@@ -487,6 +520,8 @@ StringList MscReader::XmlFileReader::fileList() const
 
 bool MscReader::XmlFileReader::fileExists(const String& fileName) const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     if (!m_device) {
         return false;
     }
@@ -516,6 +551,8 @@ bool MscReader::XmlFileReader::fileExists(const String& fileName) const
 
 ByteArray MscReader::XmlFileReader::fileData(const String& fileName) const
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     if (!m_device) {
         return ByteArray();
     }
@@ -22,16 +22,15 @@
 #ifndef MU_ENGRAVING_MSCREADER_H
 #define MU_ENGRAVING_MSCREADER_H
 
+#include <mutex>
+
 #include "types/ret.h"
 #include "types/string.h"
 #include "io/path.h"
 #include "io/iodevice.h"
+#include "serialization/zipreader.h"
 #include "mscio.h"
 
-namespace muse {
-class ZipReader;
-}
-
 namespace mu::engraving {
 class MscReader
 {
@@ -56,6 +55,7 @@ public:
     void close();
     bool isOpened() const;
 
+    //! NOTE Once opened, the files can be read from several threads at the same time
     muse::ByteArray readStyleFile() const;
     muse::ByteArray readScoreFile() const;
 
@@ -63,6 +63,10 @@ public:
     muse::ByteArray readExcerptStyleFile(const muse::String& excerptFileName) const;
     muse::ByteArray readExcerptFile(const muse::String& excerptFileName) const;
 
+    //! NOTE The excerpt files as they are stored in the container, see muse::ZipReader::unpack
+    muse::ZipReader::PackedFile readPackedExcerptStyleFile(const muse::String& excerptFileName) const;
+    muse::ZipReader::PackedFile readPackedExcerptFile(const muse::String& excerptFileName) const;
+
     muse::ByteArray readChordListFile() const;
     muse::ByteArray readThumbnailFile() const;
 
@@ -88,6 +92,15 @@ private:
         virtual muse::StringList fileList() const = 0;
         virtual bool fileExists(const muse::String& fileName) const = 0;
         virtual muse::ByteArray fileData(const muse::String& fileName) const = 0;
+
+        //! NOTE Only a zip container stores the files packed
+        virtual muse::ZipReader::PackedFile packedFileData(const muse::String& fileName) const
+        {
+            muse::ZipReader::PackedFile file;
+            file.data = fileData(fileName);
+            file.uncompressedSize = file.data.size();
+            return file;
+        }
     };
 
     struct ZipFileReader : public IReader
@@ -100,6 +113,7 @@ private:
         muse::StringList fileList() const override;
         bool fileExists(const muse::String& fileName) const override;
         muse::ByteArray fileData(const muse::String& fileName) const override;
+        muse::ZipReader::PackedFile packedFileData(const muse::String& fileName) const override;
     private:
         muse::io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
@@ -131,11 +145,13 @@ private:
     private:
         muse::io::IODevice* m_device = nullptr;
         bool m_selfDeviceOwner = false;
+        mutable std::mutex m_mutex;
     };
 
     IReader* reader() const;
     bool fileExists(const muse::String& fileName) const;
     muse::ByteArray fileData(const muse::String& fileName) const;
+    muse::ZipReader::PackedFile packedFileData(const muse::String& fileName) const;
 
     muse::String mainFileName() const;
 
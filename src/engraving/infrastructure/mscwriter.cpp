@@ -115,6 +115,10 @@ MscWriter::IWriter* MscWriter::writer() const
             UNREACHABLE;
             break;
         }
+
+        if (m_writer && m_params.deferred) {
+            m_writer = new DeferredWriter(m_writer);
+        }
     }
 
     return m_writer;
@@ -469,3 +473,71 @@ bool MscWriter::XmlFileWriter::addFileData(const String& fileName, const ByteArr
 
     return true;
 }
+
+MscWriter::DeferredWriter::DeferredWriter(IWriter* target)
+    : m_target(target)
+{
+}
+
+MscWriter::DeferredWriter::~DeferredWriter()
+{
+    delete m_target;
+}
+
+Ret MscWriter::DeferredWriter::open(io::IODevice* device, const path_t& filePath)
+{
+    m_device = device;
+    m_filePath = filePath;
+    m_isOpened = true;
+
+    return true;
+}
+
+void MscWriter::DeferredWriter::close()
+{
+    if (!m_isOpened) {
+        return;
+    }
+
+    m_isOpened = false;
+
+    Ret ret = m_target->open(m_device, m_filePath);
+    if (!ret) {
+        LOGE() << "failed open target: " << ret.toString();
+        m_hasError = true;
+        m_files.clear();
+        return;
+    }
+
+    for (const auto& [fileName, data] : m_files) {
+        if (!m_target->addFileData(fileName, data)) {
+            LOGE() << "failed write file: " << fileName;
+            m_hasError = true;
+            break;
+        }
+    }
+
+    m_files.clear();
+    m_target->close();
+}
+
+bool MscWriter::DeferredWriter::isOpened() const
+{
+    return m_isOpened;
+}
+
+bool MscWriter::DeferredWriter::hasError() const
+{
+    return m_hasError || m_target->hasError();
+}
+
+bool MscWriter::DeferredWriter::addFileData(const String& fileName, const ByteArray& data)
+{
+    IF_ASSERT_FAILED(m_isOpened) {
+        return false;
+    }
+
+    m_files.push_back({ fileName, data });
+
+    return true;
+}
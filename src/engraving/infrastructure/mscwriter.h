@@ -44,6 +44,10 @@ public:
         muse::io::path_t filePath;
         muse::String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+
+        //! NOTE The files are kept in memory and written to the destination on close,
+        //! so the project can be serialized on one thread and written on another
+        bool deferred = false;
     };
 
     MscWriter() = default;
@@ -122,6 +126,24 @@ private:
         muse::TextStream* m_stream = nullptr;
     };
 
+    struct DeferredWriter : public IWriter
+    {
+        DeferredWriter(IWriter* target);
+        ~DeferredWriter() override;
+        muse::Ret open(muse::io::IODevice* device, const muse::io::path_t& filePath) override;
+        void close() override;
+        bool isOpened() const override;
+        bool hasError() const override;
+        bool addFileData(const muse::String& fileName, const muse::ByteArray& data) override;
+    private:
+        IWriter* m_target = nullptr;
+        muse::io::IODevice* m_device = nullptr;
+        muse::io::path_t m_filePath;
+        std::vector<std::pair<muse::String, muse::ByteArray> > m_files;
+        bool m_isOpened = false;
+        bool m_hasError = false;
+    };
+
     struct Meta {
         std::vector<muse::String> files;
         bool isWritten = false;
@@ -37,6 +37,9 @@ using namespace mu;
 using namespace muse::draw;
 
 namespace mu::engraving {
+// below this number of element pairs the skylines are compared pairwise
+static constexpr size_t ENVELOPE_MIN_PAIRS = 1024;
+
 void Skyline::add(const ShapeElement& r)
 {
     if (r.ignoreForLayout()) {
@@ -103,6 +106,7 @@ SkylineLine SkylineLine::getFilteredCopy(std::function<bool(const ShapeElement&)
     SkylineLine newSkylineLine(*this);
 
     newSkylineLine.m_shape.clear();
+    newSkylineLine.invalidateEnvelopes();
 
     for (const ShapeElement& shapeEl : m_shape.elements()) {
         if (filterOut(shapeEl)) {
@@ -140,6 +144,7 @@ void SkylineLine::add(const ShapeElement& r)
     }
 
     m_shape.add(r);
+    invalidateEnvelopes();
 }
 
 double SkylineLine::staffLinesTopAtX(double x) const
@@ -187,6 +192,7 @@ void SkylineLine::clear()
 {
     m_staffLineEdges.clear();
     m_shape.clear();
+    invalidateEnvelopes();
 }
 
 //-------------------------------------------------------------------
@@ -202,7 +208,70 @@ double Skyline::minDistance(const Skyline& s, double minHorizontalClearance) con
 
 double SkylineLine::minDistance(const SkylineLine& sl, double minHorizontalClearance) const
 {
-    return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
+    // comparing every pair of elements is cheaper for small skylines
+    if (m_shape.size() * sl.m_shape.size() < ENVELOPE_MIN_PAIRS || minHorizontalClearance < 0.0
+        || hasInvertedElements() || sl.hasInvertedElements()) {
+        return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
+    }
+
+    // same result as Shape::minVerticalDistance: the clearance is applied to the skyline below on both sides
+    return SkylineEnvelope::maxVerticalDistance(bottomEnvelope(), sl.topEnvelope(minHorizontalClearance));
+}
+
+const SkylineEnvelope& SkylineLine::bottomEnvelope() const
+{
+    if (!m_isBottomEnvelopeValid) {
+        m_bottomEnvelope.build(spans(SkylineEnvelope::Edge::Bottom, 0.0));
+        m_isBottomEnvelopeValid = true;
+    }
+
+    return m_bottomEnvelope;
+}
+
+const SkylineEnvelope& SkylineLine::topEnvelope(double horizontalExtension) const
+{
+    if (!m_isTopEnvelopeValid || m_topEnvelopeExtension != horizontalExtension) {
+        m_topEnvelope.build(spans(SkylineEnvelope::Edge::Top, horizontalExtension));
+        m_topEnvelopeExtension = horizontalExtension;
+        m_isTopEnvelopeValid = true;
+    }
+
+    return m_topEnvelope;
+}
+
+void SkylineLine::invalidateEnvelopes()
+{
+    m_isBottomEnvelopeValid = false;
+    m_isTopEnvelopeValid = false;
+}
+
+std::vector<SkylineEnvelope::Span> SkylineLine::spans(SkylineEnvelope::Edge edge, double horizontalExtension) const
+{
+    std::vector<SkylineEnvelope::Span> result;
+    result.reserve(m_shape.size());
+
+    for (const ShapeElement& r : m_shape.elements()) {
+        // the same elements as Shape::minVerticalDistance ignores
+        if (r.height() <= 0.0 || r.left() == r.right()) {
+            continue;
+        }
+
+        double y = edge == SkylineEnvelope::Edge::Top ? r.top() : r.bottom();
+        result.push_back({ r.left() - horizontalExtension, r.right() + horizontalExtension, y });
+    }
+
+    return result;
+}
+
+bool SkylineLine::hasInvertedElements() const
+{
+    for (const ShapeElement& r : m_shape.elements()) {
+        if (r.width() < 0.0) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 double SkylineLine::minDistanceToShapeAbove(const Shape& shapeAbove, double minHorizontalClearance) const
@@ -268,6 +337,7 @@ bool SkylineLine::valid() const
 SkylineLine& SkylineLine::translateY(double y)
 {
     m_shape.translateY(y);
+    invalidateEnvelopes();
     return *this;
 }
 
@@ -29,6 +29,7 @@
 
 #include "draw/types/geometry.h"
 #include "shape.h"
+#include "skylineenvelope.h"
 
 namespace muse::draw {
 class Painter;
@@ -52,7 +53,11 @@ public:
     void add(const Shape& s);
 
     template<typename Predicate>
-    inline bool remove_if(Predicate p) { return m_shape.remove_if(p); }
+    inline bool remove_if(Predicate p)
+    {
+        invalidateEnvelopes();
+        return m_shape.remove_if(p);
+    }
     SkylineLine getFilteredCopy(std::function<bool(const ShapeElement&)> filterOut) const;
 
     void clear();
@@ -74,12 +79,23 @@ public:
     bool isNorth() const { return m_isNorth; }
 
     const std::vector<ShapeElement>& elements() const { return m_shape.elements(); }
-    std::vector<ShapeElement>& elements() { return m_shape.elements(); }
+    std::vector<ShapeElement>& elements()
+    {
+        invalidateEnvelopes();
+        return m_shape.elements();
+    }
 
 private:
     double staffLinesTopAtX(double x) const;
     double staffLinesBottomAtX(double x) const;
 
+    std::vector<SkylineEnvelope::Span> spans(SkylineEnvelope::Edge edge, double horizontalExtension) const;
+    bool hasInvertedElements() const;
+
+    const SkylineEnvelope& bottomEnvelope() const;
+    const SkylineEnvelope& topEnvelope(double horizontalExtension) const;
+    void invalidateEnvelopes();
+
 private:
     const bool m_isNorth;
     Shape m_shape;
@@ -93,6 +109,14 @@ private:
 
     std::map<double, StaffLineEdge> m_staffLineEdges;
     bool hasValidStaffLineEdges() const { return !m_staffLineEdges.empty(); }
+
+    //! NOTE Built on the first distance query and kept until the line is modified.
+    //! Not guarded: a line must not be queried from several threads at once
+    mutable SkylineEnvelope m_bottomEnvelope { SkylineEnvelope::Edge::Bottom };
+    mutable SkylineEnvelope m_topEnvelope { SkylineEnvelope::Edge::Top };
+    mutable double m_topEnvelopeExtension = 0.0;
+    mutable bool m_isBottomEnvelopeValid = false;
+    mutable bool m_isTopEnvelopeValid = false;
 };
 
 //---------------------------------------------------------
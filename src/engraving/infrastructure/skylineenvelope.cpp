@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "skylineenvelope.h"
+
+#include <algorithm>
+
+using namespace mu::engraving;
+
+void SkylineEnvelope::clear()
+{
+    m_x.clear();
+    m_values.clear();
+}
+
+//---------------------------------------------------------
+//   build
+//    Sweep over the sorted breakpoints keeping the spans
+//    covering the current x range in a heap, the best one
+//    on top. Spans which are already over are dropped lazily.
+//---------------------------------------------------------
+
+void SkylineEnvelope::build(std::vector<Span> spans)
+{
+    clear();
+
+    if (spans.empty()) {
+        return;
+    }
+
+    std::vector<double> xs;
+    xs.reserve(spans.size() * 2);
+    for (const Span& s : spans) {
+        xs.push_back(s.x1);
+        xs.push_back(s.x2);
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+        return a.x1 < b.x1;
+    });
+
+    auto heapLess = [this](const Span* a, const Span* b) {
+        return isBetter(b->y, a->y);
+    };
+
+    std::vector<const Span*> active;
+    active.reserve(spans.size());
+
+    m_x.reserve(xs.size());
+    m_values.reserve(xs.size());
+
+    size_t next = 0;
+    for (size_t i = 0; i + 1 < xs.size(); ++i) {
+        const double x = xs[i];
+
+        while (next < spans.size() && spans[next].x1 <= x) {
+            active.push_back(&spans[next++]);
+            std::push_heap(active.begin(), active.end(), heapLess);
+        }
+
+        while (!active.empty() && active.front()->x2 <= x) {
+            std::pop_heap(active.begin(), active.end(), heapLess);
+            active.pop_back();
+        }
+
+        const double value = active.empty() ? noValue() : active.front()->y;
+
+        // neighbouring ranges with the same value are merged
+        if (!m_values.empty() && m_values.back() == value) {
+            continue;
+        }
+
+        m_x.push_back(x);
+        m_values.push_back(value);
+    }
+
+    m_x.push_back(xs.back());
+}
+
+double SkylineEnvelope::valueIn(double x1, double x2) const
+{
+    double result = noValue();
+    if (empty() || !(x1 < x2)) {
+        return result;
+    }
+
+    // first range which ends after x1
+    size_t i = std::upper_bound(m_x.begin(), m_x.end(), x1) - m_x.begin();
+    i = i > 0 ? i - 1 : 0;
+
+    for (; i < m_values.size() && m_x[i] < x2; ++i) {
+        if (isBetter(m_values[i], result)) {
+            result = m_values[i];
+        }
+    }
+
+    return result;
+}
+
+double SkylineEnvelope::maxVerticalDistance(const SkylineEnvelope& above, const SkylineEnvelope& below)
+{
+    double dist = -DBL_MAX;
+
+    const std::vector<double>& ax = above.m_x;
+    const std::vector<double>& av = above.m_values;
+    const std::vector<double>& bx = below.m_x;
+    const std::vector<double>& bv = below.m_values;
+
+    const double noBottom = above.noValue();
+    const double noTop = below.noValue();
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < av.size() && j < bv.size()) {
+        const double x1 = std::max(ax[i], bx[j]);
+        const double x2 = std::min(ax[i + 1], bx[j + 1]);
+
+        if (x1 < x2 && av[i] != noBottom && bv[j] != noTop) {
+            dist = std::max(dist, av[i] - bv[j]);
+        }
+
+        if (ax[i + 1] < bx[j + 1]) {
+            ++i;
+        } else if (bx[j + 1] < ax[i + 1]) {
+            ++j;
+        } else {
+            ++i;
+            ++j;
+        }
+    }
+
+    return dist;
+}
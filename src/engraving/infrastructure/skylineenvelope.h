@@ -0,0 +1,87 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SKYLINEENVELOPE_H
+#define MU_ENGRAVING_SKYLINEENVELOPE_H
+
+#include <cfloat>
+#include <cstddef>
+#include <vector>
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   SkylineEnvelope
+//    Piecewise-constant outline of a set of rectangles.
+//    For every x range between two neighbouring breakpoints
+//    it keeps the lowest top (Edge::Top) or the highest
+//    bottom (Edge::Bottom) of the rectangles covering it.
+//    Breakpoints and values are kept in two flat arrays,
+//    so the distance between two outlines is a linear merge
+//    instead of comparing every pair of rectangles.
+//---------------------------------------------------------
+
+class SkylineEnvelope
+{
+public:
+    enum class Edge : unsigned char {
+        Top,
+        Bottom
+    };
+
+    // open x range (x1, x2) with the top or bottom y of a rectangle
+    struct Span {
+        double x1 = 0.0;
+        double x2 = 0.0;
+        double y = 0.0;
+    };
+
+    explicit SkylineEnvelope(Edge edge)
+        : m_edge(edge) {}
+
+    Edge edge() const { return m_edge; }
+
+    // spans must have x1 < x2
+    void build(std::vector<Span> spans);
+    void clear();
+
+    bool empty() const { return m_values.empty(); }
+    size_t size() const { return m_values.size(); }
+
+    const std::vector<double>& breakpoints() const { return m_x; }
+    const std::vector<double>& values() const { return m_values; }
+
+    // the outline value within (x1, x2), noValue() if nothing covers the range
+    double valueIn(double x1, double x2) const;
+    double noValue() const { return m_edge == Edge::Top ? DBL_MAX : -DBL_MAX; }
+
+    // max(bottom of above - top of below) over all x covered by both, -DBL_MAX if none
+    static double maxVerticalDistance(const SkylineEnvelope& above, const SkylineEnvelope& below);
+
+private:
+    bool isBetter(double a, double b) const { return m_edge == Edge::Top ? a < b : a > b; }
+
+    Edge m_edge = Edge::Top;
+    std::vector<double> m_x;        // size() + 1 breakpoints
+    std::vector<double> m_values;   // value between m_x[i] and m_x[i + 1]
+};
+}
+
+#endif // MU_ENGRAVING_SKYLINEENVELOPE_H
@@ -21,10 +21,14 @@
  */
 #include "engravingfont.h"
 
+#include <type_traits>
+
 #include "serialization/json.h"
 #include "io/file.h"
 #include "io/fileinfo.h"
+#include "io/dir.h"
 #include "draw/painter.h"
+#include "uuid.h"
 #include "types/symnames.h"
 
 #include "dom/mscore.h"
@@ -39,6 +43,57 @@ using namespace muse::io;
 using namespace muse::draw;
 using namespace mu::engraving;
 
+// =============================================
+// Metrics cache format
+// =============================================
+
+//! NOTE The metrics cache is a flat file: a header followed by fixed size records,
+//! so reading it is a single file read plus a few copies.
+//! Increase the version whenever the layout or the way the metrics are computed changes.
+static constexpr char METRICS_CACHE_MAGIC[4] = { 'M', 'S', 'F', 'M' };
+static constexpr uint32_t METRICS_CACHE_VERSION = 1;
+
+namespace {
+struct MetricsCacheHeader {
+    char magic[4];
+    uint32_t version = 0;
+    uint8_t key[16] = {};
+    uint32_t symbolCount = 0;
+    uint32_t anchorCount = 0;
+    uint32_t engravingDefaultCount = 0;
+    uint32_t reserved = 0;
+    double textEnclosureThickness = 0.0;
+};
+
+struct MetricsCacheSym {
+    uint32_t code = 0;
+    uint32_t reserved = 0;
+    double x = 0.0;
+    double y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    double advance = 0.0;
+};
+
+struct MetricsCacheAnchor {
+    uint32_t symId = 0;
+    uint32_t anchorId = 0;
+    double x = 0.0;
+    double y = 0.0;
+};
+
+struct MetricsCacheEngravingDefault {
+    uint32_t sid = 0;
+    uint32_t isBool = 0;
+    double value = 0.0;
+};
+
+static_assert(std::is_trivially_copyable_v<MetricsCacheHeader>);
+static_assert(std::is_trivially_copyable_v<MetricsCacheSym>);
+static_assert(std::is_trivially_copyable_v<MetricsCacheAnchor>);
+static_assert(std::is_trivially_copyable_v<MetricsCacheEngravingDefault>);
+}
+
 // =============================================
 // ScoreFont
 // =============================================
@@ -60,6 +115,7 @@ EngravingFont::EngravingFont(const EngravingFont& other)
     m_name     = other.m_name;
     m_family   = other.m_family;
     m_fontPath = other.m_fontPath;
+    m_symIdsByCode = other.m_symIdsByCode;
 }
 
 // =============================================
@@ -107,6 +163,51 @@ void EngravingFont::ensureLoad()
     m_font.setNoFontMerging(true);
     m_font.setHinting(Font::Hinting::PreferVerticalHinting);
 
+    ByteArray metadata;
+    File metadataFile(FileInfo(m_fontPath).path() + u"/metadata.json");
+    if (metadataFile.open(IODevice::ReadOnly)) {
+        metadata = metadataFile.readAll();
+    }
+
+    path_t cacheFilePath;
+    ByteArray cacheKey;
+    if (!metadata.empty()) {
+        cacheFilePath = metricsCacheFilePath();
+        if (!cacheFilePath.empty()) {
+            cacheKey = metricsCacheKey(metadata);
+        }
+    }
+
+    if (!cacheKey.empty() && readMetricsCache(cacheFilePath, cacheKey)) {
+        //! NOTE The composed glyphs are not stored, they are cheap to recompute
+        loadComposedGlyphs();
+    } else {
+        if (!loadMetrics(metadata)) {
+            return;
+        }
+
+        if (!cacheKey.empty()) {
+            writeMetricsCache(cacheFilePath, cacheKey);
+        }
+    }
+
+    m_engravingDefaults.insert({ Sid::musicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
+
+    m_symIdsByCode.clear();
+    m_symIdsByCode.reserve(m_symbols.size());
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        char32_t code = m_symbols[id].code;
+        if (code != 0) {
+            // the first symbol wins, as several symbols may share a code
+            m_symIdsByCode.emplace(code, static_cast<SymId>(id));
+        }
+    }
+
+    m_loaded = true;
+}
+
+bool EngravingFont::loadMetrics(const ByteArray& metadata)
+{
     for (size_t id = 0; id < m_symbols.size(); ++id) {
         Smufl::Code code = Smufl::code(static_cast<SymId>(id));
         if (!code.isValid()) {
@@ -116,17 +217,17 @@ void EngravingFont::ensureLoad()
         computeMetrics(sym, code);
     }
 
-    File metadataFile(FileInfo(m_fontPath).path() + u"/metadata.json");
-    if (!metadataFile.open(IODevice::ReadOnly)) {
-        LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
-        return;
+    path_t metadataFilePath = FileInfo(m_fontPath).path() + u"/metadata.json";
+    if (metadata.empty()) {
+        LOGE() << "Failed to open glyph metadata file: " << metadataFilePath;
+        return false;
     }
 
     std::string error;
-    JsonObject metadataJson = JsonDocument::fromJson(metadataFile.readAll(), &error).rootObject();
+    JsonObject metadataJson = JsonDocument::fromJson(metadata, &error).rootObject();
     if (!error.empty()) {
-        LOGE() << "Json parse error in " << metadataFile.filePath() << ", error: " << error;
-        return;
+        LOGE() << "Json parse error in " << metadataFilePath << ", error: " << error;
+        return false;
     }
 
     loadGlyphsWithAnchors(metadataJson.value("glyphsWithAnchors").toObject());
@@ -134,7 +235,7 @@ void EngravingFont::ensureLoad()
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
-    m_loaded = true;
+    return true;
 }
 
 void EngravingFont::loadGlyphsWithAnchors(const JsonObject& glyphsWithAnchors)
@@ -495,8 +596,6 @@ void EngravingFont::loadEngravingDefaults(const JsonObject& engravingDefaultsObj
 
         applyEngravingDefault(key, engravingDefaultsObject.value(key).toDouble());
     }
-
-    m_engravingDefaults.insert({ Sid::musicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
 }
 
 void EngravingFont::computeMetrics(EngravingFont::Sym& sym, const Smufl::Code& code)
@@ -513,6 +612,213 @@ void EngravingFont::computeMetrics(EngravingFont::Sym& sym, const Smufl::Code& c
     }
 }
 
+// =============================================
+// Metrics cache
+// =============================================
+
+path_t EngravingFont::metricsCacheFilePath() const
+{
+    path_t dir = configuration()->fontMetricsCachePath();
+    if (dir.empty()) {
+        return path_t();
+    }
+
+    return dir + "/" + m_family + ".metrics";
+}
+
+ByteArray EngravingFont::metricsCacheKey(const ByteArray& metadata) const
+{
+    ByteArray data;
+    Ret ret = File::readFile(m_fontPath, data);
+    if (!ret) {
+        LOGE() << "failed to read font file: " << m_fontPath << ", err: " << ret.toString();
+        return ByteArray();
+    }
+
+    data.push_back(metadata);
+
+    const double dpi = DPI_F;
+    data.push_back(reinterpret_cast<const uint8_t*>(&dpi), sizeof(dpi));
+
+    //! NOTE The metrics also depend on the SMuFL code table and on the code which computes them
+    for (size_t id = 0; id <= static_cast<size_t>(SymId::lastSym); ++id) {
+        const Smufl::Code code = Smufl::code(static_cast<SymId>(id));
+        data.push_back(reinterpret_cast<const uint8_t*>(&code.smuflCode), sizeof(code.smuflCode));
+        data.push_back(reinterpret_cast<const uint8_t*>(&code.musicSymBlockCode), sizeof(code.musicSymBlockCode));
+    }
+
+    if (application()) {
+        data.push_back(application()->version().toString().toUtf8());
+        data.push_back(application()->revision().toUtf8());
+    }
+
+    ByteArray key = cryptographicHash()->hash(data, ICryptographicHash::Algorithm::Md4);
+    if (key.size() != sizeof(MetricsCacheHeader::key)) {
+        return ByteArray();
+    }
+
+    return key;
+}
+
+bool EngravingFont::readMetricsCache(const path_t& filePath, const ByteArray& key)
+{
+    if (!File::exists(filePath)) {
+        return false;
+    }
+
+    ByteArray data;
+    if (!File::readFile(filePath, data)) {
+        return false;
+    }
+
+    MetricsCacheHeader header;
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+
+    std::memcpy(&header, data.constData(), sizeof(header));
+
+    if (std::memcmp(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != METRICS_CACHE_VERSION
+        || std::memcmp(header.key, key.constData(), sizeof(header.key)) != 0
+        || header.symbolCount != m_symbols.size()) {
+        LOGD() << "outdated font metrics cache: " << filePath;
+        return false;
+    }
+
+    const size_t expectedSize = sizeof(header)
+                                + header.symbolCount * sizeof(MetricsCacheSym)
+                                + header.anchorCount * sizeof(MetricsCacheAnchor)
+                                + header.engravingDefaultCount * sizeof(MetricsCacheEngravingDefault);
+    if (data.size() != expectedSize) {
+        LOGW() << "corrupted font metrics cache: " << filePath;
+        return false;
+    }
+
+    const uint8_t* pos = data.constData() + sizeof(header);
+
+    for (Sym& sym : m_symbols) {
+        MetricsCacheSym s;
+        std::memcpy(&s, pos, sizeof(s));
+        pos += sizeof(s);
+
+        sym.code = static_cast<char32_t>(s.code);
+        sym.bbox = RectF(s.x, s.y, s.width, s.height);
+        sym.advance = s.advance;
+        sym.smuflAnchors.clear();
+    }
+
+    for (uint32_t i = 0; i < header.anchorCount; ++i) {
+        MetricsCacheAnchor a;
+        std::memcpy(&a, pos, sizeof(a));
+        pos += sizeof(a);
+
+        if (a.symId >= m_symbols.size()) {
+            continue;
+        }
+
+        m_symbols[a.symId].smuflAnchors[static_cast<SmuflAnchorId>(a.anchorId)] = PointF(a.x, a.y);
+    }
+
+    m_engravingDefaults.clear();
+    for (uint32_t i = 0; i < header.engravingDefaultCount; ++i) {
+        MetricsCacheEngravingDefault d;
+        std::memcpy(&d, pos, sizeof(d));
+        pos += sizeof(d);
+
+        Sid sid = static_cast<Sid>(d.sid);
+        if (d.isBool) {
+            m_engravingDefaults.insert({ sid, d.value != 0.0 });
+        } else {
+            m_engravingDefaults.insert({ sid, d.value });
+        }
+    }
+
+    m_textEnclosureThickness = header.textEnclosureThickness;
+
+    return true;
+}
+
+void EngravingFont::writeMetricsCache(const path_t& filePath, const ByteArray& key) const
+{
+    std::vector<MetricsCacheAnchor> anchors;
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        for (const auto& p : m_symbols[id].smuflAnchors) {
+            MetricsCacheAnchor a;
+            a.symId = static_cast<uint32_t>(id);
+            a.anchorId = static_cast<uint32_t>(p.first);
+            a.x = p.second.x();
+            a.y = p.second.y();
+            anchors.push_back(a);
+        }
+    }
+
+    std::vector<MetricsCacheEngravingDefault> defaults;
+    for (const auto& p : m_engravingDefaults) {
+        MetricsCacheEngravingDefault d;
+        d.sid = static_cast<uint32_t>(p.first);
+        if (p.second.type() == P_TYPE::BOOL) {
+            d.isBool = 1;
+            d.value = p.second.toBool() ? 1.0 : 0.0;
+        } else if (p.second.type() == P_TYPE::REAL) {
+            d.value = p.second.toReal();
+        } else {
+            continue;
+        }
+        defaults.push_back(d);
+    }
+
+    MetricsCacheHeader header;
+    std::memcpy(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic));
+    header.version = METRICS_CACHE_VERSION;
+    std::memcpy(header.key, key.constData(), sizeof(header.key));
+    header.symbolCount = static_cast<uint32_t>(m_symbols.size());
+    header.anchorCount = static_cast<uint32_t>(anchors.size());
+    header.engravingDefaultCount = static_cast<uint32_t>(defaults.size());
+    header.textEnclosureThickness = m_textEnclosureThickness;
+
+    ByteArray data;
+    data.reserve(sizeof(header)
+                 + m_symbols.size() * sizeof(MetricsCacheSym)
+                 + anchors.size() * sizeof(MetricsCacheAnchor)
+                 + defaults.size() * sizeof(MetricsCacheEngravingDefault));
+
+    data.push_back(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+
+    for (const Sym& sym : m_symbols) {
+        MetricsCacheSym s;
+        s.code = static_cast<uint32_t>(sym.code);
+        s.x = sym.bbox.x();
+        s.y = sym.bbox.y();
+        s.width = sym.bbox.width();
+        s.height = sym.bbox.height();
+        s.advance = sym.advance;
+        data.push_back(reinterpret_cast<const uint8_t*>(&s), sizeof(s));
+    }
+
+    for (const MetricsCacheAnchor& a : anchors) {
+        data.push_back(reinterpret_cast<const uint8_t*>(&a), sizeof(a));
+    }
+
+    for (const MetricsCacheEngravingDefault& d : defaults) {
+        data.push_back(reinterpret_cast<const uint8_t*>(&d), sizeof(d));
+    }
+
+    Ret ret = Dir::mkpath(FileInfo(filePath).path());
+    if (ret) {
+        //! NOTE Write to a temporary file first, so that a concurrent process never reads a half written cache
+        path_t tmpFilePath = filePath + "." + Uuid::gen() + ".tmp";
+        ret = File::writeFile(tmpFilePath, data);
+        if (ret) {
+            ret = fileSystem()->move(tmpFilePath, filePath, true);
+        }
+    }
+
+    if (!ret) {
+        LOGW() << "failed to write font metrics cache: " << filePath << ", err: " << ret.toString();
+    }
+}
+
 // =============================================
 // Symbol properties
 // =============================================
@@ -540,8 +846,8 @@ char32_t EngravingFont::symCode(SymId id) const
 
 SymId EngravingFont::fromCode(char32_t code) const
 {
-    auto it = std::find_if(m_symbols.begin(), m_symbols.end(), [code](const Sym& s) { return s.code == code; });
-    return static_cast<SymId>(it == m_symbols.end() ? 0 : it - m_symbols.begin());
+    auto it = m_symIdsByCode.find(code);
+    return it == m_symIdsByCode.end() ? SymId::noSym : it->second;
 }
 
 String EngravingFont::toString(SymId id) const
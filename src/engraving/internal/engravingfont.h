@@ -26,11 +26,15 @@
 
 #include "iengravingfont.h"
 #include "modularity/ioc.h"
+#include "global/iapplication.h"
+#include "global/icryptographichash.h"
 #include "draw/ifontprovider.h"
 #include "draw/types/geometry.h"
 #include "iengravingfontsprovider.h"
+#include "iengravingconfiguration.h"
 
 #include "io/path.h"
+#include "io/ifilesystem.h"
 
 #include "infrastructure/smufl.h"
 #include "infrastructure/shape.h"
@@ -53,6 +57,10 @@ class EngravingFont : public IEngravingFont, public muse::Injectable
 {
     muse::Inject<muse::draw::IFontProvider> fontProvider = { this };
     muse::Inject<IEngravingFontsProvider> engravingFonts = { this };
+    muse::Inject<IEngravingConfiguration> configuration = { this };
+    muse::Inject<muse::IApplication> application = { this };
+    muse::GlobalInject<muse::ICryptographicHash> cryptographicHash;
+    muse::GlobalInject<muse::io::IFileSystem> fileSystem;
 public:
     EngravingFont(const std::string& name, const std::string& family, const muse::io::path_t& filePath,
                   const muse::modularity::ContextPtr& iocCtx);
@@ -119,12 +127,18 @@ private:
         }
     };
 
+    bool loadMetrics(const muse::ByteArray& metadata);
     void loadGlyphsWithAnchors(const muse::JsonObject& glyphsWithAnchors);
     void loadComposedGlyphs();
     void loadStylisticAlternates(const muse::JsonObject& glyphsWithAlternatesObject);
     void loadEngravingDefaults(const muse::JsonObject& engravingDefaultsObject);
     void computeMetrics(Sym& sym, const Smufl::Code& code);
 
+    muse::io::path_t metricsCacheFilePath() const;
+    muse::ByteArray metricsCacheKey(const muse::ByteArray& metadata) const;
+    bool readMetricsCache(const muse::io::path_t& filePath, const muse::ByteArray& key);
+    void writeMetricsCache(const muse::io::path_t& filePath, const muse::ByteArray& key) const;
+
     void constructShapeWithCutouts(Shape& shape, SymId id);
 
     Sym& sym(SymId id);
@@ -134,6 +148,7 @@ private:
 
     bool m_loaded = false;
     std::vector<Sym> m_symbols;
+    std::unordered_map<char32_t, SymId> m_symIdsByCode;
     mutable muse::draw::Font m_font;
 
     std::string m_name;
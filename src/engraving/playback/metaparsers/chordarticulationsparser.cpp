@@ -103,9 +103,9 @@ void ChordArticulationsParser::parseSpanners(const Chord* chord, const Rendering
         return;
     }
 
-    auto intervals = spannerMap.findOverlapping(ctx.nominalPositionStartTick,
-                                                ctx.nominalPositionEndTick,
-                                                /*excludeCollisions*/ true);
+    const SpannerMap::IntervalList intervals = spannerMap.collectOverlapping(ctx.nominalPositionStartTick,
+                                                                             ctx.nominalPositionEndTick,
+                                                                             /*excludeCollisions*/ true);
 
     for (const auto& interval : intervals) {
         Spanner* spanner = interval.value;
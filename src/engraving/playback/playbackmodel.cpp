@@ -35,8 +35,11 @@
 #include "dom/tie.h"
 #include "dom/tremolotwochord.h"
 
+#include "concurrency/taskscheduler.h"
+
 #include "log.h"
 
+#include <algorithm>
 #include <limits>
 
 using namespace mu;
@@ -49,6 +52,24 @@ static const String CHORD_SYMBOLS_INSTRUMENT_ID(u"chord_symbols");
 
 const InstrumentTrackId PlaybackModel::METRONOME_TRACK_ID = { 999, METRONOME_INSTRUMENT_ID };
 
+static PlaybackEventsChangesList mergeRanges(PlaybackEventsChangesList ranges)
+{
+    std::sort(ranges.begin(), ranges.end(), [](const PlaybackEventsChanges& r1, const PlaybackEventsChanges& r2) {
+        return r1.from < r2.from;
+    });
+
+    PlaybackEventsChangesList result;
+    for (const PlaybackEventsChanges& range : ranges) {
+        if (!result.empty() && range.from <= result.back().to) {
+            result.back().to = std::max(result.back().to, range.to);
+        } else {
+            result.push_back(range);
+        }
+    }
+
+    return result;
+}
+
 static const Harmony* findChordSymbol(const EngravingItem* item)
 {
     if (item->isHarmony()) {
@@ -124,7 +145,7 @@ void PlaybackModel::reload()
     update(tickFrom, tickTo, trackFrom, trackTo);
 
     for (auto& pair : m_playbackDataMap) {
-        pair.second.mainStream.send(pair.second.originEvents, pair.second.dynamics, pair.second.params);
+        sendMainStream(pair.second);
     }
 
     m_dataChanged.notify();
@@ -155,6 +176,16 @@ void PlaybackModel::setPlayChordSymbols(const bool isEnabled)
     m_playChordSymbols = isEnabled;
 }
 
+bool PlaybackModel::isParallelRenderingEnabled() const
+{
+    return m_parallelRendering;
+}
+
+void PlaybackModel::setParallelRenderingEnabled(const bool isEnabled)
+{
+    m_parallelRendering = isEnabled;
+}
+
 const InstrumentTrackId& PlaybackModel::metronomeTrackId() const
 {
     return METRONOME_TRACK_ID;
@@ -185,20 +216,28 @@ const PlaybackData& PlaybackModel::resolveTrackPlaybackData(const InstrumentTrac
 {
     auto search = m_playbackDataMap.find(trackId);
 
-    if (search != m_playbackDataMap.cend()) {
-        return search->second;
-    }
+    if (search == m_playbackDataMap.end()) {
+        const Part* part = m_score ? m_score->partById(trackId.partId.toUint64()) : nullptr;
+
+        if (!part) {
+            static PlaybackData empty;
+            return empty;
+        }
 
-    const Part* part = m_score ? m_score->partById(trackId.partId.toUint64()) : nullptr;
+        update(0, m_score->lastMeasure()->tick().ticks(), part->startTrack(), part->endTrack());
 
-    if (!part) {
-        static PlaybackData empty;
-        return empty;
+        search = m_playbackDataMap.try_emplace(trackId).first;
     }
 
-    update(0, m_score->lastMeasure()->tick().ticks(), part->startTrack(), part->endTrack());
+    //! NOTE The consumer of the data has missed a delta
+    search->second.mainStreamRequested.onNotify(this, [this, trackId]() {
+        auto it = m_playbackDataMap.find(trackId);
+        if (it != m_playbackDataMap.end()) {
+            sendMainStream(it->second);
+        }
+    });
 
-    return m_playbackDataMap[trackId];
+    return search->second;
 }
 
 const PlaybackData& PlaybackModel::resolveTrackPlaybackData(const ID& partId, const String& instrumentId)
@@ -352,7 +391,7 @@ void PlaybackModel::updateContext(const InstrumentTrackId& trackId)
 }
 
 void PlaybackModel::processSegment(const int tickPositionOffset, const Segment* segment, const std::set<staff_idx_t>& staffIdxSet,
-                                   bool isFirstSegmentOfMeasure, ChangedTrackIdSet* trackChanges)
+                                   bool isFirstSegmentOfMeasure, ChangedTrackIdSet* trackChanges, TrackEventsMap* eventsBuffer)
 {
     for (const EngravingItem* item : segment->annotations()) {
         if (!item || !item->part()) {
@@ -379,10 +418,15 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
 
         if (chordSymbol->play()) {
             m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, profile,
-                                         m_playbackDataMap[trackId].originEvents);
+                                         trackEvents(trackId, eventsBuffer));
         }
 
         collectChangesTracks(trackId, trackChanges);
+
+        if (trackChanges) {
+            timestamp_t timestamp = timestampFromTicks(m_score, chordSymbol->tick().ticks() + tickPositionOffset);
+            collectChangedEventsRange(trackId, timestamp, timestamp);
+        }
     }
 
     for (const EngravingItem* item : segment->elist()) {
@@ -406,7 +450,7 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
                 const MeasureRepeat* measureRepeat = toMeasureRepeat(item);
                 const Measure* currentMeasure = measureRepeat->measure();
 
-                processMeasureRepeat(tickPositionOffset, measureRepeat, currentMeasure, staffIdx, trackChanges);
+                processMeasureRepeat(tickPositionOffset, measureRepeat, currentMeasure, staffIdx, trackChanges, eventsBuffer);
 
                 continue;
             } else if (item->voice() == 0) {
@@ -415,7 +459,7 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
                 if (currentMeasure->measureRepeatCount(staffIdx) > 0) {
                     const MeasureRepeat* measureRepeat = currentMeasure->measureRepeatElement(staffIdx);
 
-                    processMeasureRepeat(tickPositionOffset, measureRepeat, currentMeasure, staffIdx, trackChanges);
+                    processMeasureRepeat(tickPositionOffset, measureRepeat, currentMeasure, staffIdx, trackChanges, eventsBuffer);
                     continue;
                 }
             }
@@ -427,15 +471,26 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
             continue;
         }
 
-        const PlaybackContextPtr ctx = playbackCtx(trackId);
-        m_renderer.render(item, tickPositionOffset, std::move(profile), ctx, m_playbackDataMap[trackId].originEvents);
+        //! NOTE Rendering into a buffer runs concurrently (see updateEventsInParallel), the contexts must not be created there
+        const PlaybackContextPtr ctx = eventsBuffer ? findPlaybackCtx(trackId) : playbackCtx(trackId);
+        IF_ASSERT_FAILED(ctx) {
+            continue;
+        }
+
+        m_renderer.render(item, tickPositionOffset, std::move(profile), ctx, trackEvents(trackId, eventsBuffer));
 
         collectChangesTracks(trackId, trackChanges);
+
+        if (trackChanges) {
+            timestamp_t timestamp = timestampFromTicks(m_score, item->tick().ticks() + tickPositionOffset);
+            collectChangedEventsRange(trackId, timestamp, timestamp);
+        }
     }
 }
 
 void PlaybackModel::processMeasureRepeat(const int tickPositionOffset, const MeasureRepeat* measureRepeat, const Measure* currentMeasure,
-                                         const staff_idx_t staffIdx, ChangedTrackIdSet* trackChanges)
+                                         const staff_idx_t staffIdx, ChangedTrackIdSet* trackChanges,
+                                         TrackEventsMap* eventsBuffer)
 {
     if (!measureRepeat || !currentMeasure) {
         return;
@@ -461,7 +516,8 @@ void PlaybackModel::processMeasureRepeat(const int tickPositionOffset, const Mea
             continue;
         }
 
-        processSegment(tickPositionOffset + repeatPositionTickOffset, seg, { staffIdx }, isFirstSegmentOfRepeatedMeasure, trackChanges);
+        processSegment(tickPositionOffset + repeatPositionTickOffset, seg, { staffIdx }, isFirstSegmentOfRepeatedMeasure, trackChanges,
+                       eventsBuffer);
         isFirstSegmentOfRepeatedMeasure = false;
     }
 }
@@ -475,9 +531,90 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
         return staff.isPrimaryStaff(); // skip linked staves
     });
 
-    const ArticulationsProfilePtr metronomeProfile = defaultActiculationProfile(METRONOME_TRACK_ID);
+    const RepeatList& repeats = repeatList();
 
-    for (const RepeatSegment* repeatSegment : repeatList()) {
+    //! NOTE: The changes of a single edit are small, while (re)loading renders the whole score,
+    //! so only the latter is worth splitting between the threads
+    if (m_parallelRendering && !trackChanges) {
+        std::vector<std::set<staff_idx_t> > staffIdxSetByPart;
+        const Part* currentPart = nullptr;
+
+        for (staff_idx_t staffIdx : staffToProcessIdxSet) {
+            const Part* part = m_score->staff(staffIdx)->part();
+            if (part != currentPart || staffIdxSetByPart.empty()) {
+                staffIdxSetByPart.emplace_back();
+                currentPart = part;
+            }
+
+            staffIdxSetByPart.back().insert(staffIdx);
+        }
+
+        if (staffIdxSetByPart.size() > 1) {
+            updateEventsInParallel(repeats, tickFrom, tickTo, staffIdxSetByPart);
+            return;
+        }
+    }
+
+    renderEvents(repeats, tickFrom, tickTo, staffToProcessIdxSet, /*renderMetronome*/ true, trackChanges, nullptr);
+}
+
+void PlaybackModel::updateEventsInParallel(const RepeatList& repeats, const int tickFrom, const int tickTo,
+                                           const std::vector<std::set<staff_idx_t> >& staffIdxSetByPart)
+{
+    TRACEFUNC;
+
+    //! NOTE: Every track belongs to a single part, so the parts are rendered independently, each one into its own buffer.
+    //! Everything that is resolved lazily during rendering is resolved here first, so that the tasks only read the shared state
+    for (const auto& pair : m_playbackDataMap) {
+        defaultActiculationProfile(pair.first);
+        playbackCtx(pair.first);
+    }
+
+    const SpannerMap& spannerMap = m_score->spannerMap();
+    if (spannerMap.isDirty()) {
+        spannerMap.update();
+    }
+
+    std::vector<TrackEventsMap> buffers(staffIdxSetByPart.size());
+
+    muse::TaskGroup group;
+    for (size_t i = 0; i < staffIdxSetByPart.size(); ++i) {
+        group.run([this, &repeats, &staffIdxSetByPart, &buffers, tickFrom, tickTo, i]() {
+            renderEvents(repeats, tickFrom, tickTo, staffIdxSetByPart[i], /*renderMetronome*/ false, nullptr, &buffers[i]);
+        });
+    }
+
+    TrackEventsMap metronomeBuffer;
+    renderEvents(repeats, tickFrom, tickTo, {}, /*renderMetronome*/ true, nullptr, &metronomeBuffer);
+
+    group.wait();
+
+    buffers.push_back(std::move(metronomeBuffer));
+
+    for (TrackEventsMap& buffer : buffers) {
+        for (auto& pair : buffer) {
+            PlaybackEventsMap& events = m_playbackDataMap[pair.first].originEvents;
+
+            if (events.empty()) {
+                events = std::move(pair.second);
+                continue;
+            }
+
+            for (auto& timestampEvents : pair.second) {
+                PlaybackEventList& list = events[timestampEvents.first];
+                list.insert(list.end(), std::make_move_iterator(timestampEvents.second.begin()),
+                            std::make_move_iterator(timestampEvents.second.end()));
+            }
+        }
+    }
+}
+
+void PlaybackModel::renderEvents(const RepeatList& repeats, const int tickFrom, const int tickTo, const std::set<staff_idx_t>& staffIdxSet,
+                                 bool renderMetronome, ChangedTrackIdSet* trackChanges, TrackEventsMap* eventsBuffer)
+{
+    const ArticulationsProfilePtr metronomeProfile = renderMetronome ? defaultActiculationProfile(METRONOME_TRACK_ID) : nullptr;
+
+    for (const RepeatSegment* repeatSegment : repeats) {
         int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
         int repeatStartTick = repeatSegment->tick;
         int repeatEndTick = repeatStartTick + repeatSegment->len();
@@ -496,7 +633,7 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
 
             bool isFirstSegmentOfMeasure = true;
 
-            for (Segment* segment = measure->first(); segment; segment = segment->next()) {
+            for (Segment* segment = staffIdxSet.empty() ? nullptr : measure->first(); segment; segment = segment->next()) {
                 if (!segment->isChordRestType()) {
                     continue;
                 }
@@ -508,17 +645,35 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                     continue;
                 }
 
-                processSegment(tickPositionOffset, segment, staffToProcessIdxSet, isFirstSegmentOfMeasure, trackChanges);
+                processSegment(tickPositionOffset, segment, staffIdxSet, isFirstSegmentOfMeasure, trackChanges, eventsBuffer);
                 isFirstSegmentOfMeasure = false;
             }
 
+            if (!renderMetronome) {
+                continue;
+            }
+
             m_renderer.renderMetronome(m_score, measureStartTick, measureEndTick, tickPositionOffset,
-                                       metronomeProfile, m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
+                                       metronomeProfile, trackEvents(METRONOME_TRACK_ID, eventsBuffer));
             collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+
+            if (trackChanges) {
+                collectChangedEventsRange(METRONOME_TRACK_ID, timestampFromTicks(m_score, measureStartTick + tickPositionOffset),
+                                          timestampFromTicks(m_score, measureEndTick + tickPositionOffset));
+            }
         }
     }
 }
 
+PlaybackEventsMap& PlaybackModel::trackEvents(const InstrumentTrackId& trackId, TrackEventsMap* eventsBuffer)
+{
+    if (eventsBuffer) {
+        return (*eventsBuffer)[trackId];
+    }
+
+    return m_playbackDataMap[trackId].originEvents;
+}
+
 bool PlaybackModel::hasToReloadTracks(const ScoreChangesRange& changesRange) const
 {
     static const std::unordered_set<ElementType> REQUIRED_TYPES = {
@@ -729,6 +884,25 @@ void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, Chang
     result->insert(trackId);
 }
 
+void PlaybackModel::collectChangedEventsRange(const InstrumentTrackId& trackId, const timestamp_t timestampFrom,
+                                              const timestamp_t timestampTo)
+{
+    PlaybackEventsChangesList& ranges = m_changedEventsRanges[trackId];
+
+    for (PlaybackEventsChanges& range : ranges) {
+        if (timestampFrom <= range.to && timestampTo >= range.from) {
+            range.from = std::min(range.from, timestampFrom);
+            range.to = std::max(range.to, timestampTo);
+            return;
+        }
+    }
+
+    PlaybackEventsChanges range;
+    range.from = timestampFrom;
+    range.to = timestampTo;
+    ranges.push_back(std::move(range));
+}
+
 void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks)
 {
     for (const InstrumentTrackId& trackId : changedTracks) {
@@ -738,9 +912,33 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents, search->second.dynamics, search->second.params);
+        PlaybackData& trackData = search->second;
+
+        auto rangesIt = m_changedEventsRanges.find(trackId);
+        if (rangesIt == m_changedEventsRanges.cend()) {
+            sendMainStream(trackData);
+            continue;
+        }
+
+        PlaybackEventsChangesList changes = mergeRanges(std::move(rangesIt->second));
+
+        bool isWholeTrack = changes.size() == 1
+                            && changes.front().from == std::numeric_limits<timestamp_t>::min()
+                            && changes.front().to == std::numeric_limits<timestamp_t>::max();
+        if (isWholeTrack) {
+            sendMainStream(trackData);
+            continue;
+        }
+
+        for (PlaybackEventsChanges& change : changes) {
+            change.events.insert(trackData.originEvents.lower_bound(change.from), trackData.originEvents.upper_bound(change.to));
+        }
+
+        trackData.mainStreamDelta.send(changes, trackData.dynamics, trackData.params, ++trackData.mainStreamRevision);
     }
 
+    m_changedEventsRanges.clear();
+
     for (auto it = m_playbackDataMap.cbegin(); it != m_playbackDataMap.cend(); ++it) {
         if (!muse::contains(oldTracks, it->first)) {
             m_trackAdded.send(it->first);
@@ -752,6 +950,11 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
     }
 }
 
+void PlaybackModel::sendMainStream(PlaybackData& trackData)
+{
+    trackData.mainStream.send(trackData.originEvents, trackData.dynamics, trackData.params, ++trackData.mainStreamRevision);
+}
+
 void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const muse::mpe::timestamp_t timestampFrom,
                                       const muse::mpe::timestamp_t timestampTo)
 {
@@ -769,6 +972,7 @@ void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mu
 
     if (timestampFrom == -1 && timestampTo == -1) {
         search->second.originEvents.clear();
+        collectChangedEventsRange(trackId, std::numeric_limits<timestamp_t>::min(), std::numeric_limits<timestamp_t>::max());
         return;
     }
 
@@ -778,8 +982,10 @@ void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mu
         //!Note Some events might be started RIGHT before the "official" start of the track
         //!     Need to make sure that we don't miss those events
         lowerBound = trackPlaybackData.originEvents.begin();
+        collectChangedEventsRange(trackId, std::numeric_limits<timestamp_t>::min(), timestampTo);
     } else {
         lowerBound = trackPlaybackData.originEvents.lower_bound(timestampFrom);
+        collectChangedEventsRange(trackId, timestampFrom, timestampTo);
     }
 
     auto upperBound = trackPlaybackData.originEvents.upper_bound(timestampTo);
@@ -947,3 +1153,9 @@ PlaybackContextPtr PlaybackModel::playbackCtx(const InstrumentTrackId& trackId)
 
     return it->second;
 }
+
+PlaybackContextPtr PlaybackModel::findPlaybackCtx(const InstrumentTrackId& trackId) const
+{
+    auto it = m_playbackCtxMap.find(trackId);
+    return it != m_playbackCtxMap.end() ? it->second : nullptr;
+}
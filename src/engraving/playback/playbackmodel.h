@@ -65,6 +65,9 @@ public:
     bool isPlayChordSymbolsEnabled() const;
     void setPlayChordSymbols(const bool isEnabled);
 
+    bool isParallelRenderingEnabled() const;
+    void setParallelRenderingEnabled(const bool isEnabled);
+
     const InstrumentTrackId& metronomeTrackId() const;
     InstrumentTrackId chordSymbolsTrackId(const ID& partId) const;
     bool isChordSymbolsTrack(const InstrumentTrackId& trackId) const;
@@ -86,6 +89,7 @@ private:
     static const InstrumentTrackId CHORD_SYMBOLS_TRACK_ID;
 
     using ChangedTrackIdSet = InstrumentTrackIdSet;
+    using TrackEventsMap = std::unordered_map<InstrumentTrackId, muse::mpe::PlaybackEventsMap>;
 
     struct TickBoundaries
     {
@@ -110,11 +114,17 @@ private:
     void updateContext(const InstrumentTrackId& trackId);
     void updateEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo,
                       ChangedTrackIdSet* trackChanges = nullptr);
+    void updateEventsInParallel(const RepeatList& repeats, const int tickFrom, const int tickTo,
+                                const std::vector<std::set<staff_idx_t> >& staffIdxSetByPart);
+    void renderEvents(const RepeatList& repeats, const int tickFrom, const int tickTo, const std::set<staff_idx_t>& staffIdxSet,
+                      bool renderMetronome, ChangedTrackIdSet* trackChanges, TrackEventsMap* eventsBuffer);
 
     void processSegment(const int tickPositionOffset, const Segment* segment, const std::set<staff_idx_t>& staffIdxSet,
-                        bool isFirstSegmentOfMeasure, ChangedTrackIdSet* trackChanges);
+                        bool isFirstSegmentOfMeasure, ChangedTrackIdSet* trackChanges, TrackEventsMap* eventsBuffer);
     void processMeasureRepeat(const int tickPositionOffset, const MeasureRepeat* measureRepeat, const Measure* currentMeasure,
-                              const staff_idx_t staffIdx, ChangedTrackIdSet* trackChanges);
+                              const staff_idx_t staffIdx, ChangedTrackIdSet* trackChanges, TrackEventsMap* eventsBuffer);
+
+    muse::mpe::PlaybackEventsMap& trackEvents(const InstrumentTrackId& trackId, TrackEventsMap* eventsBuffer);
 
     bool hasToReloadTracks(const ScoreChangesRange& changesRange) const;
     bool hasToReloadScore(const ScoreChangesRange& changesRange) const;
@@ -124,7 +134,10 @@ private:
     void clearExpiredContexts(const track_idx_t trackFrom, const track_idx_t trackTo);
     void clearExpiredEvents(const int tickFrom, const int tickTo, const track_idx_t trackFrom, const track_idx_t trackTo);
     void collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result);
+    void collectChangedEventsRange(const InstrumentTrackId& trackId, const muse::mpe::timestamp_t timestampFrom,
+                                   const muse::mpe::timestamp_t timestampTo);
     void notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, const InstrumentTrackIdSet& changedTracks);
+    void sendMainStream(muse::mpe::PlaybackData& trackData);
 
     void removeEventsFromRange(const track_idx_t trackFrom, const track_idx_t trackTo, const muse::mpe::timestamp_t timestampFrom = -1,
                                const muse::mpe::timestamp_t timestampTo = -1);
@@ -141,10 +154,12 @@ private:
     muse::mpe::ArticulationsProfilePtr defaultActiculationProfile(const InstrumentTrackId& trackId) const;
 
     PlaybackContextPtr playbackCtx(const InstrumentTrackId& trackId);
+    PlaybackContextPtr findPlaybackCtx(const InstrumentTrackId& trackId) const;
 
     Score* m_score = nullptr;
     bool m_expandRepeats = true;
     bool m_playChordSymbols = true;
+    bool m_parallelRendering = true;
 
     PlaybackEventsRenderer m_renderer;
     PlaybackSetupDataResolver m_setupResolver;
@@ -152,6 +167,9 @@ private:
     std::unordered_map<InstrumentTrackId, PlaybackContextPtr> m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, muse::mpe::PlaybackData> m_playbackDataMap;
 
+    //! NOTE The ranges of the events removed or rendered by the current change; only they are sent to the sequencers
+    std::unordered_map<InstrumentTrackId, muse::mpe::PlaybackEventsChangesList> m_changedEventsRanges;
+
     muse::async::Notification m_dataChanged;
     muse::async::Channel<InstrumentTrackId> m_trackAdded;
     muse::async::Channel<InstrumentTrackId> m_trackRemoved;
@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <set>
+#include <chrono>
 
 #include "../../types/fraction.h"
 #include "../../types/types.h"
@@ -240,6 +241,17 @@ public:
 
     double segmentShapeSqueezeFactor() const { return m_segmentShapeSqueezeFactor; }
 
+    const LayoutStatistics& statistics() const { return m_statistics; }
+
+    // the number of measures of the next system in the breaks hint, 0 if there is no hint
+    size_t hintedSystemMeasureCount() const
+    {
+        if (!m_breaksHint || m_hintedSystemIdx >= m_breaksHint->systemMeasureCounts.size()) {
+            return 0;
+        }
+        return m_breaksHint->systemMeasureCounts.at(m_hintedSystemIdx);
+    }
+
     // Mutable
     void setFirstSystem(bool val) { m_firstSystem = val; }
     void setFirstSystemIndent(bool val) { m_firstSystemIndent = val; }
@@ -279,6 +291,12 @@ public:
 
     void setSegmentShapeSqueezeFactor(double val) { m_segmentShapeSqueezeFactor = val; }
 
+    LayoutStatistics& statistics() { return m_statistics; }
+
+    void setBreaksHint(const LayoutBreaks* hint) { m_breaksHint = hint; m_hintedSystemIdx = 0; }
+    void nextHintedSystem() { ++m_hintedSystemIdx; }
+    void dropBreaksHint() { m_breaksHint = nullptr; }
+
 private:
 
     bool m_firstSystem = true;
@@ -310,10 +328,67 @@ private:
 
     double m_segmentShapeSqueezeFactor = 1.0;
 
+    LayoutStatistics m_statistics;
+
+    const LayoutBreaks* m_breaksHint = nullptr;
+    size_t m_hintedSystemIdx = 0;
+
     // cache
     double m_totalBracketsWidth = -1.0;
 };
 
+//---------------------------------------------------------
+//   LayoutTimer
+//    adds the lifetime of the timer to the given counter, ms,
+//    except the lifetime of the timers nested in it,
+//    so every step of the interleaved layout is timed on its own
+//---------------------------------------------------------
+
+class LayoutTimer
+{
+public:
+    explicit LayoutTimer(double& counterMs)
+        : m_counterMs(counterMs), m_parent(s_current)
+    {
+        const clock::time_point now = clock::now();
+        if (m_parent) {
+            m_parent->stop(now);
+        }
+
+        s_current = this;
+        m_start = now;
+    }
+
+    ~LayoutTimer()
+    {
+        const clock::time_point now = clock::now();
+        stop(now);
+
+        s_current = m_parent;
+        if (m_parent) {
+            m_parent->m_start = now;
+        }
+    }
+
+    LayoutTimer(const LayoutTimer&) = delete;
+    LayoutTimer& operator=(const LayoutTimer&) = delete;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    void stop(clock::time_point now)
+    {
+        std::chrono::duration<double, std::milli> elapsed = now - m_start;
+        m_counterMs += elapsed.count();
+    }
+
+    static inline thread_local LayoutTimer* s_current = nullptr;
+
+    double& m_counterMs;
+    LayoutTimer* m_parent = nullptr;
+    clock::time_point m_start;
+};
+
 class LayoutDebug
 {
 public:
@@ -837,6 +837,8 @@ void MeasureLayout::layoutMeasure(MeasureBase* currentMB, LayoutContext& ctx)
         return;
     }
 
+    ctx.mutState().statistics().addMeasure(currentMB->tick().ticks());
+
     int measureNo = adjustMeasureNo(currentMB, ctx.state().measureNo());
     LAYOUT_CALL() << LAYOUT_ITEM_INFO(currentMB) << " measureNo: " << measureNo;
 
@@ -1003,6 +1005,7 @@ void MeasureLayout::getNextMeasure(LayoutContext& ctx)
 {
     TRACEFUNC;
     LAYOUT_CALL();
+    LayoutTimer timer(ctx.mutState().statistics().measureLayoutMs);
 
     moveToNextMeasure(ctx);
 
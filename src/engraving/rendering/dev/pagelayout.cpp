@@ -124,6 +124,8 @@ void PageLayout::collectPage(LayoutContext& ctx)
 
     LAYOUT_CALL() << "page->no: " << page->no();
 
+    ctx.mutState().statistics().addPage(static_cast<int>(page->no()));
+
     const double slb = conf.styleMM(Sid::staffLowerBorder);
     bool breakPages = conf.viewMode() != LayoutMode::SYSTEM;
     double footerExtension = page->footerExtension();
@@ -302,6 +302,7 @@ void ScoreHorizontalViewLayout::collectLinearSystem(LayoutContext& ctx)
 
             if (m->tick() >= ctx.state().startTick() && m->tick() <= ctx.state().endTick()) {
                 // for measures in range, do full layout
+                ctx.mutState().statistics().addMeasure(m->tick().ticks());
                 if (ctx.conf().isMode(LayoutMode::HORIZONTAL_FIXED)) {
                     MeasureLayout::createEndBarLines(m, true, ctx);
                     layoutSegmentsWithDuration(m, visibleParts);
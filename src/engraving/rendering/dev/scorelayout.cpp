@@ -35,6 +35,8 @@
 
 #include "dumplayoutdata.h"
 
+#include "defer.h"
+
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
@@ -54,6 +56,11 @@ void ScoreLayout::layoutRange(Score* score, const Fraction& st, const Fraction&
     CmdStateLocker cmdStateLocker(score);
     LayoutContext ctx(score);
 
+    //! NOTE The breaks hint is only valid for the first layout after it was set
+    DEFER {
+        score->setLayoutBreaksHint(LayoutBreaks());
+    };
+
     Fraction stick(st);
     Fraction etick(et);
     assert(!(stick == Fraction(-1, 1) && etick == Fraction(-1, 1)));
@@ -66,6 +73,7 @@ void ScoreLayout::layoutRange(Score* score, const Fraction& st, const Fraction&
         muse::DeleteAll(score->pages());
         score->pages().clear();
         PageLayout::getNextPage(ctx);
+        updateStatistics(score, ctx);
         return;
     }
 
@@ -95,5 +103,24 @@ void ScoreLayout::layoutRange(Score* score, const Fraction& st, const Fraction&
         break;
     }
 
+    updateStatistics(score, ctx);
+
     //LOGDA() << DumpLayoutData::dump(score);
 }
+
+void ScoreLayout::updateStatistics(Score* score, LayoutContext& ctx)
+{
+    LayoutStatistics& stat = ctx.mutState().statistics();
+    stat.layoutNo = score->layoutStatistics().layoutNo + 1;
+    stat.isLayoutAll = ctx.state().isLayoutAll();
+    stat.pagesTotal = static_cast<int>(score->npages());
+
+    LOGD() << "layoutAll: " << stat.isLayoutAll
+           << ", measures: " << stat.measuresLaidOut
+           << ", systems: " << stat.systemsCollected << " (hinted: " << stat.systemsHinted << ")"
+           << ", pages: " << stat.pagesCollected << "/" << stat.pagesTotal
+           << " (" << stat.firstPageIdx << "-" << stat.lastPageIdx << ")"
+           << ", page layout: " << stat.pageLayoutMs << " ms";
+
+    score->setLayoutStatistics(stat);
+}
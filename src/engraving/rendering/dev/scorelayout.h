@@ -29,11 +29,16 @@ class Score;
 }
 
 namespace mu::engraving::rendering::dev {
+class LayoutContext;
 class ScoreLayout
 {
 public:
 
     static void layoutRange(Score* score, const Fraction& st, const Fraction& et);
+
+private:
+
+    static void updateStatistics(Score* score, LayoutContext& ctx);
 };
 }
 
@@ -127,6 +127,10 @@ void ScorePageViewLayout::initLayoutContext(const Score* score, LayoutContext& c
     }
 
     state.setPrevMeasure(nullptr);
+
+    if (state.isLayoutAll() && ctx.conf().isMode(LayoutMode::PAGE) && !score->layoutBreaksHint().empty()) {
+        state.setBreaksHint(&score->layoutBreaksHint());
+    }
 }
 
 void ScorePageViewLayout::prepareScore(Score* score, const LayoutContext& ctx)
@@ -177,18 +181,25 @@ void ScorePageViewLayout::layoutPageView(Score* score, LayoutContext& ctx, const
 
     //! NOTE Reset pass need anyway
 //#ifdef MUE_ENABLE_ENGRAVING_LD_PASSES
-    PassResetLayoutData resetPass;
-    resetPass.run(score, ctx);
+    {
+        LayoutTimer timer(ctx.mutState().statistics().resetPassMs);
+        PassResetLayoutData resetPass;
+        resetPass.run(score, ctx);
+    }
 //#endif
 
 #ifdef MUE_ENABLE_ENGRAVING_LD_PASSES
     if (ctx.state().isLayoutAll()) {
+        LayoutTimer timer(ctx.mutState().statistics().independentItemsPassMs);
         PassLayoutIndependentItems independentPass;
         independentPass.run(score, ctx);
     }
 #endif
 
-    doLayout(ctx);
+    {
+        LayoutTimer timer(ctx.mutState().statistics().pageLayoutMs);
+        doLayout(ctx);
+    }
 
     layoutFinished(score, ctx);
 
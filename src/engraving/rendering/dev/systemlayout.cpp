@@ -26,6 +26,8 @@
 #include "realfn.h"
 #include "defer.h"
 
+#include "concurrency/taskscheduler.h"
+
 #include "style/defaultstyle.h"
 
 #include "dom/barline.h"
@@ -79,13 +81,36 @@
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
+// systems with fewer visible staves are spaced on the layout thread only
+static constexpr size_t PARALLEL_STAFF_DISTANCES_MIN_STAVES = 16;
+
 //---------------------------------------------------------
 //   collectSystem
 //---------------------------------------------------------
 
+static void checkBreaksHint(const System* system, size_t hintedMeasureCount, LayoutContext& ctx)
+{
+    if (hintedMeasureCount == 0) {
+        return;
+    }
+
+    if (system->measures().size() == hintedMeasureCount) {
+        ctx.mutState().statistics().systemsHinted++;
+        return;
+    }
+
+    //! NOTE The hinted break is only accepted if the next measure doesn't fit, as without the hint.
+    //! A system that comes out longer or shorter means the content (or the fonts) differs from the one
+    //! the hint was made for, don't follow it anymore
+    LOGW() << "layout breaks hint doesn't match, system measures: " << system->measures().size()
+           << ", hinted: " << hintedMeasureCount;
+    ctx.mutState().dropBreaksHint();
+}
+
 System* SystemLayout::collectSystem(LayoutContext& ctx)
 {
     TRACEFUNC;
+    LayoutTimer timer(ctx.mutState().statistics().systemLayoutMs);
 
     if (!ctx.state().curMeasure()) {
         return nullptr;
@@ -115,6 +140,11 @@ System* SystemLayout::collectSystem(LayoutContext& ctx)
 
     LAYOUT_CALL() << LAYOUT_ITEM_INFO(system);
 
+    ctx.mutState().statistics().systemsCollected++;
+
+    const size_t hintedMeasureCount = ctx.state().hintedSystemMeasureCount();
+    ctx.mutState().nextHintedSystem();
+
     Fraction lcmTick = ctx.state().curMeasure()->tick();
     bool longNames = ctx.mutState().firstSystem() ? ctx.mutState().startWithLongNames() : subsSysLongName;
     SystemLayout::setInstrumentNames(system, ctx, longNames, lcmTick);
@@ -233,6 +263,7 @@ System* SystemLayout::collectSystem(LayoutContext& ctx)
             // vbox:
             MeasureLayout::getNextMeasure(ctx);
             SystemLayout::layout2(system, ctx);         // compute staff distances
+            checkBreaksHint(system, hintedMeasureCount, ctx);
             return system;
         }
 
@@ -380,6 +411,8 @@ System* SystemLayout::collectSystem(LayoutContext& ctx)
 
     assert(ctx.state().prevMeasure());
 
+    checkBreaksHint(system, hintedMeasureCount, ctx);
+
     if (ctx.state().endTick() < ctx.state().prevMeasure()->tick()) {
         // we've processed the entire range
         // but we need to continue layout until we reach a system whose last measure is the same as previous layout
@@ -2315,7 +2348,20 @@ void SystemLayout::layout2(System* system, LayoutContext& ctx)
         return;
     }
 
-    for (auto i = visibleStaves.begin();; ++i) {
+    const double minHorizontalClearance = ctx.conf().styleMM(Sid::skylineMinHorizontalClearance);
+
+    std::vector<double> skylineDistances;
+    if (visibleStaves.size() >= PARALLEL_STAFF_DISTANCES_MIN_STAVES) {
+        std::vector<const Skyline*> skylines;
+        skylines.reserve(visibleStaves.size());
+        for (const auto& p : visibleStaves) {
+            skylines.push_back(&p.second->skyline());
+        }
+        skylineDistances = computeSkylineDistances(skylines, minHorizontalClearance);
+    }
+
+    size_t pairIdx = 0;
+    for (auto i = visibleStaves.begin();; ++i, ++pairIdx) {
         SysStaff* ss  = i->second;
         staff_idx_t si1 = i->first;
         const Staff* staff  = ctx.dom().staff(si1);
@@ -2380,8 +2426,9 @@ void SystemLayout::layout2(System* system, LayoutContext& ctx)
             // the result is space is good to start and grows as needed
             // it does not, however, shrink when possible - only by trigger a full layout
             // (such as by toggling to page view and back)
-            const double minHorizontalClearance = ctx.conf().styleMM(Sid::skylineMinHorizontalClearance);
-            double d = ss->skyline().minDistance(system->System::staff(si2)->skyline(), minHorizontalClearance);
+            double d = skylineDistances.empty()
+                       ? ss->skyline().minDistance(system->System::staff(si2)->skyline(), minHorizontalClearance)
+                       : skylineDistances.at(pairIdx);
             if (ctx.conf().isLineMode()) {
                 double previousDist = ss->continuousDist();
                 if (d > previousDist) {
@@ -2417,6 +2464,49 @@ void SystemLayout::layout2(System* system, LayoutContext& ctx)
     SystemLayout::layoutInstrumentNames(system, ctx);
 }
 
+//---------------------------------------------------------
+//   computeSkylineDistances
+//    The distances between the skylines of adjacent staves
+//    don't depend on each other, so on big systems they are
+//    calculated concurrently. The layout thread takes the
+//    first chunk itself and then waits for the others.
+//---------------------------------------------------------
+
+std::vector<double> SystemLayout::computeSkylineDistances(const std::vector<const Skyline*>& skylines, double minHorizontalClearance)
+{
+    TRACEFUNC;
+
+    if (skylines.size() < 2) {
+        return {};
+    }
+
+    const size_t pairsCount = skylines.size() - 1;
+    std::vector<double> distances(pairsCount, 0.0);
+
+    auto computeRange = [&skylines, &distances, minHorizontalClearance](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            distances[i] = skylines[i]->minDistance(*skylines[i + 1], minHorizontalClearance);
+        }
+    };
+
+    const size_t chunksCount = std::min<size_t>(static_cast<size_t>(muse::TaskScheduler::instance()->threadPoolSize()) + 1, pairsCount);
+    const size_t chunkSize = (pairsCount + chunksCount - 1) / chunksCount;
+
+    muse::TaskGroup group;
+    for (size_t begin = chunkSize; begin < pairsCount; begin += chunkSize) {
+        const size_t end = std::min(begin + chunkSize, pairsCount);
+        group.run([&computeRange, begin, end]() {
+            computeRange(begin, end);
+        });
+    }
+
+    computeRange(0, std::min(chunkSize, pairsCount));
+
+    group.wait();
+
+    return distances;
+}
+
 double SystemLayout::minVertSpaceForCrossStaffBeams(System* system, staff_idx_t staffIdx1, staff_idx_t staffIdx2, LayoutContext& ctx)
 {
     double minSpace = -DBL_MAX;
@@ -31,6 +31,7 @@ namespace mu::engraving {
 class Chord;
 class Score;
 class Segment;
+class Skyline;
 class Spanner;
 class System;
 class Measure;
@@ -63,6 +64,9 @@ public:
 
     static void updateSkylineForElement(EngravingItem* element, const System* system, double yMove);
 
+    //! NOTE The distances between the adjacent skylines, calculated concurrently
+    static std::vector<double> computeSkylineDistances(const std::vector<const Skyline*>& skylines, double minHorizontalClearance);
+
 private:
     static System* getNextSystem(LayoutContext& lc);
     static void processLines(System* system, LayoutContext& ctx, std::vector<Spanner*> lines, bool align);
@@ -22,6 +22,9 @@
 #ifndef MU_ENGRAVING_LAYOUTOPTIONS_H
 #define MU_ENGRAVING_LAYOUTOPTIONS_H
 
+#include <cstddef>
+#include <vector>
+
 namespace mu::engraving {
 //---------------------------------------------------------
 //   LayoutMode
@@ -45,6 +48,91 @@ struct LayoutOptions
     bool isMode(LayoutMode m) const { return mode == m; }
     bool isLinearMode() const { return mode == LayoutMode::LINE || mode == LayoutMode::HORIZONTAL_FIXED; }
 };
+
+//---------------------------------------------------------
+//   LayoutStatistics
+//    What the last layout pass has actually touched.
+//    Measures, systems and pages outside of these ranges
+//    were reused from the previous layout as is.
+//---------------------------------------------------------
+
+struct LayoutStatistics
+{
+    bool isLayoutAll = false;
+
+    // number of the layout of the score, to tell whether the statistics are of a new layout
+    int layoutNo = 0;
+
+    int measuresLaidOut = 0;
+    int systemsCollected = 0;
+    int systemsHinted = 0;      // collected following the breaks hint
+    int pagesCollected = 0;
+    int pagesTotal = 0;
+
+    // ticks of the first and the last laid out measure, -1 if none
+    int firstMeasureTick = -1;
+    int lastMeasureTick = -1;
+
+    // indexes of the first and the last collected page, -1 if none
+    int firstPageIdx = -1;
+    int lastPageIdx = -1;
+
+    // wall time of the page view layout steps, ms
+    // the steps are interleaved, every time excludes the steps nested in it:
+    // the page layout is the time spent outside of collecting the systems and the measures
+    double resetPassMs = 0.0;
+    double independentItemsPassMs = 0.0;
+    double measureLayoutMs = 0.0;
+    double systemLayoutMs = 0.0;
+    double pageLayoutMs = 0.0;
+
+    int pagesReused() const { return pagesTotal - pagesCollected; }
+
+    void addMeasure(int tick)
+    {
+        ++measuresLaidOut;
+        if (firstMeasureTick < 0 || tick < firstMeasureTick) {
+            firstMeasureTick = tick;
+        }
+        if (tick > lastMeasureTick) {
+            lastMeasureTick = tick;
+        }
+    }
+
+    void addPage(int idx)
+    {
+        ++pagesCollected;
+        if (firstPageIdx < 0 || idx < firstPageIdx) {
+            firstPageIdx = idx;
+        }
+        if (idx > lastPageIdx) {
+            lastPageIdx = idx;
+        }
+    }
+};
+
+//---------------------------------------------------------
+//   LayoutBreaks
+//    Where the page view layout has broken the score into
+//    systems and pages: the number of measures (including
+//    frames) of each system and the number of systems of
+//    each page.
+//---------------------------------------------------------
+
+struct LayoutBreaks
+{
+    std::vector<size_t> systemMeasureCounts;
+    std::vector<size_t> pageSystemCounts;
+
+    bool empty() const { return systemMeasureCounts.empty(); }
+
+    bool operator==(const LayoutBreaks& other) const
+    {
+        return systemMeasureCounts == other.systemMeasureCounts && pageSystemCounts == other.pageSystemCounts;
+    }
+
+    bool operator!=(const LayoutBreaks& other) const { return !operator==(other); }
+};
 }
 
 #endif // MU_ENGRAVING_LAYOUTOPTIONS_H
@@ -83,6 +83,7 @@ void CompatUtils::doCompatibilityConversions(MasterScore* masterScore)
     }
 
     // TODO: collect all compatibility conversions here
+    // NOTE: keep hasCompatibilityConversions() in sync
     if (masterScore->mscVersion() < 400) {
         replaceStaffTextWithPlayTechniqueAnnotation(masterScore);
     }
@@ -105,6 +106,11 @@ void CompatUtils::doCompatibilityConversions(MasterScore* masterScore)
     }
 }
 
+bool CompatUtils::hasCompatibilityConversions(int mscVersion)
+{
+    return mscVersion < 440;
+}
+
 void CompatUtils::replaceStaffTextWithPlayTechniqueAnnotation(MasterScore* score)
 {
     TRACEFUNC;
@@ -42,6 +42,7 @@ class CompatUtils
 public:
     static void assignInitialPartToExcerpts(const std::vector<Excerpt*>& excerpts);
     static void doCompatibilityConversions(MasterScore* masterScore);
+    static bool hasCompatibilityConversions(int mscVersion);
     static ArticulationAnchor translateToNewArticulationAnchor(int anchor);
     static const std::set<SymId> ORNAMENT_IDS;
 
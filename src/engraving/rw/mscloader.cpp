@@ -21,10 +21,13 @@
  */
 #include "mscloader.h"
 
+#include <chrono>
 #include <memory>
 
 #include "global/io/buffer.h"
 #include "global/types/retval.h"
+#include "global/concurrency/taskscheduler.h"
+#include "global/serialization/zipreader.h"
 
 #include "../types/types.h"
 
@@ -32,6 +35,7 @@
 #include "../dom/audio.h"
 #include "../dom/excerpt.h"
 #include "../dom/imageStore.h"
+#include "../dom/part.h"
 
 #include "compat/compatutils.h"
 #include "compat/readstyle.h"
@@ -48,6 +52,115 @@ using namespace muse::io;
 using namespace mu::engraving;
 using namespace mu::engraving::rw;
 
+using Clock = std::chrono::steady_clock;
+
+//! NOTE What is needed to list an excerpt without reading it
+struct ExcerptHeader {
+    String name;
+    String partName;
+    ID initialPartId;
+    std::vector<ID> partIds;
+    bool isOpen = false;
+    bool isComplete = false; // the music has been reached, or the file has been read to the end
+};
+
+struct ExcerptFiles {
+    String fileName;
+    ZipReader::PackedFile packedStyle;
+    ZipReader::PackedFile packedScore;
+    ByteArray styleData;
+    ByteArray scoreData;
+    ExcerptHeader header;
+    bool isUnpacked = false;
+    int64_t unpackMsecs = 0;
+};
+
+struct DeferredExcerptFiles {
+    ZipReader::PackedFile style;
+    ZipReader::PackedFile score;
+    std::shared_ptr<const ReadLinks> links;
+    bool ignoreVersionError = false;
+};
+
+static int64_t msecsSince(Clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+static void unpackExcerptFiles(ExcerptFiles& files)
+{
+    files.styleData = ZipReader::unpack(files.packedStyle);
+    files.scoreData = ZipReader::unpack(files.packedScore);
+    files.packedStyle = ZipReader::PackedFile();
+    files.packedScore = ZipReader::PackedFile();
+    files.isUnpacked = true;
+}
+
+static ExcerptHeader readExcerptHeader(const ByteArray& scoreData)
+{
+    ExcerptHeader header;
+
+    XmlReader e(scoreData);
+    if (!e.readNextStartElement() || e.name() != "museScore") {
+        return header;
+    }
+
+    while (e.readNextStartElement()) {
+        if (e.name() != "Score") {
+            e.skipCurrentElement();
+            continue;
+        }
+
+        while (e.readNextStartElement()) {
+            const AsciiStringView tag(e.name());
+            if (tag == "name") {
+                header.name = e.readText();
+            } else if (tag == "initialPartId") {
+                header.initialPartId = ID(e.readInt());
+            } else if (tag == "open") {
+                header.isOpen = e.readBool();
+            } else if (tag == "metaTag" && e.attribute("name") == u"partName") {
+                header.partName = e.readText();
+            } else if (tag == "Part") {
+                header.partIds.push_back(ID(e.intAttribute("id", 0)));
+                e.skipCurrentElement();
+            } else if (tag == "Staff") {
+                // the music follows, there is nothing more to list
+                header.isComplete = true;
+                return header;
+            } else {
+                e.skipCurrentElement();
+            }
+        }
+
+        break;
+    }
+
+    header.isComplete = !e.isError();
+
+    return header;
+}
+
+// the header is usually within the first few kilobytes, the part definitions are the largest part of it
+static constexpr size_t EXCERPT_HEADER_UNPACK_SIZE = 16 * 1024;
+
+//! NOTE Only the beginning of the file is unpacked, as much as the header needs
+static ExcerptHeader readExcerptHeader(const ZipReader::PackedFile& packedScore)
+{
+    size_t size = EXCERPT_HEADER_UNPACK_SIZE;
+    while (true) {
+        const ByteArray data = ZipReader::unpack(packedScore, size);
+        const ExcerptHeader header = readExcerptHeader(data);
+
+        // a shorter result is the whole file
+        if (header.isComplete || data.size() < size) {
+            return header;
+        }
+
+        size *= 2;
+    }
+}
+
 static RetVal<IReaderPtr> makeReader(int version, bool ignoreVersionError)
 {
     if (!ignoreVersionError) {
@@ -71,6 +184,93 @@ static RetVal<IReaderPtr> makeReader(int version, bool ignoreVersionError)
     return RetVal<IReaderPtr>::make_ok(RWRegister::reader(version));
 }
 
+static Ret readExcerpt(MasterScore* masterScore, Excerpt* ex, ByteArray styleData, ByteArray scoreData, const ReadLinks& links,
+                       bool ignoreVersionError)
+{
+    Score* partScore = masterScore->createScore();
+
+    compat::ReadStyleHook::setupDefaultStyle(partScore);
+
+    //! NOTE The reader needs the excerpt of the score,
+    //! but the excerpt gets the score only if it is read successfully
+    partScore->setExcerpt(ex);
+
+    Buffer excerptStyleBuf(&styleData);
+    excerptStyleBuf.open(IODevice::ReadOnly);
+    partScore->style().read(&excerptStyleBuf);
+
+    XmlReader xml(scoreData);
+    xml.setDocName(ex->fileName());
+
+    ReadInOutData partReadInData;
+    partReadInData.links = links;
+
+    RetVal<IReaderPtr> reader = makeReader(masterScore->mscVersion(), ignoreVersionError);
+    if (!reader.ret) {
+        delete partScore;
+        return reader.ret;
+    }
+
+    Err err = reader.val->readScore(partScore, xml, &partReadInData);
+    if (err != Err::NoError) {
+        delete partScore;
+        return make_ret(err);
+    }
+
+    ex->setExcerptScore(partScore);
+
+    partScore->linkMeasures(masterScore);
+
+    if (ex->name().empty()) {
+        // If no excerpt name tag was found while reading, try the "partName" meta tag
+        const String nameFromMeta = partScore->metaTag(u"partName");
+
+        if (nameFromMeta.empty()) {
+            // If that's also empty, fall back to the filename
+            ex->setName(ex->fileName(), /*saveAndNotify=*/ false);
+        } else {
+            ex->setName(nameFromMeta, /*saveAndNotify=*/ false);
+        }
+    }
+
+    return muse::make_ok();
+}
+
+static Ret readDeferredExcerpt(Excerpt* ex, const DeferredExcerptFiles& files)
+{
+    Clock::time_point start = Clock::now();
+
+    Ret ret = readExcerpt(ex->masterScore(), ex, ZipReader::unpack(files.style), ZipReader::unpack(files.score), *files.links,
+                          files.ignoreVersionError);
+    if (!ret) {
+        return ret;
+    }
+
+    LOGD() << "deferred excerpt " << ex->fileName() << " read in " << msecsSince(start) << " ms";
+
+    return muse::make_ok();
+}
+
+//! NOTE A deferred excerpt is listed with the parts of the master score it shows,
+//! an open excerpt is read at once, as it is going to be shown anyway
+static bool canDeferExcerpt(const MasterScore* masterScore, const ExcerptHeader& header, std::vector<Part*>& parts)
+{
+    if (header.isOpen || header.partIds.empty()) {
+        return false;
+    }
+
+    for (const ID& partId : header.partIds) {
+        Part* part = masterScore->partById(partId);
+        if (!part) {
+            return false;
+        }
+
+        parts.push_back(part);
+    }
+
+    return true;
+}
+
 Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, SettingsCompat& settingsCompat,
                         bool ignoreVersionError, rw::ReadInOutData* inOut)
 {
@@ -124,6 +324,41 @@ Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, Se
 
     Ret ret = muse::make_ok();
 
+    //! NOTE Unpacking the excerpt files doesn't touch the score,
+    //! so it is done on the thread pool while the master score is being read
+    const bool deferExcerpts = MScore::deferExcerpts;
+    std::vector<ExcerptFiles> excerptFiles;
+    muse::TaskGroup unpackTasks;
+    {
+        std::vector<String> excerptFileNames = mscReader.excerptFileNames();
+        excerptFiles.resize(excerptFileNames.size());
+
+        for (size_t i = 0; i < excerptFileNames.size(); ++i) {
+            ExcerptFiles* files = &excerptFiles[i];
+            files->fileName = excerptFileNames[i];
+
+            unpackTasks.run([files, &mscReader, deferExcerpts]() {
+                Clock::time_point start = Clock::now();
+                files->packedStyle = mscReader.readPackedExcerptStyleFile(files->fileName);
+                files->packedScore = mscReader.readPackedExcerptFile(files->fileName);
+
+                //! NOTE An excerpt which may be deferred is unpacked when it is read (see unpackExcerptFiles),
+                //! the open ones are read with the master score anyway
+                if (deferExcerpts) {
+                    files->header = readExcerptHeader(files->packedScore);
+                }
+
+                if (!deferExcerpts || files->header.isOpen) {
+                    unpackExcerptFiles(*files);
+                }
+
+                files->unpackMsecs = msecsSince(start);
+            });
+        }
+    }
+
+    Clock::time_point masterStart = Clock::now();
+
     // Read score
     {
         ByteArray scoreData = mscReader.readScoreFile();
@@ -137,58 +372,70 @@ Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, Se
         ret = readMasterScore(masterScore, xml, ignoreVersionError, inOut, &styleHook);
     }
 
+    const int64_t masterMsecs = msecsSince(masterStart);
+
+    Clock::time_point unpackWaitStart = Clock::now();
+    unpackTasks.wait();
+    const int64_t unpackWaitMsecs = msecsSince(unpackWaitStart);
+
+    LOGD() << "master score read in " << masterMsecs << " ms, waited for excerpt files " << unpackWaitMsecs << " ms";
+
     // Read excerpts
+    //! NOTE Reading allocates element ids and links elements to those of the master score,
+    //! both owned by the master score, so the excerpts are read one after another
     if (ret && masterScore->mscVersion() >= 400) {
-        std::vector<String> excerptFileNames = mscReader.excerptFileNames();
-        for (const String& excerptFileName : excerptFileNames) {
-            Score* partScore = masterScore->createScore();
-
-            compat::ReadStyleHook::setupDefaultStyle(partScore);
+        //! NOTE The compatibility conversions are done for all the excerpts at once, right after loading
+        const bool canDefer = deferExcerpts && !compat::CompatUtils::hasCompatibilityConversions(masterScore->mscVersion());
+        std::shared_ptr<const ReadLinks> links;
 
+        for (ExcerptFiles& files : excerptFiles) {
             Excerpt* ex = new Excerpt(masterScore);
-            ex->setExcerptScore(partScore);
-            ex->setFileName(excerptFileName);
+            ex->setFileName(files.fileName);
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptFileName);
-            Buffer excerptStyleBuf(&excerptStyleData);
-            excerptStyleBuf.open(IODevice::ReadOnly);
-            partScore->style().read(&excerptStyleBuf);
-
-            ByteArray excerptData = mscReader.readExcerptFile(excerptFileName);
+            std::vector<Part*> parts;
+            if (canDefer && canDeferExcerpt(masterScore, files.header, parts)) {
+                if (!links) {
+                    links = std::make_shared<const ReadLinks>(inOut->links);
+                }
 
-            XmlReader xml(excerptData);
-            xml.setDocName(excerptFileName);
+                DeferredExcerptFiles deferred;
+                deferred.style = std::move(files.packedStyle);
+                deferred.score = std::move(files.packedScore);
+                deferred.links = links;
+                deferred.ignoreVersionError = ignoreVersionError;
+
+                const ExcerptHeader& header = files.header;
+                ex->setName(!header.name.empty() ? header.name : (!header.partName.empty() ? header.partName : files.fileName),
+                            /*saveAndNotify=*/ false);
+                ex->setInitialPartId(header.initialPartId);
+                ex->setParts(parts);
+                ex->setDeferredRead([deferred = std::move(deferred)](Excerpt* ex) {
+                    return readDeferredExcerpt(ex, deferred);
+                });
+
+                masterScore->addExcerpt(ex);
+
+                LOGD() << "excerpt " << files.fileName << ": unpacked in " << files.unpackMsecs << " ms, deferred";
+                continue;
+            }
 
-            ReadInOutData partReadInData;
-            partReadInData.links = inOut->links;
+            Clock::time_point readStart = Clock::now();
 
-            RetVal<IReaderPtr> reader = makeReader(masterScore->mscVersion(), ignoreVersionError);
-            if (!reader.ret) {
-                ret = reader.ret;
-                break;
+            if (!files.isUnpacked) {
+                unpackExcerptFiles(files);
             }
 
-            Err err = reader.val->readScore(partScore, xml, &partReadInData);
-            ret =  make_ret(err);
+            ret = readExcerpt(masterScore, ex, std::move(files.styleData), std::move(files.scoreData), inOut->links,
+                              ignoreVersionError);
             if (!ret) {
+                delete ex;
                 break;
             }
 
-            partScore->linkMeasures(masterScore);
-
-            if (ex->name().empty()) {
-                // If no excerpt name tag was found while reading, try the "partName" meta tag
-                const String nameFromMeta = partScore->metaTag(u"partName");
-
-                if (nameFromMeta.empty()) {
-                    // If that's also empty, fall back to the filename
-                    ex->setName(excerptFileName, /*saveAndNotify=*/ false);
-                } else {
-                    ex->setName(nameFromMeta, /*saveAndNotify=*/ false);
-                }
-            }
-
             masterScore->addExcerpt(ex);
+
+            LOGD() << "excerpt " << files.fileName << ": unpacked in " << files.unpackMsecs << " ms, read and linked in "
+                   << msecsSince(readStart) << " ms";
         }
     }
 
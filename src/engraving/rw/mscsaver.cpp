@@ -47,6 +47,9 @@ bool MscSaver::writeMscz(MasterScore* score, MscWriter& mscWriter, bool onlySele
         return false;
     }
 
+    //! NOTE The links to the parts are written with the master score, so the parts are read first
+    score->readDeferredExcerpts();
+
     // Write style of MasterScore
     {
         //! NOTE The style is writing to a separate file only for the master score.
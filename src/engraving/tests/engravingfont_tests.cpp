@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "io/dir.h"
+#include "io/file.h"
+
+#include "internal/engravingfont.h"
+
+#include "mocks/engravingconfigurationmock.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const muse::io::path_t METRICS_CACHE_DIR("engravingfont_metrics_cache");
+
+class Engraving_EngravingFontTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::shared_ptr<IEngravingConfiguration> configuration
+            = muse::modularity::globalIoc()->resolve<IEngravingConfiguration>("utests");
+        m_configuration = dynamic_cast<EngravingConfigurationMock*>(configuration.get());
+        ASSERT_TRUE(m_configuration);
+
+        muse::io::Dir(METRICS_CACHE_DIR).removeRecursively();
+        ON_CALL(*m_configuration, fontMetricsCachePath()).WillByDefault(::testing::Return(METRICS_CACHE_DIR));
+    }
+
+    void TearDown() override
+    {
+        ON_CALL(*m_configuration, fontMetricsCachePath()).WillByDefault(::testing::Return(muse::io::path_t()));
+        muse::io::Dir(METRICS_CACHE_DIR).removeRecursively();
+    }
+
+    EngravingConfigurationMock* m_configuration = nullptr;
+};
+
+TEST_F(Engraving_EngravingFontTests, metricsCache)
+{
+    // [GIVEN] A font loaded without a cache, which generates one
+    EngravingFont computed("Bravura", "Bravura", ":/fonts/bravura/Bravura.otf", muse::modularity::globalCtx());
+    computed.ensureLoad();
+
+    const muse::io::path_t cacheFilePath = METRICS_CACHE_DIR + "/Bravura.metrics";
+    ASSERT_TRUE(muse::io::File::exists(cacheFilePath));
+
+    // [WHEN] The same font is loaded again
+    EngravingFont cached("Bravura", "Bravura", ":/fonts/bravura/Bravura.otf", muse::modularity::globalCtx());
+    cached.ensureLoad();
+
+    // [THEN] The metrics read from the cache are the same as the computed ones
+    for (size_t i = 0; i < static_cast<size_t>(SymId::lastSym); ++i) {
+        SymId id = static_cast<SymId>(i);
+        EXPECT_EQ(cached.symCode(id), computed.symCode(id));
+        EXPECT_EQ(cached.isValid(id), computed.isValid(id));
+        EXPECT_EQ(cached.bbox(id, 1.0), computed.bbox(id, 1.0));
+        EXPECT_DOUBLE_EQ(cached.advance(id, 1.0), computed.advance(id, 1.0));
+        EXPECT_EQ(cached.fromCode(cached.symCode(id)), computed.fromCode(computed.symCode(id)));
+
+        for (SmuflAnchorId anchorId : { SmuflAnchorId::stemDownNW, SmuflAnchorId::stemUpSE, SmuflAnchorId::cutOutNE,
+                                        SmuflAnchorId::cutOutSW, SmuflAnchorId::opticalCenter }) {
+            EXPECT_EQ(cached.smuflAnchor(id, anchorId, 1.0), computed.smuflAnchor(id, anchorId, 1.0));
+        }
+    }
+
+    EXPECT_EQ(cached.engravingDefaults(), computed.engravingDefaults());
+    EXPECT_DOUBLE_EQ(cached.textEnclosureThickness(), computed.textEnclosureThickness());
+}
+
+TEST_F(Engraving_EngravingFontTests, metricsCache_Invalid)
+{
+    // [GIVEN] A corrupted cache file
+    const muse::io::path_t cacheFilePath = METRICS_CACHE_DIR + "/Bravura.metrics";
+    muse::io::Dir::mkpath(METRICS_CACHE_DIR);
+    muse::io::File::writeFile(cacheFilePath, muse::ByteArray("MSFM garbage"));
+
+    // [WHEN] The font is loaded
+    EngravingFont font("Bravura", "Bravura", ":/fonts/bravura/Bravura.otf", muse::modularity::globalCtx());
+    font.ensureLoad();
+
+    // [THEN] The metrics are computed and the cache is rewritten
+    EXPECT_TRUE(font.isValid(SymId::noteheadBlack));
+    EXPECT_EQ(font.fromCode(font.symCode(SymId::noteheadBlack)), SymId::noteheadBlack);
+
+    muse::ByteArray data;
+    muse::io::File::readFile(cacheFilePath, data);
+    EXPECT_GT(data.size(), sizeof("MSFM garbage"));
+}
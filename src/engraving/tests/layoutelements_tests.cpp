@@ -156,3 +156,122 @@ TEST_F(Engraving_LayoutElementsTests, tstLayoutCrossStaffArp)
 
     delete score;
 }
+
+TEST_F(Engraving_LayoutElementsTests, tstLayoutStatistics)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    EXPECT_TRUE(score);
+
+    // full layout touches everything
+    score->doLayout();
+
+    const LayoutStatistics fullStat = score->layoutStatistics();
+    EXPECT_TRUE(fullStat.isLayoutAll);
+    EXPECT_GE(fullStat.measuresLaidOut, static_cast<int>(score->nmeasures()));
+    EXPECT_EQ(fullStat.pagesCollected, static_cast<int>(score->npages()));
+    EXPECT_EQ(fullStat.pagesReused(), 0);
+
+    // layout of the last measure should not touch the beginning of the score
+    Measure* lastMeasure = score->lastMeasure();
+    score->doLayoutRange(lastMeasure->tick(), lastMeasure->endTick());
+
+    const LayoutStatistics rangeStat = score->layoutStatistics();
+    EXPECT_EQ(rangeStat.layoutNo, fullStat.layoutNo + 1);
+    EXPECT_FALSE(rangeStat.isLayoutAll);
+    EXPECT_LT(rangeStat.measuresLaidOut, fullStat.measuresLaidOut);
+    EXPECT_GT(rangeStat.firstMeasureTick, 0);
+    EXPECT_EQ(rangeStat.lastPageIdx, static_cast<int>(score->npages()) - 1);
+    EXPECT_GE(rangeStat.firstPageIdx, 0);
+    EXPECT_LE(rangeStat.firstPageIdx, rangeStat.lastPageIdx);
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstLayoutRangeStopsEarly)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    EXPECT_TRUE(score);
+
+    score->doLayout();
+
+    const int pagesCount = static_cast<int>(score->npages());
+    const int systemsCount = static_cast<int>(score->systems().size());
+    ASSERT_GT(pagesCount, 1);
+
+    // layout of the first measure
+    Measure* firstMeasure = score->firstMeasure();
+    score->doLayoutRange(firstMeasure->tick(), firstMeasure->endTick());
+
+    // stops as soon as the system and page breaks are the same as before:
+    // the following systems are taken unchanged, the following pages are not collected again
+    const LayoutStatistics stat = score->layoutStatistics();
+    EXPECT_FALSE(stat.isLayoutAll);
+    EXPECT_EQ(stat.firstMeasureTick, 0);
+    EXPECT_LT(stat.lastMeasureTick, score->lastMeasure()->tick().ticks());
+    EXPECT_LT(stat.measuresLaidOut, static_cast<int>(score->nmeasures()));
+    EXPECT_LT(stat.systemsCollected, systemsCount);
+    EXPECT_EQ(stat.firstPageIdx, 0);
+    EXPECT_LT(stat.lastPageIdx, pagesCount - 1);
+    EXPECT_GT(stat.pagesReused(), 0);
+
+    // the result is the same as that of a full layout
+    EXPECT_EQ(static_cast<int>(score->npages()), pagesCount);
+    EXPECT_EQ(static_cast<int>(score->systems().size()), systemsCount);
+
+    delete score;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstLayoutBreaksHint)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + "moonlight.mscx");
+    EXPECT_TRUE(score);
+
+    score->doLayout();
+
+    const LayoutBreaks breaks = score->layoutBreaks();
+    EXPECT_EQ(breaks.systemMeasureCounts.size(), score->systems().size());
+    EXPECT_EQ(breaks.pageSystemCounts.size(), score->npages());
+
+    std::vector<RectF> measureBoxes;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        measureBoxes.push_back(m->canvasBoundingRect());
+    }
+
+    // a layout following the breaks of the previous one gives the same result
+    score->setLayoutBreaksHint(breaks);
+    score->doLayout();
+
+    EXPECT_EQ(score->layoutStatistics().systemsHinted, score->layoutStatistics().systemsCollected);
+    EXPECT_EQ(score->layoutBreaks(), breaks);
+
+    size_t measureIdx = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        EXPECT_EQ(m->canvasBoundingRect(), measureBoxes.at(measureIdx++));
+    }
+
+    // a hint that doesn't match the content is dropped, whether the hinted system is too long
+    LayoutBreaks longBreaks = breaks;
+    longBreaks.systemMeasureCounts.front() += 1;
+    score->setLayoutBreaksHint(longBreaks);
+    score->doLayout();
+
+    EXPECT_EQ(score->layoutStatistics().systemsHinted, 0);
+    EXPECT_EQ(score->layoutBreaks(), breaks);
+
+    // or too short, although the hinted break could be followed
+    ASSERT_GT(breaks.systemMeasureCounts.front(), 1u);
+    LayoutBreaks shortBreaks = breaks;
+    shortBreaks.systemMeasureCounts.front() -= 1;
+    score->setLayoutBreaksHint(shortBreaks);
+    score->doLayout();
+
+    EXPECT_EQ(score->layoutStatistics().systemsHinted, 0);
+    EXPECT_EQ(score->layoutBreaks(), breaks);
+
+    measureIdx = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        EXPECT_EQ(m->canvasBoundingRect(), measureBoxes.at(measureIdx++));
+    }
+
+    delete score;
+}
@@ -31,6 +31,7 @@ class EngravingConfigurationMock : public IEngravingConfiguration
 {
 public:
     MOCK_METHOD(muse::io::path_t, appDataPath, (), (const, override));
+    MOCK_METHOD(muse::io::path_t, fontMetricsCachePath, (), (const, override));
 
     MOCK_METHOD(muse::io::path_t, defaultStyleFilePath, (), (const, override));
     MOCK_METHOD(void, setDefaultStyleFilePath, (const muse::io::path_t&), (override));
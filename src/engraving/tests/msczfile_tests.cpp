@@ -24,6 +24,7 @@
 #include <QByteArray>
 
 #include "io/buffer.h"
+#include "concurrency/taskscheduler.h"
 #include "infrastructure/mscwriter.h"
 #include "infrastructure/mscreader.h"
 
@@ -88,3 +89,176 @@ TEST_F(Engraving_MsczFileTests, MsczFile_WriteRead)
         EXPECT_EQ(imageData, originImageData);
     }
 }
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadExcerptsConcurrently)
+{
+    //! CASE Reading the excerpt files from several threads, as the loader does
+
+    //! GIVEN A file with many excerpts
+    constexpr size_t EXCERPT_COUNT = 32;
+
+    auto excerptName = [](size_t i) {
+        return String(u"Part %1").arg(static_cast<int>(i));
+    };
+
+    auto excerptData = [](size_t i) {
+        std::string data(1000 + i * 100, static_cast<char>('a' + i % 26));
+        return ByteArray(data.c_str(), data.size());
+    };
+
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "excerpts.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+
+        writer.writeScoreFile(ByteArray("score"));
+        for (size_t i = 0; i < EXCERPT_COUNT; ++i) {
+            writer.addExcerptStyleFile(excerptName(i), ByteArray("style"));
+            writer.addExcerptFile(excerptName(i), excerptData(i));
+        }
+    }
+
+    //! DO Read the excerpts concurrently
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "excerpts.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    std::vector<String> names = reader.excerptFileNames();
+    ASSERT_EQ(names.size(), EXCERPT_COUNT);
+
+    std::vector<ByteArray> datas(names.size());
+    std::vector<ByteArray> styles(names.size());
+
+    muse::TaskScheduler scheduler(4);
+    muse::TaskGroup group(muse::TaskPriority::Normal, &scheduler);
+    for (size_t i = 0; i < names.size(); ++i) {
+        group.run([&, i]() {
+            styles[i] = reader.readExcerptStyleFile(names.at(i));
+            datas[i] = reader.readExcerptFile(names.at(i));
+        });
+    }
+    group.wait();
+
+    //! CHECK Every excerpt is read intact
+    for (size_t i = 0; i < names.size(); ++i) {
+        size_t idx = 0;
+        for (; idx < EXCERPT_COUNT; ++idx) {
+            if (names.at(i) == excerptName(idx)) {
+                break;
+            }
+        }
+        ASSERT_LT(idx, EXCERPT_COUNT);
+
+        EXPECT_EQ(datas.at(i), excerptData(idx));
+        EXPECT_EQ(styles.at(i), ByteArray("style"));
+    }
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_ReadPackedExcerpt)
+{
+    //! CASE Reading an excerpt file as it is stored in the container and unpacking it later
+
+    //! GIVEN A file with an excerpt
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += "<Measure><voice><Rest><durationType>measure</durationType></Rest></voice></Measure>\n";
+    }
+    const ByteArray originExcerptData(text.c_str(), text.size());
+
+    ByteArray msczData;
+    {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "packed.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+
+        writer.writeScoreFile(ByteArray("score"));
+        writer.addExcerptStyleFile(u"Part", ByteArray("style"));
+        writer.addExcerptFile(u"Part", originExcerptData);
+    }
+
+    //! DO Read the excerpt packed
+    Buffer buf(&msczData);
+    MscReader::Params params;
+    params.device = &buf;
+    params.filePath = "packed.mscz";
+    params.mode = MscIoMode::Zip;
+
+    MscReader reader(params);
+    reader.open();
+
+    ZipReader::PackedFile packed = reader.readPackedExcerptFile(u"Part");
+
+    //! CHECK It is kept compressed and unpacks to the origin
+    EXPECT_FALSE(packed.isNull());
+    EXPECT_EQ(packed.uncompressedSize, originExcerptData.size());
+    EXPECT_LT(packed.data.size(), originExcerptData.size());
+    EXPECT_EQ(ZipReader::unpack(packed), originExcerptData);
+    EXPECT_EQ(ZipReader::unpack(reader.readPackedExcerptStyleFile(u"Part")), ByteArray("style"));
+}
+
+TEST_F(Engraving_MsczFileTests, MsczFile_WriteDeferred)
+{
+    //! CASE Serializing the files on one thread and writing them on another, as the autosave does
+
+    //! GIVEN A deferred writer
+    const ByteArray originScoreData("score");
+    const ByteArray originImageData("image");
+
+    ByteArray msczData;
+    Buffer buf(&msczData);
+
+    MscWriter::Params params;
+    params.device = &buf;
+    params.filePath = "deferred.mscz";
+    params.mode = MscIoMode::Zip;
+    params.deferred = true;
+
+    std::shared_ptr<MscWriter> writer = std::make_shared<MscWriter>(params);
+    EXPECT_TRUE(writer->open());
+
+    //! DO Write datas
+    writer->writeScoreFile(originScoreData);
+    writer->addImageFile(u"image1.png", originImageData);
+
+    //! CHECK Nothing is written until the writer is closed
+    EXPECT_TRUE(msczData.empty());
+
+    //! DO Close the writer on a worker thread
+    muse::TaskScheduler scheduler(1);
+    muse::TaskGroup group(muse::TaskPriority::Normal, &scheduler);
+    group.run([writer]() {
+        writer->close();
+    });
+    group.wait();
+
+    EXPECT_FALSE(writer->hasError());
+
+    //! CHECK Read and compare with origin
+    Buffer readBuf(&msczData);
+    MscReader::Params readParams;
+    readParams.device = &readBuf;
+    readParams.filePath = "deferred.mscz";
+    readParams.mode = MscIoMode::Zip;
+
+    MscReader reader(readParams);
+    reader.open();
+
+    EXPECT_EQ(reader.readScoreFile(), originScoreData);
+    EXPECT_EQ(reader.readImageFile(u"image1.png"), originImageData);
+}
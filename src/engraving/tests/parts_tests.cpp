@@ -31,6 +31,7 @@
 #include "dom/factory.h"
 #include "dom/fingering.h"
 #include "dom/image.h"
+#include "dom/linkedobjects.h"
 #include "dom/masterscore.h"
 #include "dom/measure.h"
 #include "dom/measurerepeat.h"
@@ -1398,6 +1399,81 @@ TEST_F(Engraving_PartsTests, inputFromParts) {
     MScore::useRead302InTestMode = useRead302;
 }
 
+TEST_F(Engraving_PartsTests, readDeferredExcerpts) {
+    bool useRead302 = MScore::useRead302InTestMode;
+    MScore::useRead302InTestMode = false;
+    MScore::deferExcerpts = true;
+
+    // Only the Flute part is open in this file, the other parts are not read until needed
+
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"deferred-excerpts.mscz");
+    MScore::deferExcerpts = false;
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->excerpts().size(), 4);
+
+    Excerpt* flute = nullptr;
+    Excerpt* oboe = nullptr;
+    for (Excerpt* excerpt : score->excerpts()) {
+        EXPECT_EQ(excerpt->parts().size(), 1);
+        EXPECT_EQ(excerpt->initialPartId(), excerpt->parts().front()->id());
+        EXPECT_FALSE(excerpt->isEmpty());
+
+        if (excerpt->name() == u"Flute") {
+            flute = excerpt;
+        } else if (excerpt->name() == u"Oboe") {
+            oboe = excerpt;
+        }
+    }
+    ASSERT_TRUE(flute && oboe);
+
+    EXPECT_FALSE(flute->isDeferred());
+    EXPECT_TRUE(oboe->isDeferred());
+    EXPECT_EQ(score->scoreList().size(), 2);
+
+    // A deferred excerpt has no score until it is read, then it is linked to the master score
+
+    EXPECT_FALSE(oboe->excerptScore());
+
+    Staff* oboeStaff = score->staff(1);
+    oboe->readDeferred();
+    Score* oboePart = oboe->excerptScore();
+    ASSERT_TRUE(oboePart);
+    EXPECT_FALSE(oboe->isDeferred());
+    EXPECT_EQ(oboe->parts().size(), 1);
+    EXPECT_EQ(oboe->parts().front(), oboeStaff->part());
+    ASSERT_TRUE(oboePart->staff(0)->links());
+    EXPECT_TRUE(oboePart->staff(0)->links()->contains(oboeStaff));
+    EXPECT_EQ(score->scoreList().size(), 3);
+
+    // Any edit reads the remaining excerpts first, so that it reaches all the linked elements
+
+    score->startCmd();
+    Segment* segment = score->firstMeasure()->findFirstR(SegmentType::ChordRest, Fraction(0, 1));
+    score->setNoteRest(segment, staff2track(3), NoteVal(48), Fraction(1, 4));
+    score->endCmd();
+
+    for (Excerpt* excerpt : score->excerpts()) {
+        EXPECT_FALSE(excerpt->isDeferred());
+    }
+    EXPECT_EQ(score->scoreList().size(), 5);
+
+    Excerpt* bassoon = nullptr;
+    for (Excerpt* excerpt : score->excerpts()) {
+        if (excerpt->name() == u"Bassoon") {
+            bassoon = excerpt;
+        }
+    }
+    ASSERT_TRUE(bassoon);
+    Segment* partSegment = bassoon->excerptScore()->tick2segment(Fraction(0, 1), true, SegmentType::ChordRest);
+    ASSERT_TRUE(partSegment);
+    EngravingItem* partChord = partSegment->element(0);
+    ASSERT_TRUE(partChord && partChord->isChord());
+    EXPECT_EQ(toChord(partChord)->upNote()->pitch(), 48);
+
+    delete score;
+    MScore::useRead302InTestMode = useRead302;
+}
+
 //---------------------------------------------------------
 //   staffStyles
 //---------------------------------------------------------
@@ -22,6 +22,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <chrono>
 #include <memory>
 
 #include "async/asyncable.h"
@@ -36,6 +37,8 @@
 
 #include "playback/playbackmodel.h"
 
+#include "log.h"
+
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::_;
@@ -815,8 +818,8 @@ TEST_F(Engraving_PlaybackModelTests, Multi_Measure_Repeat)
  * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 4 measures
  *          Additionally, there is a simple repeat from measure 2 up to measure 3. In total, we'll be playing 6 measures overall
  *
- *          When the model will be loaded we'll emulate a change notification on the 2-nd measure, so that there will be updated events
- *          on the main stream channel
+ *          When the model will be loaded we'll emulate a change notification on the 2-nd measure, so that only the changed
+ *          ranges of events will be sent on the main stream delta channel
  */
 TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 {
@@ -833,8 +836,10 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
     ON_CALL(*m_repositoryMock, defaultProfile(_)).WillByDefault(Return(m_defaultProfile));
 
-    // [GIVEN] Expected amount of changed events
-    int expectedChangedEventsCount = 24;
+    // [GIVEN] Expected changed ranges: from the 2nd note of the 1st measure up to the 1st note of the 3rd measure (8 notes),
+    //         and the same range inside the repeat, from the 1st note of the repeated 2nd measure (5 notes)
+    size_t expectedChangedRangesCount = 2;
+    size_t expectedChangedEventsCount = 8 + 5;
 
     // [GIVEN] The playback model requested to be loaded
     PlaybackModel model;
@@ -843,10 +848,28 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId());
 
-    // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents, const DynamicLevelLayers&,
-                                                                   const PlaybackParamLayers&) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    // [THEN] The whole track won't be sent
+    result.mainStream.onReceive(this, [](const PlaybackEventsMap&, const DynamicLevelLayers&, const PlaybackParamLayers&, uint64_t) {
+        FAIL();
+    });
+
+    // [THEN] Updated events ranges will match our expectations
+    size_t changedRangesCount = 0;
+    size_t changedEventsCount = 0;
+    PlaybackEventsMap updatedEvents = result.originEvents;
+    uint64_t revision = result.mainStreamRevision;
+    result.mainStreamDelta.onReceive(this, [&](const PlaybackEventsChangesList& changes, const DynamicLevelLayers&,
+                                               const PlaybackParamLayers&, uint64_t deltaRevision) {
+        // [THEN] The delta follows the revision of the data
+        EXPECT_EQ(deltaRevision, revision + 1);
+        revision = deltaRevision;
+
+        applyChanges(updatedEvents, changes);
+
+        changedRangesCount += changes.size();
+        for (const PlaybackEventsChanges& change : changes) {
+            changedEventsCount += change.events.size();
+        }
     });
 
     // [WHEN] Notation has been changed
@@ -858,6 +881,64 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     range.changedTypes = { ElementType::NOTE };
 
     score->changesChannel().send(range);
+
+    EXPECT_EQ(changedRangesCount, expectedChangedRangesCount);
+    EXPECT_EQ(changedEventsCount, expectedChangedEventsCount);
+
+    // [THEN] The previous events with the changes applied are the same as the events of the model
+    EXPECT_EQ(updatedEvents, model.resolveTrackPlaybackData(part->id(), part->instrumentId()).originEvents);
+}
+
+/**
+ * @brief PlaybackModelTests_MainStream_Requested
+ * @details A consumer which has missed a delta requests the whole main stream, which is sent with the next revision
+ */
+TEST_F(Engraving_PlaybackModelTests, MainStream_Requested)
+{
+    // [GIVEN] Simple piece of score (Violin, 4/4, 120 bpm, Treble Cleff)
+    Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "repeat_range/repeat_range.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 1);
+
+    const Part* part = score->parts().at(0);
+    ASSERT_TRUE(part);
+
+    ON_CALL(*m_repositoryMock, defaultProfile(_)).WillByDefault(Return(m_defaultProfile));
+
+    // [GIVEN] The playback model requested to be loaded
+    PlaybackModel model;
+    model.profilesRepository.set(m_repositoryMock);
+    model.load(score);
+
+    PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId());
+
+    // [GIVEN] A delta has been sent before the consumer subscribed
+    ScoreChangesRange range;
+    range.tickFrom = 480;
+    range.tickTo = 3840;
+    range.staffIdxFrom = 0;
+    range.staffIdxTo = 0;
+    range.changedTypes = { ElementType::NOTE };
+
+    score->changesChannel().send(range);
+
+    const PlaybackData& modelData = model.resolveTrackPlaybackData(part->id(), part->instrumentId());
+    ASSERT_EQ(modelData.mainStreamRevision, result.mainStreamRevision + 1);
+
+    // [WHEN] The consumer requests the whole stream
+    size_t receivedCount = 0;
+    result.mainStream.onReceive(this, [&](const PlaybackEventsMap& events, const DynamicLevelLayers&, const PlaybackParamLayers&,
+                                          uint64_t revision) {
+        // [THEN] It receives the current events, with the next revision
+        EXPECT_EQ(revision, result.mainStreamRevision + 2);
+        EXPECT_EQ(events, modelData.originEvents);
+        ++receivedCount;
+    });
+
+    result.mainStreamRequested.notify();
+
+    EXPECT_EQ(receivedCount, 1);
 }
 
 /**
@@ -1256,3 +1337,94 @@ TEST_F(Engraving_PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         }
     }
 }
+
+/**
+ * @brief PlaybackModelTests_Parallel_Load_Same_Events
+ * @details In this case we're loading a score with 12 parts twice: rendering the parts one by one and concurrently.
+ *          Both models must contain exactly the same events
+ */
+TEST_F(Engraving_PlaybackModelTests, Parallel_Load_Same_Events)
+{
+    // [GIVEN] Score with 12 different instruments
+    Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 12);
+
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [WHEN] The playback model is loaded serially
+    PlaybackModel serialModel;
+    serialModel.profilesRepository.set(m_repositoryMock);
+    serialModel.setParallelRenderingEnabled(false);
+    serialModel.load(score);
+
+    // [WHEN] The playback model is loaded in parallel
+    PlaybackModel parallelModel;
+    parallelModel.profilesRepository.set(m_repositoryMock);
+    ASSERT_TRUE(parallelModel.isParallelRenderingEnabled());
+    parallelModel.load(score);
+
+    // [THEN] Both models have the same tracks
+    ASSERT_EQ(serialModel.existingTrackIdSet(), parallelModel.existingTrackIdSet());
+
+    // [THEN] And the same events on every track
+    size_t eventsCount = 0;
+
+    for (const Part* part : score->parts()) {
+        for (const auto& pair : part->instruments()) {
+            const String& instrumentId = pair.second->id();
+
+            const PlaybackEventsMap& serialEvents = serialModel.resolveTrackPlaybackData(part->id(), instrumentId).originEvents;
+            const PlaybackEventsMap& parallelEvents = parallelModel.resolveTrackPlaybackData(part->id(), instrumentId).originEvents;
+
+            EXPECT_EQ(serialEvents, parallelEvents);
+            eventsCount += serialEvents.size();
+        }
+    }
+
+    EXPECT_GT(eventsCount, 0);
+}
+
+/**
+ * @brief PlaybackModelTests_DISABLED_Benchmark_Time_To_First_Playback
+ * @details Measures how long it takes for a large score to become playable, i.e. until the model is loaded
+ *          and notifies about the data, with the parts rendered one by one and concurrently
+ */
+TEST_F(Engraving_PlaybackModelTests, DISABLED_Benchmark_Time_To_First_Playback)
+{
+    using clock = std::chrono::steady_clock;
+    using ms = std::chrono::milliseconds;
+
+    Score* score = ScoreRW::readScore(u"concertpitch_data/concertpitchbenchmark.mscx");
+    ASSERT_TRUE(score);
+
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    constexpr int ITERATIONS = 5;
+
+    for (bool parallel : { false, true }) {
+        clock::duration total = clock::duration::zero();
+
+        for (int i = 0; i < ITERATIONS; ++i) {
+            PlaybackModel model;
+            model.profilesRepository.set(m_repositoryMock);
+            model.setParallelRenderingEnabled(parallel);
+
+            clock::time_point loadStart = clock::now();
+            clock::time_point playable = loadStart;
+
+            model.dataChanged().onNotify(this, [&playable]() {
+                playable = clock::now();
+            });
+
+            model.load(score);
+
+            EXPECT_GT(playable, loadStart);
+            total += playable - loadStart;
+        }
+
+        LOGI() << (parallel ? "parallel" : "serial") << " rendering, parts: " << score->parts().size()
+               << ", time to first playback: " << std::chrono::duration_cast<ms>(total).count() / ITERATIONS << " ms";
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "types/propertyvalue.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_PropertyValueTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_PropertyValueTests, inlineValues)
+{
+    PropertyValue v1(DirectionV::UP);
+    EXPECT_EQ(v1.type(), P_TYPE::DIRECTION_V);
+    EXPECT_TRUE(v1.isEnum());
+    EXPECT_EQ(v1.value<DirectionV>(), DirectionV::UP);
+    EXPECT_EQ(v1.value<int>(), static_cast<int>(DirectionV::UP));
+
+    PropertyValue v2(Fraction(3, 8));
+    EXPECT_FALSE(v2.isEnum());
+    EXPECT_EQ(v2, PropertyValue(Fraction(3, 8)));
+    EXPECT_NE(v2, PropertyValue(Fraction(6, 16)));
+    EXPECT_EQ(v2.value<String>(), String(u"3/8"));
+
+    PropertyValue v3(PointF(1.5, -2.0));
+    PropertyValue v4 = v3;
+    EXPECT_EQ(v4, v3);
+    EXPECT_EQ(v4.value<PointF>(), PointF(1.5, -2.0));
+
+    EXPECT_EQ(PropertyValue(Spatium(2.0)), PropertyValue(2.0));
+    EXPECT_EQ(PropertyValue(1.5).value<Spatium>(), Spatium(1.5));
+    EXPECT_EQ(PropertyValue(true), PropertyValue(1));
+    EXPECT_EQ(PropertyValue(size_t(7)).value<int>(), 7);
+    EXPECT_EQ(PropertyValue(2).value<DirectionV>(), static_cast<DirectionV>(2));
+}
+
+TEST_F(Engraving_PropertyValueTests, sharedValues)
+{
+    PropertyValue v1(String(u"text"));
+    PropertyValue v2(std::vector<int> { 1, 2, 3 });
+
+    PropertyValue v3 = v1;
+    EXPECT_EQ(v3, v1);
+    EXPECT_EQ(v3.value<String>(), String(u"text"));
+
+    v3 = v2;
+    EXPECT_EQ(v3.type(), P_TYPE::INT_VEC);
+    EXPECT_EQ(v3.value<std::vector<int> >(), (std::vector<int> { 1, 2, 3 }));
+    EXPECT_EQ(v1.value<String>(), String(u"text"));
+
+    PropertyValue v4 = std::move(v3);
+    EXPECT_EQ(v4, v2);
+    EXPECT_FALSE(v3.isValid());
+    EXPECT_EQ(v3.value<std::vector<int> >(), std::vector<int>());
+
+    v3 = std::move(v4);
+    EXPECT_EQ(v3, v2);
+    EXPECT_FALSE(v4.isValid());
+    v4 = v3;
+
+    v4 = PropertyValue(Color(255, 0, 0));
+    EXPECT_EQ(v4.value<Color>(), Color(255, 0, 0));
+    EXPECT_NE(v4, v1);
+    EXPECT_FALSE(v4 == PropertyValue());
+}
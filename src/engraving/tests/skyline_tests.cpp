@@ -0,0 +1,248 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+
+#include "io/dir.h"
+
+#include "dom/masterscore.h"
+#include "dom/staff.h"
+#include "dom/system.h"
+#include "infrastructure/skyline.h"
+#include "rendering/dev/systemlayout.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+};
+
+static RectF randomRect(std::mt19937& gen)
+{
+    std::uniform_int_distribution<int> x(0, 2000);
+    std::uniform_int_distribution<int> y(-40, 40);
+    std::uniform_int_distribution<int> size(0, 12);
+
+    // integer coordinates, so that touching and zero-sized elements are common
+    return RectF(x(gen) * 0.5, y(gen) * 0.5, size(gen) * 0.5, size(gen) * 0.5);
+}
+
+//---------------------------------------------------------
+//   minDistanceSameAsShape
+//    The envelope based distance must give exactly the same
+//    result as comparing every pair of shape elements
+//---------------------------------------------------------
+
+TEST_F(Engraving_SkylineTests, minDistanceSameAsShape)
+{
+    std::mt19937 gen(42);
+
+    for (int i = 0; i < 200; ++i) {
+        SkylineLine south(false);
+        SkylineLine north(true);
+
+        Shape southShape;
+        Shape northShape;
+
+        for (int j = 0; j < 100; ++j) {
+            RectF r1 = randomRect(gen);
+            south.add(r1, nullptr);
+            southShape.add(r1);
+
+            RectF r2 = randomRect(gen);
+            north.add(r2, nullptr);
+            northShape.add(r2);
+        }
+
+        for (double clearance : { 0.0, 0.2, 1.0 }) {
+            EXPECT_EQ(south.minDistance(north, clearance), southShape.minVerticalDistance(northShape, clearance));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   minDistanceAfterChange
+//    The envelopes are kept between the queries, every
+//    change of the skyline must be taken into account
+//---------------------------------------------------------
+
+TEST_F(Engraving_SkylineTests, minDistanceAfterChange)
+{
+    std::mt19937 gen(7);
+
+    SkylineLine south(false);
+    SkylineLine north(true);
+
+    Shape southShape;
+    Shape northShape;
+
+    for (int j = 0; j < 100; ++j) {
+        RectF r1 = randomRect(gen);
+        south.add(r1, nullptr);
+        southShape.add(r1);
+
+        RectF r2 = randomRect(gen);
+        north.add(r2, nullptr);
+        northShape.add(r2);
+    }
+
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(northShape, 0.2));
+
+    // the same query again
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(northShape, 0.2));
+
+    // another clearance
+    EXPECT_EQ(south.minDistance(north, 1.0), southShape.minVerticalDistance(northShape, 1.0));
+
+    // a new element
+    RectF deep(500.0, 30.0, 5.0, 10.0);
+    south.add(deep, nullptr);
+    southShape.add(deep);
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(northShape, 0.2));
+
+    // moved
+    north.translateY(5.0);
+    northShape.translateY(5.0);
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(northShape, 0.2));
+
+    // removed
+    south.remove_if([&deep](const ShapeElement& e) { return e == deep; });
+    southShape.remove_if([&deep](const ShapeElement& e) { return e == deep; });
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(northShape, 0.2));
+
+    // changed in place
+    for (ShapeElement& e : north.elements()) {
+        e.translate(0.0, -3.0);
+    }
+    northShape.translateY(-3.0);
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(northShape, 0.2));
+
+    // cleared
+    north.clear();
+    EXPECT_EQ(south.minDistance(north, 0.2), southShape.minVerticalDistance(Shape(), 0.2));
+}
+
+//---------------------------------------------------------
+//   computeSkylineDistancesSameAsSerial
+//    The distances of a big system (24 staves, above the
+//    threshold of the concurrent calculation) must not
+//    depend on which thread calculated them
+//---------------------------------------------------------
+
+TEST_F(Engraving_SkylineTests, computeSkylineDistancesSameAsSerial)
+{
+    static constexpr size_t STAVES_COUNT = 24;
+
+    std::mt19937 gen(3);
+
+    std::vector<Skyline> staves(STAVES_COUNT);
+    for (Skyline& skyline : staves) {
+        for (int j = 0; j < 200; ++j) {
+            skyline.add(randomRect(gen), nullptr);
+        }
+    }
+
+    std::vector<const Skyline*> skylines;
+    for (const Skyline& skyline : staves) {
+        skylines.push_back(&skyline);
+    }
+
+    for (double clearance : { 0.0, 0.2 }) {
+        std::vector<double> serial;
+        for (size_t i = 0; i + 1 < skylines.size(); ++i) {
+            serial.push_back(skylines[i]->minDistance(*skylines[i + 1], clearance));
+        }
+
+        // several times, so that the chunks are taken by different threads
+        for (int run = 0; run < 10; ++run) {
+            EXPECT_EQ(rendering::dev::SystemLayout::computeSkylineDistances(skylines, clearance), serial);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   DISABLED_benchmarkMinDistance
+//    Staff to staff distances of all the vtest scores,
+//    the envelope vs comparing every pair of shape elements
+//---------------------------------------------------------
+
+TEST_F(Engraving_SkylineTests, DISABLED_benchmarkMinDistance)
+{
+    using clock = std::chrono::steady_clock;
+
+    muse::RetVal<muse::io::paths_t> files = muse::io::Dir::scanFiles(VTEST_SCORES_DIR, { "*.mscz", "*.mscx" });
+    ASSERT_TRUE(files.ret);
+
+    clock::duration shapeTime = clock::duration::zero();
+    clock::duration envelopeTime = clock::duration::zero();
+    size_t queries = 0;
+
+    for (const muse::io::path_t& file : files.val) {
+        MasterScore* score = ScoreRW::readScore(file.toString(), true);
+        if (!score) {
+            continue;
+        }
+
+        for (const System* system : score->systems()) {
+            for (size_t staffIdx = 0; staffIdx + 1 < system->staves().size(); ++staffIdx) {
+                const SkylineLine& south = system->staff(staffIdx)->skyline().south();
+                const SkylineLine& north = system->staff(staffIdx + 1)->skyline().north();
+
+                Shape southShape;
+                for (const ShapeElement& e : south.elements()) {
+                    southShape.add(e);
+                }
+                Shape northShape;
+                for (const ShapeElement& e : north.elements()) {
+                    northShape.add(e);
+                }
+
+                clock::time_point t0 = clock::now();
+                double d1 = southShape.minVerticalDistance(northShape, 0.2);
+                clock::time_point t1 = clock::now();
+                double d2 = south.minDistance(north, 0.2);
+                clock::time_point t2 = clock::now();
+
+                EXPECT_EQ(d1, d2);
+
+                shapeTime += t1 - t0;
+                envelopeTime += t2 - t1;
+                ++queries;
+            }
+        }
+
+        delete score;
+    }
+
+    using us = std::chrono::microseconds;
+    LOGI() << "scores: " << files.val.size() << ", queries: " << queries
+           << ", shape: " << std::chrono::duration_cast<us>(shapeTime).count() << " us"
+           << ", skyline: " << std::chrono::duration_cast<us>(envelopeTime).count() << " us";
+}
@@ -27,6 +27,8 @@
 
 using namespace mu::engraving;
 
+std::atomic<uint64_t> PropertyValue::s_heapAllocatedCount = 0;
+
 bool PropertyValue::isValid() const
 {
     return m_type != P_TYPE::UNDEFINED;
@@ -69,17 +71,17 @@ bool PropertyValue::operator ==(const PropertyValue& v) const
         return muse::RealIsEqual(v.value<double>(), value<double>());
     }
 
-    assert(m_data);
-    if (!m_data) {
+    assert(m_ops && data());
+    if (!m_ops || !data()) {
         return false;
     }
 
-    assert(v.m_data);
-    if (!v.m_data) {
+    assert(v.m_ops && v.data());
+    if (!v.m_ops || !v.data()) {
         return false;
     }
 
-    return v.m_type == m_type && v.m_data->equal(m_data.get());
+    return v.m_type == m_type && v.m_ops->typeId == m_ops->typeId && m_ops->equal(data(), v.data());
 }
 
 #ifndef NO_QT_SUPPORT
@@ -22,8 +22,13 @@
 #ifndef MU_ENGRAVING_PROPERTYVALUE_H
 #define MU_ENGRAVING_PROPERTYVALUE_H
 
+#include <atomic>
 #include <memory>
 #include <cassert>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
 
 #ifndef NO_QT_SUPPORT
 #include <QVariant>
@@ -115,182 +120,209 @@ enum class P_TYPE {
 class PropertyValue
 {
 public:
-    PropertyValue() = default;
+    PropertyValue() {}
+
+    PropertyValue(const PropertyValue& other)
+        : m_type(other.m_type) { copyData(other); }
+    PropertyValue(PropertyValue&& other) noexcept
+        : m_type(other.m_type) { moveData(std::move(other)); }
+
+    ~PropertyValue() { clearData(); }
+
+    PropertyValue& operator=(const PropertyValue& other)
+    {
+        if (this != &other) {
+            clearData();
+            m_type = other.m_type;
+            copyData(other);
+        }
+        return *this;
+    }
+
+    PropertyValue& operator=(PropertyValue&& other) noexcept
+    {
+        if (this != &other) {
+            clearData();
+            m_type = other.m_type;
+            moveData(std::move(other));
+        }
+        return *this;
+    }
 
     // Base
     PropertyValue(bool v)
-        : m_type(P_TYPE::BOOL), m_data(make_data<bool>(v)) {}
+        : m_type(P_TYPE::BOOL) { setData<bool>(v); }
 
     PropertyValue(int v)
-        : m_type(P_TYPE::INT), m_data(make_data<int>(v)) {}
+        : m_type(P_TYPE::INT) { setData<int>(v); }
 
     PropertyValue(const std::vector<int>& v)
-        : m_type(P_TYPE::INT_VEC), m_data(make_data<std::vector<int> >(v)) {}
+        : m_type(P_TYPE::INT_VEC) { setData<std::vector<int> >(v); }
 
     PropertyValue(size_t v)
-        : m_type(P_TYPE::SIZE_T), m_data(make_data<size_t>(v)) {}
+        : m_type(P_TYPE::SIZE_T) { setData<size_t>(v); }
 
     PropertyValue(double v)
-        : m_type(P_TYPE::REAL), m_data(make_data<double>(v)) {}
+        : m_type(P_TYPE::REAL) { setData<double>(v); }
 
     PropertyValue(const char* v)
-        : m_type(P_TYPE::STRING), m_data(make_data<String>(String::fromUtf8(v))) {}
+        : m_type(P_TYPE::STRING) { setData<String>(String::fromUtf8(v)); }
 
     PropertyValue(const String& v)
-        : m_type(P_TYPE::STRING), m_data(make_data<String>(v)) {}
+        : m_type(P_TYPE::STRING) { setData<String>(v); }
 
 #ifndef NO_QT_SUPPORT
     PropertyValue(const QString& v)
-        : m_type(P_TYPE::STRING), m_data(make_data<String>(String::fromQString(v))) {}
+        : m_type(P_TYPE::STRING) { setData<String>(String::fromQString(v)); }
 #endif
 
     // Geometry
     PropertyValue(const PointF& v)
-        : m_type(P_TYPE::POINT), m_data(make_data<PointF>(v)) {}
+        : m_type(P_TYPE::POINT) { setData<PointF>(v); }
 
     PropertyValue(const PairF& v)
-        : m_type(P_TYPE::PAIR_REAL), m_data(make_data<PairF>(v)) {}
+        : m_type(P_TYPE::PAIR_REAL) { setData<PairF>(v); }
 
     PropertyValue(const SizeF& v)
-        : m_type(P_TYPE::SIZE), m_data(make_data<SizeF>(v)) {}
+        : m_type(P_TYPE::SIZE) { setData<SizeF>(v); }
 
     PropertyValue(const PainterPath& v)
-        : m_type(P_TYPE::DRAW_PATH), m_data(make_data<PainterPath>(v)) {}
+        : m_type(P_TYPE::DRAW_PATH) { setData<PainterPath>(v); }
 
     PropertyValue(const ScaleF& v)
-        : m_type(P_TYPE::SCALE), m_data(make_data<ScaleF>(v)) {}
+        : m_type(P_TYPE::SCALE) { setData<ScaleF>(v); }
 
     PropertyValue(const Spatium& v)
-        : m_type(P_TYPE::SPATIUM), m_data(make_data<Spatium>(v)) {}
+        : m_type(P_TYPE::SPATIUM) { setData<Spatium>(v); }
 
     PropertyValue(const Millimetre& v)
-        : m_type(P_TYPE::MILLIMETRE), m_data(make_data<Millimetre>(v)) {}
+        : m_type(P_TYPE::MILLIMETRE) { setData<Millimetre>(v); }
 
     // Draw
     PropertyValue(SymId v)
-        : m_type(P_TYPE::SYMID), m_data(make_data<SymId>(v)) {}
+        : m_type(P_TYPE::SYMID) { setData<SymId>(v); }
 
     PropertyValue(const Color& v)
-        : m_type(P_TYPE::COLOR), m_data(make_data<Color>(v)) {}
+        : m_type(P_TYPE::COLOR) { setData<Color>(v); }
 
     PropertyValue(OrnamentStyle v)
-        : m_type(P_TYPE::ORNAMENT_STYLE), m_data(make_data<OrnamentStyle>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_STYLE) { setData<OrnamentStyle>(v); }
 
     PropertyValue(GlissandoStyle v)
-        : m_type(P_TYPE::GLISS_STYLE), m_data(make_data<GlissandoStyle>(v)) {}
+        : m_type(P_TYPE::GLISS_STYLE) { setData<GlissandoStyle>(v); }
 
     // Layout
     PropertyValue(Align v)
-        : m_type(P_TYPE::ALIGN), m_data(make_data<Align>(v)) {}
+        : m_type(P_TYPE::ALIGN) { setData<Align>(v); }
 
     PropertyValue(PlacementV v)
-        : m_type(P_TYPE::PLACEMENT_V), m_data(make_data<PlacementV>(v)) {}
+        : m_type(P_TYPE::PLACEMENT_V) { setData<PlacementV>(v); }
     PropertyValue(PlacementH v)
-        : m_type(P_TYPE::PLACEMENT_H), m_data(make_data<PlacementH>(v)) {}
+        : m_type(P_TYPE::PLACEMENT_H) { setData<PlacementH>(v); }
 
     PropertyValue(TextPlace v)
-        : m_type(P_TYPE::TEXT_PLACE), m_data(make_data<TextPlace>(v)) {}
+        : m_type(P_TYPE::TEXT_PLACE) { setData<TextPlace>(v); }
 
     PropertyValue(DirectionV v)
-        : m_type(P_TYPE::DIRECTION_V), m_data(make_data<DirectionV>(v)) {}
+        : m_type(P_TYPE::DIRECTION_V) { setData<DirectionV>(v); }
     PropertyValue(DirectionH v)
-        : m_type(P_TYPE::DIRECTION_H), m_data(make_data<DirectionH>(v)) {}
+        : m_type(P_TYPE::DIRECTION_H) { setData<DirectionH>(v); }
 
     PropertyValue(Orientation v)
-        : m_type(P_TYPE::ORIENTATION), m_data(make_data<Orientation>(v)) {}
+        : m_type(P_TYPE::ORIENTATION) { setData<Orientation>(v); }
 
     PropertyValue(BeamMode v)
-        : m_type(P_TYPE::BEAM_MODE), m_data(make_data<BeamMode>(v)) {}
+        : m_type(P_TYPE::BEAM_MODE) { setData<BeamMode>(v); }
 
     PropertyValue(const AccidentalRole& v)
-        : m_type(P_TYPE::ACCIDENTAL_ROLE), m_data(make_data<AccidentalRole>(v)) {}
+        : m_type(P_TYPE::ACCIDENTAL_ROLE) { setData<AccidentalRole>(v); }
 
     PropertyValue(TiePlacement v)
-        : m_type(P_TYPE::TIE_PLACEMENT), m_data(make_data<TiePlacement>(v)) {}
+        : m_type(P_TYPE::TIE_PLACEMENT) { setData<TiePlacement>(v); }
 
     // Sound
     PropertyValue(const Fraction& v)
-        : m_type(P_TYPE::FRACTION), m_data(make_data<Fraction>(v)) {}
+        : m_type(P_TYPE::FRACTION) { setData<Fraction>(v); }
     PropertyValue(const DurationTypeWithDots& v)
-        : m_type(P_TYPE::DURATION_TYPE_WITH_DOTS), m_data(make_data<DurationTypeWithDots>(v)) {}
+        : m_type(P_TYPE::DURATION_TYPE_WITH_DOTS) { setData<DurationTypeWithDots>(v); }
     PropertyValue(ChangeMethod v)
-        : m_type(P_TYPE::CHANGE_METHOD), m_data(make_data<ChangeMethod>(v)) {}
+        : m_type(P_TYPE::CHANGE_METHOD) { setData<ChangeMethod>(v); }
     PropertyValue(const PitchValues& v)
-        : m_type(P_TYPE::PITCH_VALUES), m_data(make_data<PitchValues>(v)) {}
+        : m_type(P_TYPE::PITCH_VALUES) { setData<PitchValues>(v); }
     PropertyValue(const BeatsPerSecond& v)
-        : m_type(P_TYPE::TEMPO), m_data(make_data<BeatsPerSecond>(v)) {}
+        : m_type(P_TYPE::TEMPO) { setData<BeatsPerSecond>(v); }
 
     // Types
     PropertyValue(LayoutBreakType v)
-        : m_type(P_TYPE::LAYOUTBREAK_TYPE), m_data(make_data<LayoutBreakType>(v)) {}
+        : m_type(P_TYPE::LAYOUTBREAK_TYPE) { setData<LayoutBreakType>(v); }
 
     PropertyValue(VeloType v)
-        : m_type(P_TYPE::VELO_TYPE), m_data(make_data<VeloType>(v)) {}
+        : m_type(P_TYPE::VELO_TYPE) { setData<VeloType>(v); }
 
     PropertyValue(BarLineType v)
-        : m_type(P_TYPE::BARLINE_TYPE), m_data(make_data<BarLineType>(v)) {}
+        : m_type(P_TYPE::BARLINE_TYPE) { setData<BarLineType>(v); }
 
     PropertyValue(NoteHeadType v)
-        : m_type(P_TYPE::NOTEHEAD_TYPE), m_data(make_data<NoteHeadType>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_TYPE) { setData<NoteHeadType>(v); }
     PropertyValue(NoteHeadScheme v)
-        : m_type(P_TYPE::NOTEHEAD_SCHEME), m_data(make_data<NoteHeadScheme>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_SCHEME) { setData<NoteHeadScheme>(v); }
     PropertyValue(NoteHeadGroup v)
-        : m_type(P_TYPE::NOTEHEAD_GROUP), m_data(make_data<NoteHeadGroup>(v)) {}
+        : m_type(P_TYPE::NOTEHEAD_GROUP) { setData<NoteHeadGroup>(v); }
 
     PropertyValue(ClefType v)
-        : m_type(P_TYPE::CLEF_TYPE), m_data(make_data<ClefType>(v)) {}
+        : m_type(P_TYPE::CLEF_TYPE) { setData<ClefType>(v); }
 
     PropertyValue(ClefToBarlinePosition v)
-        : m_type(P_TYPE::CLEF_TO_BARLINE_POS), m_data(make_data<ClefToBarlinePosition>(v)) {}
+        : m_type(P_TYPE::CLEF_TO_BARLINE_POS) { setData<ClefToBarlinePosition>(v); }
 
     PropertyValue(DynamicType v)
-        : m_type(P_TYPE::DYNAMIC_TYPE), m_data(make_data<DynamicType>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_TYPE) { setData<DynamicType>(v); }
     PropertyValue(DynamicSpeed v)
-        : m_type(P_TYPE::DYNAMIC_SPEED), m_data(make_data<DynamicSpeed>(v)) {}
+        : m_type(P_TYPE::DYNAMIC_SPEED) { setData<DynamicSpeed>(v); }
 
     PropertyValue(LineType v)
-        : m_type(P_TYPE::LINE_TYPE), m_data(make_data<LineType>(v)) {}
+        : m_type(P_TYPE::LINE_TYPE) { setData<LineType>(v); }
     PropertyValue(HookType v)
-        : m_type(P_TYPE::HOOK_TYPE), m_data(make_data<HookType>(v)) {}
+        : m_type(P_TYPE::HOOK_TYPE) { setData<HookType>(v); }
 
     PropertyValue(KeyMode v)
-        : m_type(P_TYPE::KEY_MODE), m_data(make_data<KeyMode>(v)) {}
+        : m_type(P_TYPE::KEY_MODE) { setData<KeyMode>(v); }
 
     PropertyValue(TextStyleType v)
-        : m_type(P_TYPE::TEXT_STYLE), m_data(make_data<TextStyleType>(v)) {}
+        : m_type(P_TYPE::TEXT_STYLE) { setData<TextStyleType>(v); }
 
     PropertyValue(PlayingTechniqueType v)
-        : m_type(P_TYPE::PLAYTECH_TYPE), m_data(make_data<PlayingTechniqueType>(v)) {}
+        : m_type(P_TYPE::PLAYTECH_TYPE) { setData<PlayingTechniqueType>(v); }
 
     PropertyValue(GradualTempoChangeType v)
-        : m_type(P_TYPE::TEMPOCHANGE_TYPE), m_data(make_data<GradualTempoChangeType>(v)) {}
+        : m_type(P_TYPE::TEMPOCHANGE_TYPE) { setData<GradualTempoChangeType>(v); }
 
     PropertyValue(SlurStyleType v)
-        : m_type(P_TYPE::SLUR_STYLE_TYPE), m_data(make_data<SlurStyleType>(v)) {}
+        : m_type(P_TYPE::SLUR_STYLE_TYPE) { setData<SlurStyleType>(v); }
 
     // Other
     PropertyValue(const GroupNodes& v)
-        : m_type(P_TYPE::GROUPS), m_data(make_data<GroupNodes>(v)) {}
+        : m_type(P_TYPE::GROUPS) { setData<GroupNodes>(v); }
 
     PropertyValue(const OrnamentInterval& v)
-        : m_type(P_TYPE::ORNAMENT_INTERVAL), m_data(make_data<OrnamentInterval>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_INTERVAL) { setData<OrnamentInterval>(v); }
 
     PropertyValue(const OrnamentShowAccidental& v)
-        : m_type(P_TYPE::ORNAMENT_SHOW_ACCIDENTAL), m_data(make_data<OrnamentShowAccidental>(v)) {}
+        : m_type(P_TYPE::ORNAMENT_SHOW_ACCIDENTAL) { setData<OrnamentShowAccidental>(v); }
 
     PropertyValue(const LyricsDashSystemStart& v)
-        : m_type(P_TYPE::LYRICS_DASH_SYSTEM_START_TYPE), m_data(make_data<LyricsDashSystemStart>(v)) {}
+        : m_type(P_TYPE::LYRICS_DASH_SYSTEM_START_TYPE) { setData<LyricsDashSystemStart>(v); }
 
     PropertyValue(const VoiceAssignment& v)
-        : m_type(P_TYPE::VOICE_ASSIGNMENT), m_data(make_data<VoiceAssignment>(v)) {}
+        : m_type(P_TYPE::VOICE_ASSIGNMENT) { setData<VoiceAssignment>(v); }
 
     PropertyValue(const AutoOnOff& v)
-        : m_type(P_TYPE::AUTO_ON_OFF), m_data(make_data<AutoOnOff>(v)) {}
+        : m_type(P_TYPE::AUTO_ON_OFF) { setData<AutoOnOff>(v); }
 
     bool isValid() const;
 
     P_TYPE type() const;
-    bool isEnum() const { return m_data ? m_data->isEnum() : false; }
+    bool isEnum() const { return m_ops ? m_ops->enumToInt != nullptr : false; }
 
     template<typename T>
     T value() const
@@ -299,12 +331,12 @@ public:
             return T();
         }
 
-        assert(m_data);
-        if (!m_data) {
+        assert(m_ops);
+        if (!m_ops) {
             return T();
         }
 
-        Arg<T>* at = get<T>();
+        const T* at = get<T>();
         if (!at) {
             //! HACK Temporary hack for int to enum
             if constexpr (std::is_enum<T>::value) {
@@ -315,8 +347,8 @@ public:
 
             //! HACK Temporary hack for enum to int
             if constexpr (std::is_same<T, int>::value) {
-                if (m_data->isEnum()) {
-                    return m_data->enumToInt();
+                if (isEnum()) {
+                    return m_ops->enumToInt(data());
                 }
             }
 
@@ -342,9 +374,9 @@ public:
             //! HACK Temporary hack for real to Spatium
             if constexpr (std::is_same<T, Spatium>::value) {
                 if (P_TYPE::REAL == m_type) {
-                    Arg<double>* srv = get<double>();
+                    const double* srv = get<double>();
                     assert(srv);
-                    return srv ? Spatium(srv->v) : Spatium();
+                    return srv ? Spatium(*srv) : Spatium();
                 }
             }
 
@@ -358,9 +390,9 @@ public:
             //! HACK Temporary hack for real to Millimetre
             if constexpr (std::is_same<T, Millimetre>::value) {
                 if (P_TYPE::REAL == m_type) {
-                    Arg<double>* mrv = get<double>();
+                    const double* mrv = get<double>();
                     assert(mrv);
-                    return mrv ? Millimetre(mrv->v) : Millimetre();
+                    return mrv ? Millimetre(*mrv) : Millimetre();
                 }
             }
 
@@ -397,7 +429,7 @@ public:
         if (!at) {
             return T();
         }
-        return at->v;
+        return *at;
     }
 
     bool toBool() const { return value<bool>(); }
@@ -411,6 +443,9 @@ public:
     template<typename T>
     static PropertyValue fromValue(const T& v) { return PropertyValue(v); }
 
+    //! NOTE The number of values allocated on the heap since the start (for benchmarks)
+    static uint64_t heapAllocatedCount() { return s_heapAllocatedCount.load(std::memory_order_relaxed); }
+
 #ifndef NO_QT_SUPPORT
     //! NOTE compat
     QVariant toQVariant() const;
@@ -418,59 +453,130 @@ public:
 #endif
 
 private:
-    struct IArg {
-        virtual ~IArg() = default;
+    //! NOTE Small trivially copyable values (numbers, enums, points, colors, fractions...) are stored inline,
+    //! so creating and copying them doesn't allocate. Other values (strings, paths, vectors...) are immutable
+    //! once set, so they are shared between copies
+    static constexpr size_t INLINE_SIZE = 16;
 
-        virtual bool equal(const IArg* a) const = 0;
-
-        virtual bool isEnum() const = 0;
-        virtual int enumToInt() const = 0;
-    };
+    static std::atomic<uint64_t> s_heapAllocatedCount;
 
     template<typename T>
-    struct Arg : public IArg {
-        T v;
-        Arg(const T& v)
-            : IArg(), v(v) {}
+    static constexpr bool isInline = sizeof(T) <= INLINE_SIZE
+                                     && alignof(T) <= alignof(double)
+                                     && std::is_trivially_copy_constructible<T>::value
+                                     && std::is_trivially_destructible<T>::value;
 
-        bool equal(const IArg* a) const override
-        {
-            assert(a);
-            const Arg<T>* at = dynamic_cast<const Arg<T>*>(a);
-            assert(at);
-            return at ? at->v == v : false;
+    //! NOTE Identifies a type by its name, so it is the same in all the libraries
+    //! (unlike the address of a static table, which each library may have its own copy of)
+    template<typename T>
+    static constexpr uint64_t typeId()
+    {
+#ifdef _MSC_VER
+        constexpr std::string_view sig = __FUNCSIG__;
+#else
+        constexpr std::string_view sig = __PRETTY_FUNCTION__;
+#endif
+        uint64_t h = 14695981039346656037ull; // FNV-1a
+        for (char c : sig) {
+            h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
         }
+        return h;
+    }
 
-        //! HACK Temporary hack for enum to int
-        bool isEnum() const override
+    struct TypeOps {
+        uint64_t typeId = 0;
+        bool isInline = false;
+        bool (*equal)(const void* a, const void* b) = nullptr;
+        //! HACK Temporary hack for enum to int (nullptr if the type is not an enum)
+        int (*enumToInt)(const void* v) = nullptr;
+    };
+
+    template<typename T>
+    struct TypeOpsOf {
+        static bool equal(const void* a, const void* b)
         {
-            return std::is_enum<T>::value;
+            return *static_cast<const T*>(a) == *static_cast<const T*>(b);
         }
 
-        int enumToInt() const override
+        static int enumToInt(const void* v)
         {
             if constexpr (std::is_enum<T>::value) {
-                return static_cast<int>(v);
+                return static_cast<int>(*static_cast<const T*>(v));
             } else {
                 return -1;
             }
         }
+
+        static constexpr TypeOps ops { typeId<T>(), isInline<T>, &equal, std::is_enum<T>::value ? &enumToInt : nullptr };
     };
 
     template<typename T>
-    inline std::shared_ptr<IArg> make_data(const T& v) const
+    inline void setData(const T& v)
     {
-        return std::shared_ptr<IArg>(new Arg<T>(v));
+        m_ops = &TypeOpsOf<T>::ops;
+        if constexpr (isInline<T>) {
+            new (m_buffer) T(v);
+        } else {
+            new (&m_heap) std::shared_ptr<const void>(std::make_shared<T>(v));
+            s_heapAllocatedCount.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
     template<typename T>
-    inline Arg<T>* get() const
+    inline const T* get() const
+    {
+        if (!m_ops || m_ops->typeId != typeId<T>()) {
+            return nullptr;
+        }
+
+        if constexpr (isInline<T>) {
+            return std::launder(reinterpret_cast<const T*>(m_buffer));
+        } else {
+            return static_cast<const T*>(m_heap.get());
+        }
+    }
+
+    inline bool hasHeapData() const { return m_ops && !m_ops->isInline; }
+    inline const void* data() const { return hasHeapData() ? m_heap.get() : m_buffer; }
+
+    inline void copyData(const PropertyValue& other)
+    {
+        m_ops = other.m_ops;
+        if (other.hasHeapData()) {
+            new (&m_heap) std::shared_ptr<const void>(other.m_heap);
+        } else {
+            std::memcpy(m_buffer, other.m_buffer, INLINE_SIZE);
+        }
+    }
+
+    inline void moveData(PropertyValue&& other)
+    {
+        m_ops = other.m_ops;
+        if (other.hasHeapData()) {
+            new (&m_heap) std::shared_ptr<const void>(std::move(other.m_heap));
+        } else {
+            std::memcpy(m_buffer, other.m_buffer, INLINE_SIZE);
+        }
+
+        //! NOTE The moved from value becomes undefined
+        other.clearData();
+        other.m_type = P_TYPE::UNDEFINED;
+    }
+
+    inline void clearData()
     {
-        return dynamic_cast<Arg<T>*>(m_data.get());
+        if (hasHeapData()) {
+            m_heap.~shared_ptr();
+        }
+        m_ops = nullptr;
     }
 
     P_TYPE m_type = P_TYPE::UNDEFINED;
-    std::shared_ptr<IArg> m_data = nullptr;
+    const TypeOps* m_ops = nullptr;
+    union {
+        alignas(double) unsigned char m_buffer[INLINE_SIZE] = {};
+        std::shared_ptr<const void> m_heap;
+    };
 };
 }
 
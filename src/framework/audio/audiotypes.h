@@ -23,6 +23,7 @@
 #ifndef MUSE_AUDIO_AUDIOTYPES_H
 #define MUSE_AUDIO_AUDIOTYPES_H
 
+#include <map>
 #include <variant>
 #include <set>
 #include <string>
@@ -432,6 +433,35 @@ enum class RenderMode {
     IdleMode,
     OfflineMode
 };
+
+struct MixerBenchmarkParams {
+    size_t tracksCount = 64;
+    samples_t samplesPerChannel = 512;
+    size_t blocksCount = 2000;
+};
+
+struct MixerBenchmarkResult {
+    MixerBenchmarkParams params;
+    double blockBudgetMsecs = 0.0; // the time for which a block is played back
+    double avgBlockMsecs = 0.0;
+    double worstBlockMsecs = 0.0;
+    size_t overrunsCount = 0; // blocks that took longer than the budget
+};
+
+using StemDestinations = std::map<TrackId, io::path_t>;
+
+struct SoundTrackStemStats {
+    TrackId trackId = -1;
+    double processingMsecs = 0.0; // the time spent on rendering the track
+    double realtimeFactor = 0.0; // how many times faster than playback the track was rendered
+};
+
+struct SoundTrackStemsResult {
+    double durationMsecs = 0.0; // the duration of the rendered audio
+    double totalMsecs = 0.0; // the time spent on rendering and encoding all the files
+    double realtimeFactor = 0.0;
+    std::vector<SoundTrackStemStats> stems;
+};
 }
 
 #endif // MUSE_AUDIO_AUDIOTYPES_H
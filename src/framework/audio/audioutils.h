@@ -23,6 +23,11 @@
 #ifndef MUSE_AUDIO_AUDIOUTILS_H
 #define MUSE_AUDIO_AUDIOUTILS_H
 
+#include <set>
+
+#include "global/containers.h"
+#include "global/io/path.h"
+
 #include "audiotypes.h"
 #include "soundfonttypes.h"
 
@@ -71,6 +76,30 @@ inline String audioSourceCategoryName(const AudioInputParams& params)
 
     return String::fromStdString(params.resourceMeta.id);
 }
+
+//! NOTE Every stem is written next to the master mix, as <master name>-<track name>.<suffix>
+inline StemDestinations makeStemDestinations(const io::path_t& destination, const std::map<TrackId, std::string>& trackNames)
+{
+    const io::path_t basePath = io::dirpath(destination) + "/" + io::completeBasename(destination);
+    const io::path_t suffix = "." + io::path_t(io::suffix(destination));
+
+    StemDestinations result;
+    std::set<io::path_t> usedPaths { destination };
+
+    for (const auto& pair : trackNames) {
+        const io::path_t name = basePath + "-" + io::escapeFileName(pair.second);
+
+        io::path_t path = name + suffix;
+        for (int i = 2; muse::contains(usedPaths, path); ++i) {
+            path = name + "-" + io::path_t(std::to_string(i)) + suffix;
+        }
+
+        usedPaths.insert(path);
+        result.emplace(pair.first, path);
+    }
+
+    return result;
+}
 }
 
 #endif // MUSE_AUDIO_AUDIOUTILS_H
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mixerbenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "../internal/audiosanitizer.h"
+#include "../internal/worker/mixer.h"
+#include "../internal/worker/eventaudiosource.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+static mpe::PlaybackData makePlaybackData(size_t trackIdx, mpe::duration_t totalDuration)
+{
+    static constexpr mpe::duration_t NOTE_DURATION = 125000; // 16th at 120 bpm
+    static constexpr int CHORD_SIZE = 3;
+
+    mpe::PlaybackData data;
+    data.setupData = mpe::PlaybackSetupData(mpe::SoundId::Piano, mpe::SoundCategory::Keyboards);
+
+    const mpe::dynamic_level_t dynamic = mpe::dynamicLevelFromType(mpe::DynamicType::f);
+
+    for (mpe::timestamp_t timestamp = 0; timestamp < totalDuration; timestamp += NOTE_DURATION) {
+        mpe::PlaybackEventList& events = data.originEvents[timestamp];
+
+        for (int i = 0; i < CHORD_SIZE; ++i) {
+            //! NOTE Different pitches on every track, so that the voices don't simply double each other
+            const mpe::octave_t octave = static_cast<mpe::octave_t>(2 + (trackIdx + i) % 5);
+            const mpe::PitchClass pitchClass = static_cast<mpe::PitchClass>((trackIdx * 5 + i * 4) % 12);
+
+            events.emplace_back(mpe::NoteEvent(timestamp, NOTE_DURATION, 0, 0, mpe::pitchLevel(pitchClass, octave),
+                                               dynamic, mpe::ArticulationMap(), 2.0));
+        }
+    }
+
+    return data;
+}
+
+MixerBenchmark::MixerBenchmark(const modularity::ContextPtr& iocCtx)
+    : Injectable(iocCtx)
+{
+}
+
+MixerBenchmarkResult MixerBenchmark::run(const MixerBenchmarkParams& params)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    MixerBenchmarkResult result;
+    result.params = params;
+
+    if (params.tracksCount == 0 || params.samplesPerChannel == 0 || params.blocksCount == 0) {
+        return result;
+    }
+
+    const unsigned int sampleRate = configuration()->sampleRate();
+    const audioch_t audioChannelsCount = configuration()->audioChannelsCount();
+
+    const double blockBudgetMsecs = 1000.0 * params.samplesPerChannel / sampleRate;
+    const mpe::duration_t totalDuration = static_cast<mpe::duration_t>(blockBudgetMsecs * 1000.0 * params.blocksCount);
+
+    auto mixer = std::make_shared<Mixer>(iocContext());
+    mixer->setAudioChannelsCount(audioChannelsCount);
+    mixer->setSampleRate(sampleRate);
+
+    const AudioInputParams inputParams = synthResolver()->resolveDefaultInputParams();
+
+    std::vector<ITrackAudioInputPtr> sources;
+    sources.reserve(params.tracksCount);
+
+    for (size_t i = 0; i < params.tracksCount; ++i) {
+        const TrackId trackId = static_cast<TrackId>(i);
+
+        auto source = std::make_shared<EventAudioSource>(trackId, makePlaybackData(i, totalDuration), [](const TrackId) {},
+                                                         iocContext());
+        mixer->addChannel(trackId, source);
+        source->applyInputParams(inputParams);
+
+        sources.push_back(source);
+    }
+
+    mixer->setIsActive(true);
+
+    for (const ITrackAudioInputPtr& source : sources) {
+        source->seek(0);
+    }
+
+    std::vector<float> buffer(params.samplesPerChannel * audioChannelsCount, 0.f);
+
+    double totalMsecs = 0.0;
+
+    for (size_t block = 0; block < params.blocksCount; ++block) {
+        auto start = std::chrono::steady_clock::now();
+        mixer->process(buffer.data(), params.samplesPerChannel);
+        auto end = std::chrono::steady_clock::now();
+
+        const double blockMsecs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        totalMsecs += blockMsecs;
+        result.worstBlockMsecs = std::max(result.worstBlockMsecs, blockMsecs);
+
+        if (blockMsecs > blockBudgetMsecs) {
+            ++result.overrunsCount;
+        }
+    }
+
+    mixer->setIsActive(false);
+
+    result.blockBudgetMsecs = blockBudgetMsecs;
+    result.avgBlockMsecs = totalMsecs / params.blocksCount;
+
+    return result;
+}
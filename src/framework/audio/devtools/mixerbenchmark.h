@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_MIXERBENCHMARK_H
+#define MUSE_AUDIO_MIXERBENCHMARK_H
+
+#include "global/modularity/ioc.h"
+
+#include "../isynthresolver.h"
+#include "../iaudioconfiguration.h"
+#include "../audiotypes.h"
+
+namespace muse::audio {
+//! NOTE Renders the given number of FluidSynth tracks through a separate mixer,
+//! block by block, and measures how long every block takes compared to its playback time
+class MixerBenchmark : public Injectable
+{
+    Inject<synth::ISynthResolver> synthResolver = { this };
+    Inject<IAudioConfiguration> configuration = { this };
+
+public:
+    MixerBenchmark(const modularity::ContextPtr& iocCtx);
+
+    MixerBenchmarkResult run(const MixerBenchmarkParams& params);
+};
+}
+
+#endif // MUSE_AUDIO_MIXERBENCHMARK_H
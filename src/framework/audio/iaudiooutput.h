@@ -53,11 +53,19 @@ public:
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+
+    //! NOTE Renders the sequence once and writes the master mix along with the output of every given track (stem)
+    virtual async::Promise<SoundTrackStemsResult> saveSoundTrackStems(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                                      const StemDestinations& stemDestinations,
+                                                                      const SoundTrackFormat& format) = 0;
     virtual void abortSavingAllSoundTracks() = 0;
 
     virtual Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) = 0;
 
     virtual void clearAllFx() = 0;
+
+    //! NOTE For diagnostics: renders synthetic tracks through a separate mixer and measures the block times
+    virtual async::Promise<MixerBenchmarkResult> runMixerBenchmark(const MixerBenchmarkParams& params) = 0;
 };
 
 using IAudioOutputPtr = std::shared_ptr<IAudioOutput>;
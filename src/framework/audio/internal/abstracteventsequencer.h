@@ -47,6 +47,7 @@ public:
     virtual ~AbstractEventSequencer()
     {
         m_playbackData.mainStream.resetOnReceive(this);
+        m_playbackData.mainStreamDelta.resetOnReceive(this);
         m_playbackData.offStream.resetOnReceive(this);
     }
 
@@ -56,12 +57,17 @@ public:
 
         m_playbackData = data;
 
+        m_isMainStreamRequested = false;
+
         m_playbackData.mainStream.onReceive(this, [this](const mpe::PlaybackEventsMap& events,
                                                          const mpe::DynamicLevelLayers& dynamics,
-                                                         const mpe::PlaybackParamLayers& params) {
+                                                         const mpe::PlaybackParamLayers& params,
+                                                         uint64_t revision) {
             m_playbackData.originEvents = events;
             m_playbackData.dynamics = dynamics;
             m_playbackData.params = params;
+            m_playbackData.mainStreamRevision = revision;
+            m_isMainStreamRequested = false;
             m_shouldUpdateMainStreamEvents = true;
 
             if (m_isActive) {
@@ -69,6 +75,38 @@ public:
             }
         });
 
+        m_playbackData.mainStreamDelta.onReceive(this, [this](const mpe::PlaybackEventsChangesList& changes,
+                                                              const mpe::DynamicLevelLayers& dynamics,
+                                                              const mpe::PlaybackParamLayers& params,
+                                                              uint64_t revision) {
+            if (revision <= m_playbackData.mainStreamRevision) {
+                return;
+            }
+
+            //! NOTE A delta has been missed (e.g. sent between the copy of the data and load()),
+            //! the events can't be patched, so wait for the whole stream
+            if (revision != m_playbackData.mainStreamRevision + 1) {
+                if (!m_isMainStreamRequested) {
+                    m_isMainStreamRequested = true;
+                    m_playbackData.mainStreamRequested.notify();
+                }
+                return;
+            }
+
+            m_playbackData.mainStreamRevision = revision;
+            m_playbackData.dynamics = dynamics;
+            m_playbackData.params = params;
+
+            //! NOTE If the whole stream is going to be rebuilt anyway, just keep the events up to date
+            if (!m_isActive || m_shouldUpdateMainStreamEvents) {
+                mpe::applyChanges(m_playbackData.originEvents, changes);
+                m_shouldUpdateMainStreamEvents = true;
+                return;
+            }
+
+            applyMainStreamChanges(changes);
+        });
+
         m_playbackData.offStream.onReceive(this, [this](const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) {
             updateOffStreamEvents(events, params);
         });
@@ -183,6 +221,14 @@ protected:
     virtual void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                         const mpe::PlaybackParamLayers& params) = 0;
 
+    //! NOTE The dynamics and params are already updated. By default, the main stream is rebuilt;
+    //! the sequencers able to update only the changed ranges reimplement this
+    virtual void applyMainStreamChanges(const mpe::PlaybackEventsChangesList& changes)
+    {
+        mpe::applyChanges(m_playbackData.originEvents, changes);
+        updateMainStreamEvents(m_playbackData.originEvents, m_playbackData.dynamics, m_playbackData.params);
+    }
+
     void resetAllIterators()
     {
         updateMainSequenceIterator();
@@ -270,6 +316,7 @@ protected:
 
 private:
     bool m_shouldUpdateMainStreamEvents = false;
+    bool m_isMainStreamRequested = false;
 };
 }
 
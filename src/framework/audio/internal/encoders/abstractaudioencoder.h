@@ -27,12 +27,13 @@
 #include <vector>
 #include <memory>
 
-#include "global/progress.h"
 #include "global/io/path.h"
 
 #include "audiotypes.h"
 
 namespace muse::audio::encode {
+//! NOTE The track is encoded in chunks as it is rendered: encode() is called repeatedly
+//! and writes every chunk to the destination, so the whole track is never kept in memory
 class AbstractAudioEncoder
 {
 public:
@@ -40,7 +41,7 @@ public:
 
     virtual ~AbstractAudioEncoder() = default;
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t /*totalSamplesPerChannel*/)
     {
         if (!format.isValid()) {
             return false;
@@ -48,13 +49,7 @@ public:
 
         m_format = format;
 
-        if (!openDestination(path)) {
-            return false;
-        }
-
-        prepareOutputBuffer(totalSamplesNumber);
-
-        return true;
+        return openDestination(path);
     }
 
     void deinit()
@@ -70,13 +65,8 @@ public:
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
-    Progress progress()
-    {
-        return m_progress;
-    }
-
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual void prepareWriting()
     {
@@ -107,9 +97,13 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    //! NOTE The chunks are of the same size, so the buffer is only allocated for the first one
+    void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        const size_t requiredSize = requiredOutputBufferSize(samplesPerChannel);
+        if (m_outputBuffer.size() < requiredSize) {
+            m_outputBuffer.resize(requiredSize);
+        }
     }
 
     virtual void closeDestination()
@@ -125,7 +119,6 @@ protected:
     std::vector<unsigned char> m_outputBuffer;
 
     SoundTrackFormat m_format;
-    Progress m_progress;
 
     std::string m_locale;
 };
@@ -33,28 +33,9 @@ using namespace muse::audio::encode;
 
 struct FlacHandler : public FLAC::Encoder::File
 {
-    using ProgressCallBack = std::function<void (int64_t /*current*/, int64_t /*total*/)>;
-
-    FlacHandler(const ProgressCallBack& progressCallBack)
-        : FLAC::Encoder::File(), m_callBack(progressCallBack) {}
-
-    void progress_callback(FLAC__uint64 bytes_written,
-                           FLAC__uint64 samples_written,
-                           uint32_t frames_written,
-                           uint32_t total_frames_estimate) override
-    {
-        LOGI() << "wrote " << bytes_written << " bytes, "
-               << samples_written << " samples, "
-               << frames_written << " frames\n"
-               << "TOTAL FRAMES: " << total_frames_estimate;
-
-        m_callBack(frames_written * 4, total_frames_estimate);
-    }
-
-    ProgressCallBack m_callBack;
 };
 
-bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel)
 {
     if (!format.isValid()) {
         return false;
@@ -62,16 +43,14 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
 
     m_format = format;
 
-    m_flac = new FlacHandler([this](int64_t current, int64_t total){
-        m_progress.progressChanged.send(current, total, "");
-    });
+    m_flac = new FlacHandler();
 
     if (!m_flac->set_verify(true)
         || !m_flac->set_compression_level(0)
         || !m_flac->set_channels(m_format.audioChannelsNumber)
         || !m_flac->set_sample_rate(m_format.sampleRate)
         || !m_flac->set_bits_per_sample(16)
-        || !m_flac->set_total_samples_estimate(totalSamplesNumber)) {
+        || !m_flac->set_total_samples_estimate(totalSamplesPerChannel)) {
         return false;
     }
 
@@ -87,13 +66,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
     metadata[1]->length = 1234; /* set the padding length */
     m_flac->set_metadata(metadata, 2);
 
-    if (!openDestination(path)) {
-        return false;
-    }
-
-    prepareOutputBuffer(totalSamplesNumber);
-
-    return true;
+    return openDestination(path);
 }
 
 size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
@@ -102,30 +75,22 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
-    size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
-
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
+    const size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
 
-    for (size_t i = 0; i < buff.size(); ++i) {
-        buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    //! NOTE The chunks are of the same size, so the buffer is only allocated for the first one
+    if (m_samples.size() < samplesNumber) {
+        m_samples.resize(samplesNumber);
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
+    for (size_t i = 0; i < samplesNumber; ++i) {
+        m_samples[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    }
 
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    if (!m_flac->process_interleaved(m_samples.data(), static_cast<uint32_t>(samplesPerChannel))) {
+        return 0;
     }
 
-    return result;
+    return samplesNumber;
 }
 
 size_t FlacEncoder::flush()
@@ -134,9 +99,9 @@ size_t FlacEncoder::flush()
     return 0;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
@@ -31,18 +31,19 @@ namespace muse::audio::encode {
 class FlacEncoder : public AbstractAudioEncoder
 {
 public:
-    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber) override;
+    bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesPerChannel) override;
 
     size_t encode(samples_t samplesPerChannel, const float* input) override;
     size_t flush() override;
 
 protected:
-    size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const override;
+    size_t requiredOutputBufferSize(samples_t samplesPerChannel) const override;
     bool openDestination(const io::path_t& path) override;
     void closeDestination() override;
 
 private:
     FlacHandler* m_flac = nullptr;
+    std::vector<int32_t> m_samples;
 };
 }
 
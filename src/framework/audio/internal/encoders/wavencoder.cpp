@@ -87,48 +87,37 @@ size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
-
-    header.write(m_fileStream);
+    //! NOTE The samples are interleaved IEEE floats, exactly as they are stored in the file
+    const size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
 
-    int total = header.samplesPerChannel;
-    int progressStep = (total * 5) / 100; // every 5%
-    QVector<samples_t> progressValues;
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel;) {
-        progressValues << sampleIdx;
-        sampleIdx += progressStep;
+    if (!m_fileStream) {
+        return 0;
     }
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
-
-        if (progressValues.contains(sampleIdx)) {
-            m_progress.progressChanged.send(sampleIdx, total, "");
-        }
-    }
+    m_samplesPerChannelWritten += samplesPerChannel;
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    return samplesNumber;
 }
 
 size_t WavEncoder::flush()
 {
-    NOT_SUPPORTED;
+    if (!m_fileStream.is_open()) {
+        return 0;
+    }
+
+    //! NOTE The header was written before the samples were known, now it gets the actual data length
+    m_fileStream.seekp(0);
+    writeHeader();
+    m_fileStream.seekp(0, std::ios_base::end);
+    m_fileStream.flush();
 
     return 0;
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
@@ -136,7 +125,27 @@ bool WavEncoder::openDestination(const io::path_t& path)
     prepareWriting();
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
 
-    return m_fileStream.is_open();
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
+
+    m_samplesPerChannelWritten = 0;
+    writeHeader();
+
+    return true;
+}
+
+void WavEncoder::writeHeader()
+{
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = m_samplesPerChannelWritten;
+
+    header.write(m_fileStream);
 }
 
 void WavEncoder::closeDestination()
@@ -22,9 +22,12 @@
 
 #include "soundtrackwriter.h"
 
+#include <algorithm>
+
 #include "global/defer.h"
 
 #include "internal/worker/audioengine.h"
+#include "internal/worker/mixer.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
 #include "internal/encoders/flacencoder.h"
@@ -38,8 +41,9 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+//! NOTE Roughly a third of a second at 48 kHz: small enough to keep the memory bounded,
+//! big enough for the encoders to work efficiently
+static constexpr samples_t ENCODE_CHUNK_SAMPLES_PER_CHANNEL = 16384;
 
 static encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType type)
 {
@@ -60,49 +64,99 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
                                    const modularity::ContextPtr& iocCtx)
     : muse::Injectable(iocCtx), m_source(std::move(source))
 {
-    if (!m_source) {
-        return;
+    init(format, totalDuration);
+    addOutput(-1, destination);
+}
+
+SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const StemDestinations& stemDestinations,
+                                   const SoundTrackFormat& format, const msecs_t totalDuration, std::shared_ptr<Mixer> mixer,
+                                   const modularity::ContextPtr& iocCtx)
+    : muse::Injectable(iocCtx), m_source(mixer), m_mixer(mixer)
+{
+    init(format, totalDuration);
+    addOutput(-1, destination);
+
+    for (const auto& pair : stemDestinations) {
+        addOutput(pair.first, pair.second);
     }
+}
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(format.samplesPerChannel * format.audioChannelsNumber);
-    m_renderStep = format.samplesPerChannel;
+SoundTrackWriter::~SoundTrackWriter()
+{
+    m_encodeTasks.wait();
 
-    m_encoderPtr = createEncoder(format.type);
+    for (Output& output : m_outputs) {
+        if (output.encoder) {
+            output.encoder->deinit();
+        }
+    }
+}
 
-    if (!m_encoderPtr) {
+void SoundTrackWriter::init(const SoundTrackFormat& format, const msecs_t totalDuration)
+{
+    if (!m_source || format.samplesPerChannel == 0) {
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_format = format;
+    m_renderStep = format.samplesPerChannel;
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
+
+    //! NOTE The source renders whole steps, so a chunk consists of whole steps too
+    m_chunkSamplesPerChannel = std::max<samples_t>(ENCODE_CHUNK_SAMPLES_PER_CHANNEL / m_renderStep, 1) * m_renderStep;
+
+    m_isValid = true;
 }
 
-SoundTrackWriter::~SoundTrackWriter()
+void SoundTrackWriter::addOutput(const TrackId trackId, const io::path_t& destination)
 {
-    if (m_encoderPtr) {
-        m_encoderPtr->deinit();
+    if (!m_isValid) {
+        return;
+    }
+
+    Output output;
+    output.trackId = trackId;
+    output.encoder = createEncoder(m_format.type);
+
+    if (!output.encoder) {
+        m_isValid = false;
+        return;
     }
+
+    for (std::vector<float>& buffer : output.chunkBuffers) {
+        buffer.resize(m_chunkSamplesPerChannel * m_format.audioChannelsNumber);
+    }
+
+    output.encoder->init(destination, m_format, m_totalSamplesPerChannel);
+
+    m_outputs.push_back(std::move(output));
 }
 
 Ret SoundTrackWriter::write()
 {
     TRACEFUNC;
 
-    if (!m_source || !m_encoderPtr) {
+    if (!m_isValid || m_outputs.empty()) {
         return false;
     }
 
     audioEngine()->setMode(RenderMode::OfflineMode);
 
-    m_source->setSampleRate(m_encoderPtr->format().sampleRate);
+    m_source->setSampleRate(m_format.sampleRate);
     m_source->setIsActive(true);
 
+    if (m_mixer) {
+        m_mixer->setTrackProcessingTimeMeasured(true);
+    }
+
     DEFER {
-        m_encoderPtr->flush();
+        for (Output& output : m_outputs) {
+            output.encoder->flush();
+        }
+
+        if (m_mixer) {
+            m_mixer->setTrackProcessingTimeMeasured(false);
+        }
 
         audioEngine()->setMode(RenderMode::IdleMode);
 
@@ -112,22 +166,15 @@ Ret SoundTrackWriter::write()
         m_isAborted = false;
     };
 
-    Ret ret = generateAudioData();
-    if (!ret) {
-        return ret;
-    }
-
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-    if (m_isAborted) {
-        return make_ret(Ret::Code::Cancel);
-    }
+    Ret ret = writeAudioData();
 
-    if (bytes == 0) {
-        return make_ret(Err::ErrorEncode);
+    if (ret && m_mixer) {
+        collectStemsResult(std::chrono::steady_clock::now() - start);
     }
 
-    return muse::make_ok();
+    return ret;
 }
 
 void SoundTrackWriter::abort()
@@ -140,44 +187,124 @@ Progress SoundTrackWriter::progress()
     return m_progress;
 }
 
-Ret SoundTrackWriter::generateAudioData()
+const SoundTrackStemsResult& SoundTrackWriter::stemsResult() const
+{
+    return m_stemsResult;
+}
+
+Ret SoundTrackWriter::writeAudioData()
 {
     TRACEFUNC;
 
-    const size_t inputBufferMaxOffset = m_inputBuffer.size();
-    size_t inputBufferOffset = 0;
+    samples_t renderedSamplesPerChannel = 0;
+    size_t chunkIdx = 0;
+
+    m_encodeFailed = false;
+
+    sendProgress(renderedSamplesPerChannel, m_totalSamplesPerChannel);
+
+    while (renderedSamplesPerChannel < m_totalSamplesPerChannel && !m_isAborted) {
+        const samples_t chunkSamplesPerChannel = std::min(m_chunkSamplesPerChannel, m_totalSamplesPerChannel - renderedSamplesPerChannel);
+
+        renderChunk(chunkIdx, chunkSamplesPerChannel);
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        //! NOTE The previous chunks must be encoded before the next ones are passed to the encoders
+        m_encodeTasks.wait();
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), m_renderStep);
+        if (m_encodeFailed) {
+            break;
+        }
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        //! NOTE Every output has its own encoder, so they are encoded in parallel
+        for (Output& output : m_outputs) {
+            m_encodeTasks.run([this, &output, chunkIdx, chunkSamplesPerChannel]() {
+                encodeChunk(output, chunkIdx, chunkSamplesPerChannel);
+            });
+        }
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        renderedSamplesPerChannel += chunkSamplesPerChannel;
+        chunkIdx = (chunkIdx + 1) % m_outputs.front().chunkBuffers.size();
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        sendProgress(renderedSamplesPerChannel, m_totalSamplesPerChannel);
     }
 
+    m_encodeTasks.wait();
+
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
+    if (renderedSamplesPerChannel == 0) {
         LOGI() << "No audio to export";
         return make_ret(Err::NoAudioToExport);
     }
 
+    if (m_encodeFailed) {
+        return make_ret(Err::ErrorEncode);
+    }
+
     return muse::make_ok();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+void SoundTrackWriter::renderChunk(size_t chunkIdx, samples_t samplesPerChannel)
+{
+    const size_t stepSize = m_renderStep * m_format.audioChannelsNumber;
+
+    //! NOTE The tail of the last step, if any, is rendered but not encoded
+    for (samples_t offset = 0; offset < samplesPerChannel; offset += m_renderStep) {
+        const size_t bufferOffset = offset * m_format.audioChannelsNumber;
+
+        m_source->process(m_outputs.front().chunkBuffers[chunkIdx].data() + bufferOffset, m_renderStep);
+
+        for (size_t i = 1; i < m_outputs.size(); ++i) {
+            float* stemBuffer = m_outputs[i].chunkBuffers[chunkIdx].data() + bufferOffset;
+            const float* trackOutput = m_mixer->lastTrackOutput(m_outputs[i].trackId);
+
+            if (trackOutput) {
+                std::copy(trackOutput, trackOutput + stepSize, stemBuffer);
+            } else {
+                std::fill(stemBuffer, stemBuffer + stepSize, 0.f);
+            }
+        }
+    }
+}
+
+void SoundTrackWriter::encodeChunk(Output& output, size_t chunkIdx, samples_t samplesPerChannel)
+{
+    size_t encodedSamples = output.encoder->encode(samplesPerChannel, output.chunkBuffers[chunkIdx].data());
+
+    if (encodedSamples == 0) {
+        m_encodeFailed = true;
+    }
+}
+
+void SoundTrackWriter::collectStemsResult(std::chrono::steady_clock::duration totalTime)
+{
+    using msecs = std::chrono::duration<double, std::milli>;
+
+    m_stemsResult = SoundTrackStemsResult();
+    m_stemsResult.durationMsecs = m_totalSamplesPerChannel * 1000.0 / m_format.sampleRate;
+    m_stemsResult.totalMsecs = std::chrono::duration_cast<msecs>(totalTime).count();
+    m_stemsResult.realtimeFactor = m_stemsResult.totalMsecs > 0 ? m_stemsResult.durationMsecs / m_stemsResult.totalMsecs : 0.0;
+
+    for (size_t i = 1; i < m_outputs.size(); ++i) {
+        SoundTrackStemStats stats;
+        stats.trackId = m_outputs[i].trackId;
+        stats.processingMsecs = std::chrono::duration_cast<msecs>(m_mixer->trackProcessingTime(stats.trackId)).count();
+        stats.realtimeFactor = stats.processingMsecs > 0 ? m_stemsResult.durationMsecs / stats.processingMsecs : 0.0;
+
+        LOGI() << "stem of track " << stats.trackId << " rendered in " << stats.processingMsecs << " ms, realtime factor: "
+               << stats.realtimeFactor;
+
+        m_stemsResult.stems.push_back(stats);
+    }
+
+    LOGI() << "stems: " << m_stemsResult.stems.size() << ", total: " << m_stemsResult.totalMsecs
+           << " ms, realtime factor: " << m_stemsResult.realtimeFactor;
+}
+
+void SoundTrackWriter::sendProgress(int64_t current, int64_t total)
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progressChanged.send(stepCurrentProgress, 100, "");
+    int percentage = total > 0 ? static_cast<int>(current * 100 / total) : 100;
+    m_progress.progressChanged.send(percentage, 100, "");
 }
@@ -23,16 +23,24 @@
 #ifndef MUSE_AUDIO_SOUNDTRACKWRITER_H
 #define MUSE_AUDIO_SOUNDTRACKWRITER_H
 
+#include <array>
+#include <chrono>
 #include <vector>
 
 #include "global/async/asyncable.h"
+#include "global/concurrency/taskscheduler.h"
 #include "global/modularity/ioc.h"
+#include "global/progress.h"
 
 #include "audiotypes.h"
 #include "iaudiosource.h"
 #include "../worker/iaudioengine.h"
 #include "../encoders/abstractaudioencoder.h"
 
+namespace muse::audio {
+class Mixer;
+}
+
 namespace muse::audio::soundtrack {
 class SoundTrackWriter : public muse::Injectable, public async::Asyncable
 {
@@ -41,6 +49,12 @@ class SoundTrackWriter : public muse::Injectable, public async::Asyncable
 public:
     SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source,
                      const muse::modularity::ContextPtr& iocCtx);
+
+    //! NOTE Besides the master mix, writes the output of every given track of the mixer to its own file.
+    //! The tracks are rendered once, in parallel (see Mixer), for all the files
+    SoundTrackWriter(const io::path_t& destination, const StemDestinations& stemDestinations, const SoundTrackFormat& format,
+                     const msecs_t totalDuration, std::shared_ptr<Mixer> mixer, const muse::modularity::ContextPtr& iocCtx);
+
     ~SoundTrackWriter() override;
 
     Ret write();
@@ -48,18 +62,41 @@ public:
 
     Progress progress();
 
+    //! NOTE The rendering statistics of the stems, available after write()
+    const SoundTrackStemsResult& stemsResult() const;
+
 private:
-    Ret generateAudioData();
+    struct Output {
+        TrackId trackId = -1; // the master mix has no track
+        encode::AbstractAudioEncoderPtr encoder = nullptr;
+        std::array<std::vector<float>, 2> chunkBuffers; // one chunk is being rendered while the other one is being encoded
+    };
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    void init(const SoundTrackFormat& format, const msecs_t totalDuration);
+    void addOutput(const TrackId trackId, const io::path_t& destination);
+
+    Ret writeAudioData();
+    void renderChunk(size_t chunkIdx, samples_t samplesPerChannel);
+    void encodeChunk(Output& output, size_t chunkIdx, samples_t samplesPerChannel);
+    void collectStemsResult(std::chrono::steady_clock::duration totalTime);
+
+    void sendProgress(int64_t current, int64_t total);
 
     IAudioSourcePtr m_source = nullptr;
+    std::shared_ptr<Mixer> m_mixer = nullptr; // only to take the outputs of the stems from
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    SoundTrackFormat m_format;
+    std::vector<Output> m_outputs; // the master mix goes first
+    bool m_isValid = false;
+
+    samples_t m_chunkSamplesPerChannel = 0;
+    samples_t m_totalSamplesPerChannel = 0;
     samples_t m_renderStep = 0;
 
-    encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    TaskGroup m_encodeTasks;
+    std::atomic<bool> m_encodeFailed = false;
+
+    SoundTrackStemsResult m_stemsResult;
 
     Progress m_progress;
     std::atomic<bool> m_isAborted = false;
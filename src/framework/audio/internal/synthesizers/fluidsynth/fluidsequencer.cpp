@@ -22,6 +22,8 @@
 
 #include "fluidsequencer.h"
 
+#include <algorithm>
+
 #include "global/interpolation.h"
 
 using namespace muse;
@@ -78,6 +80,11 @@ void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events
         m_onMainStreamFlushed();
     }
 
+    m_maxEventsLead = 0;
+    m_maxEventsTail = 0;
+
+    updateEventsBounds(events.cbegin(), events.cend());
+
     updatePlaybackEvents(m_mainStreamEvents, events);
     updateMainSequenceIterator();
 
@@ -87,6 +94,124 @@ void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events
     }
 }
 
+void FluidSequencer::applyMainStreamChanges(const mpe::PlaybackEventsChangesList& changes)
+{
+    //! NOTE The midi events of both the replaced and the new note events lie within these ranges,
+    //! everything outside of them stays as it is
+    std::vector<EventsRange> ranges;
+
+    const PlaybackEventsMap& originEvents = m_playbackData.originEvents;
+
+    for (const PlaybackEventsChanges& change : changes) {
+        if (change.from > change.to) {
+            continue;
+        }
+
+        updateEventsBounds(originEvents.lower_bound(change.from), originEvents.upper_bound(change.to), &ranges);
+        updateEventsBounds(change.events.cbegin(), change.events.cend(), &ranges);
+    }
+
+    mpe::applyChanges(m_playbackData.originEvents, changes);
+
+    if (m_onMainStreamFlushed) {
+        m_onMainStreamFlushed();
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const EventsRange& r1, const EventsRange& r2) {
+        return r1.from < r2.from;
+    });
+
+    std::vector<EventsRange> mergedRanges;
+    for (const EventsRange& range : ranges) {
+        if (!mergedRanges.empty() && range.from <= mergedRanges.back().to) {
+            mergedRanges.back().to = std::max(mergedRanges.back().to, range.to);
+        } else {
+            mergedRanges.push_back(range);
+        }
+    }
+
+    for (const EventsRange& range : mergedRanges) {
+        rebuildMainStreamRange(range);
+    }
+
+    updateMainSequenceIterator();
+
+    if (m_useDynamicEvents) {
+        m_dynamicEvents.clear();
+        updateDynamicEvents(m_dynamicEvents, m_playbackData.dynamics);
+        updateDynamicChangesIterator();
+    }
+}
+
+FluidSequencer::EventsRange FluidSequencer::noteEventsRange(const mpe::NoteEvent& noteEvent) const
+{
+    const ArrangementContext& arrangementCtx = noteEvent.arrangementCtx();
+
+    EventsRange range;
+    range.from = arrangementCtx.actualTimestamp;
+    range.to = arrangementCtx.actualTimestamp + arrangementCtx.actualDuration;
+
+    //! NOTE e.g. the pedal is released at the end of the articulation, not of the note
+    for (const auto& pair : noteEvent.expressionCtx().articulations) {
+        const ArticulationMeta& meta = pair.second.meta;
+        range.to = std::max(range.to, meta.timestamp + meta.overallDuration);
+    }
+
+    return range;
+}
+
+void FluidSequencer::updateEventsBounds(mpe::PlaybackEventsMap::const_iterator begin, mpe::PlaybackEventsMap::const_iterator end,
+                                        std::vector<EventsRange>* outRanges)
+{
+    for (auto it = begin; it != end; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
+            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                continue;
+            }
+
+            EventsRange range = noteEventsRange(std::get<mpe::NoteEvent>(event));
+            if (outRanges) {
+                outRanges->push_back(range);
+            }
+
+            m_maxEventsLead = std::max(m_maxEventsLead, it->first - range.from);
+            m_maxEventsTail = std::max(m_maxEventsTail, range.to - it->first);
+        }
+    }
+}
+
+void FluidSequencer::rebuildMainStreamRange(const EventsRange& range)
+{
+    m_mainStreamEvents.erase(m_mainStreamEvents.lower_bound(range.from), m_mainStreamEvents.upper_bound(range.to));
+
+    //! NOTE Only the note events close enough to the range can have midi events within it
+    const PlaybackEventsMap& originEvents = m_playbackData.originEvents;
+    auto begin = originEvents.lower_bound(range.from - m_maxEventsTail);
+    auto end = originEvents.upper_bound(range.to + m_maxEventsLead);
+
+    EventSequenceMap noteEvents;
+
+    for (auto it = begin; it != end; ++it) {
+        for (const mpe::PlaybackEvent& event : it->second) {
+            if (!std::holds_alternative<mpe::NoteEvent>(event)) {
+                continue;
+            }
+
+            const mpe::NoteEvent& noteEvent = std::get<mpe::NoteEvent>(event);
+            EventsRange noteRange = noteEventsRange(noteEvent);
+            if (noteRange.to < range.from || noteRange.from > range.to) {
+                continue;
+            }
+
+            appendNoteEvents(noteEvents, noteEvent);
+        }
+    }
+
+    for (auto it = noteEvents.lower_bound(range.from); it != noteEvents.end() && it->first <= range.to; ++it) {
+        m_mainStreamEvents[it->first].insert(it->second.cbegin(), it->second.cend());
+    }
+}
+
 muse::async::Channel<channel_t, Program> FluidSequencer::channelAdded() const
 {
     return m_channels.channelAdded;
@@ -105,35 +230,38 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
                 continue;
             }
 
-            const mpe::NoteEvent& noteEvent = std::get<mpe::NoteEvent>(event);
+            appendNoteEvents(destination, std::get<mpe::NoteEvent>(event));
+        }
+    }
+}
 
-            timestamp_t timestampFrom = noteEvent.arrangementCtx().actualTimestamp;
-            timestamp_t timestampTo = timestampFrom + noteEvent.arrangementCtx().actualDuration;
+void FluidSequencer::appendNoteEvents(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent)
+{
+    timestamp_t timestampFrom = noteEvent.arrangementCtx().actualTimestamp;
+    timestamp_t timestampTo = timestampFrom + noteEvent.arrangementCtx().actualDuration;
 
-            channel_t channelIdx = channel(noteEvent);
-            note_idx_t noteIdx = noteIndex(noteEvent.pitchCtx().nominalPitchLevel);
-            velocity_t velocity = noteVelocity(noteEvent);
-            tuning_t tuning = noteTuning(noteEvent, noteIdx);
+    channel_t channelIdx = channel(noteEvent);
+    note_idx_t noteIdx = noteIndex(noteEvent.pitchCtx().nominalPitchLevel);
+    velocity_t velocity = noteVelocity(noteEvent);
+    tuning_t tuning = noteTuning(noteEvent, noteIdx);
 
-            midi::Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice20);
-            noteOn.setChannel(channelIdx);
-            noteOn.setNote(noteIdx);
-            noteOn.setVelocity(velocity);
-            noteOn.setPitchNote(noteIdx, tuning);
+    midi::Event noteOn(Event::Opcode::NoteOn, Event::MessageType::ChannelVoice20);
+    noteOn.setChannel(channelIdx);
+    noteOn.setNote(noteIdx);
+    noteOn.setVelocity(velocity);
+    noteOn.setPitchNote(noteIdx, tuning);
 
-            destination[timestampFrom].emplace(std::move(noteOn));
+    destination[timestampFrom].emplace(std::move(noteOn));
 
-            midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice20);
-            noteOff.setChannel(channelIdx);
-            noteOff.setNote(noteIdx);
-            noteOff.setPitchNote(noteIdx, tuning);
+    midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice20);
+    noteOff.setChannel(channelIdx);
+    noteOff.setNote(noteIdx);
+    noteOff.setPitchNote(noteIdx, tuning);
 
-            destination[timestampTo].emplace(std::move(noteOff));
+    destination[timestampTo].emplace(std::move(noteOff));
 
-            appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, midi::SUSTAIN_PEDAL_CONTROLLER);
-            appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES, channelIdx);
-        }
-    }
+    appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, midi::SUSTAIN_PEDAL_CONTROLLER);
+    appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES, channelIdx);
 }
 
 void FluidSequencer::updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes)
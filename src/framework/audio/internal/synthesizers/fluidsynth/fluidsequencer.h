@@ -47,8 +47,20 @@ private:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    void applyMainStreamChanges(const mpe::PlaybackEventsChangesList& changes) override;
+
+    struct EventsRange {
+        mpe::timestamp_t from = 0;
+        mpe::timestamp_t to = 0;
+    };
+
+    EventsRange noteEventsRange(const mpe::NoteEvent& noteEvent) const;
+    void updateEventsBounds(mpe::PlaybackEventsMap::const_iterator begin, mpe::PlaybackEventsMap::const_iterator end,
+                            std::vector<EventsRange>* outRanges = nullptr);
+    void rebuildMainStreamRange(const EventsRange& range);
 
     void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
+    void appendNoteEvents(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent);
     void updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes);
 
     void appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
@@ -66,6 +78,10 @@ private:
 
     mutable ChannelMap m_channels;
     bool m_useDynamicEvents = false;
+
+    //! NOTE How far the midi events of a note can lie before and after its key timestamp
+    mpe::duration_t m_maxEventsLead = 0;
+    mpe::duration_t m_maxEventsTail = 0;
 };
 }
 
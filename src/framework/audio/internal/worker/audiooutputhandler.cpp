@@ -29,6 +29,7 @@
 #include "internal/audiothread.h"
 #include "internal/worker/audioengine.h"
 #include "audioerrors.h"
+#include "devtools/mixerbenchmark.h"
 
 #include "muse_framework_config.h"
 #ifdef MUSE_MODULE_AUDIO_EXPORT
@@ -227,6 +228,59 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
     }, AudioThread::ID);
 }
 
+Promise<SoundTrackStemsResult> AudioOutputHandler::saveSoundTrackStems(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                                       const StemDestinations& stemDestinations,
+                                                                       const SoundTrackFormat& format)
+{
+    return Promise<SoundTrackStemsResult>([this, sequenceId, destination, stemDestinations, format](auto resolve, auto reject) {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        IF_ASSERT_FAILED(mixer()) {
+            return reject(static_cast<int>(Err::Undefined), "undefined reference to a mixer");
+        }
+
+        ITrackSequencePtr s = sequence(sequenceId);
+        if (!s) {
+            return reject(static_cast<int>(Err::InvalidSequenceId), "invalid sequence id");
+        }
+
+        const TrackIdList trackIdList = s->trackIdList();
+        for (const auto& pair : stemDestinations) {
+            if (!muse::contains(trackIdList, pair.first)) {
+                return reject(static_cast<int>(Err::InvalidTrackId), "invalid track id");
+            }
+        }
+
+#ifdef MUSE_MODULE_AUDIO_EXPORT
+        s->player()->stop();
+        s->player()->seek(0);
+        msecs_t totalDuration = s->player()->duration();
+
+        SoundTrackWriterPtr writer = std::make_shared<SoundTrackWriter>(destination, stemDestinations, format, totalDuration, mixer(),
+                                                                        iocContext());
+        m_saveSoundTracksWritersMap[sequenceId] = writer;
+
+        Progress progress = saveSoundTrackProgress(sequenceId);
+        writer->progress().progressChanged.onReceive(this, [&progress](int64_t current, int64_t total, std::string title) {
+            progress.progressChanged.send(current, total, title);
+        });
+
+        Ret ret = writer->write();
+        s->player()->seek(0);
+
+        m_saveSoundTracksWritersMap.erase(sequenceId);
+
+        if (!ret) {
+            return reject(ret.code(), ret.text());
+        }
+
+        return resolve(writer->stemsResult());
+#else
+        return reject(static_cast<int>(Err::DisabledAudioExport), "audio export is disabled");
+#endif
+    }, AudioThread::ID);
+}
+
 void AudioOutputHandler::abortSavingAllSoundTracks()
 {
 #ifdef MUSE_MODULE_AUDIO_EXPORT
@@ -250,6 +304,16 @@ void AudioOutputHandler::clearAllFx()
     fxResolver()->clearAllFx();
 }
 
+Promise<MixerBenchmarkResult> AudioOutputHandler::runMixerBenchmark(const MixerBenchmarkParams& params)
+{
+    return Promise<MixerBenchmarkResult>([this, params](auto resolve, auto /*reject*/) {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        MixerBenchmark benchmark(iocContext());
+        return resolve(benchmark.run(params));
+    }, AudioThread::ID);
+}
+
 std::shared_ptr<Mixer> AudioOutputHandler::mixer() const
 {
     return audioEngine()->mixer();
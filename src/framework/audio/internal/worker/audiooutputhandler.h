@@ -63,12 +63,17 @@ public:
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Promise<SoundTrackStemsResult> saveSoundTrackStems(const TrackSequenceId sequenceId, const io::path_t& destination,
+                                                              const StemDestinations& stemDestinations,
+                                                              const SoundTrackFormat& format) override;
     void abortSavingAllSoundTracks() override;
 
     Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) override;
 
     void clearAllFx() override;
 
+    async::Promise<MixerBenchmarkResult> runMixerBenchmark(const MixerBenchmarkParams& params) override;
+
 private:
     std::shared_ptr<Mixer> mixer() const;
     ITrackSequencePtr sequence(const TrackSequenceId id) const;
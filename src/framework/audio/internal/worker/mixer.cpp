@@ -21,6 +21,9 @@
  */
 #include "mixer.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "concurrency/taskscheduler.h"
 
 #include "internal/audiosanitizer.h"
@@ -94,6 +97,11 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, ITrackAudioInpu
 
     m_trackChannels.emplace(trackId, channel);
 
+    //! NOTE Preallocate, so that processing doesn't allocate
+    m_trackBuffers[trackId] = std::vector<float>(configuration()->samplesToPreallocate() * configuration()->audioChannelsCount(), 0.f);
+    m_trackProcessingTime[trackId] = std::chrono::steady_clock::duration::zero();
+    m_trackChannelJobs.reserve(m_trackChannels.size());
+
     result.val = m_trackChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
 
@@ -134,6 +142,8 @@ Ret Mixer::removeChannel(const TrackId trackId)
         }
 
         m_trackChannels.erase(trackId);
+        m_trackBuffers.erase(trackId);
+        m_trackProcessingTime.erase(trackId);
         return make_ret(Ret::Code::Ok);
     }
 
@@ -182,6 +192,7 @@ unsigned int Mixer::audioChannelsCount() const
 samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
+    TRACE_SCOPE("Mixer::process");
 
     for (IClockPtr clock : m_clocks) {
         clock->forward((samplesPerChannel * 1000000) / m_sampleRate);
@@ -191,19 +202,20 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     std::fill(outBuffer, outBuffer + outBufferSize, 0.f);
 
     if (m_isIdle && m_tracksToProcessWhenIdle.empty() && m_isSilence) {
+        m_trackChannelJobs.clear();
         notifyNoAudioSignal();
         return 0;
     }
 
-    TracksData tracksData;
-    processTrackChannels(outBufferSize, samplesPerChannel, tracksData);
+    processTrackChannels(outBufferSize, samplesPerChannel);
 
     prepareAuxBuffers(outBufferSize);
 
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& pair : tracksData) {
-        const std::vector<float>& trackBuffer = pair.second;
+    //! NOTE The tracks are always mixed in the same order, whichever thread processed them
+    for (const TrackChannelJob& job : m_trackChannelJobs) {
+        const std::vector<float>& trackBuffer = *job.buffer;
 
         bool outBufferIsSilent = false;
         mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel, outBufferIsSilent);
@@ -215,7 +227,7 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
             continue;
         }
 
-        const AuxSendsParams& auxSends = m_trackChannels.at(pair.first)->outputParams().auxSends;
+        const AuxSendsParams& auxSends = job.channel->outputParams().auxSends;
         writeTrackToAuxBuffers(trackBuffer.data(), auxSends, samplesPerChannel);
     }
 
@@ -236,62 +248,124 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return masterChannelSampleCount;
 }
 
-void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData)
+void Mixer::processTrackChannels(size_t outBufferSize, samples_t samplesPerChannel)
 {
-    auto processChannel = [outBufferSize, samplesPerChannel](MixerChannelPtr channel) -> std::vector<float> {
-        thread_local std::vector<float> buffer(outBufferSize, 0.f);
-        thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
+    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+
+    m_trackChannelJobs.clear();
+
+    for (const auto& pair : m_trackChannels) {
+        if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
+            continue;
+        }
 
-        if (buffer.size() < outBufferSize) {
-            buffer.resize(outBufferSize, 0.f);
-            silent_buffer.resize(outBufferSize, 0.f);
+        if (pair.second->muted()) {
+            pair.second->notifyNoAudioSignal();
+            continue;
+        }
+
+        //! NOTE Look up only, inserting would allocate on the audio thread
+        auto bufferIt = m_trackBuffers.find(pair.first);
+        IF_ASSERT_FAILED(bufferIt != m_trackBuffers.end()) {
+            continue;
+        }
+
+        std::chrono::steady_clock::duration* processingTime = nullptr;
+        if (m_measureTrackProcessingTime) {
+            auto timeIt = m_trackProcessingTime.find(pair.first);
+            if (timeIt != m_trackProcessingTime.end()) {
+                processingTime = &timeIt->second;
+            }
         }
 
-        buffer = silent_buffer;
+        m_trackChannelJobs.push_back({ pair.second.get(), &bufferIt->second, processingTime });
+    }
+
+    if (m_trackChannelJobs.empty()) {
+        return;
+    }
 
-        if (channel) {
-            channel->process(buffer.data(), samplesPerChannel);
+    if (!useMultithreading()) {
+        for (const TrackChannelJob& job : m_trackChannelJobs) {
+            processTrackChannel(job, outBufferSize, samplesPerChannel);
         }
+        return;
+    }
 
-        return buffer;
+    //! NOTE Every thread takes the next channel to process by the atomic index, until all are done.
+    //! There is one task per helping thread (not per channel), and the audio thread works too
+    std::atomic<size_t> nextJobIdx = 0;
+    auto work = [this, &nextJobIdx, outBufferSize, samplesPerChannel]() {
+        const size_t jobsCount = m_trackChannelJobs.size();
+        for (size_t idx = nextJobIdx.fetch_add(1); idx < jobsCount; idx = nextJobIdx.fetch_add(1)) {
+            processTrackChannel(m_trackChannelJobs[idx], outBufferSize, samplesPerChannel);
+        }
     };
 
-    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+    TaskScheduler* scheduler = TaskScheduler::instance();
+    const size_t helpersCount = std::min<size_t>(scheduler->threadPoolSize(), m_trackChannelJobs.size() - 1);
 
-    if (useMultithreading()) {
-        std::map<TrackId, std::future<std::vector<float> > > futures;
+    TaskGroup group(TaskPriority::High, scheduler);
+    for (size_t i = 0; i < helpersCount; ++i) {
+        group.run(work);
+    }
 
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    work();
 
-            if (pair.second->muted()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    group.wait();
+}
 
-            std::future<std::vector<float> > future = TaskScheduler::instance()->submit(processChannel, pair.second);
-            futures.emplace(pair.first, std::move(future));
-        }
+void Mixer::processTrackChannel(const TrackChannelJob& job, size_t outBufferSize, samples_t samplesPerChannel)
+{
+    TRACE_SCOPE("Mixer::processTrackChannel");
+    std::vector<float>& buffer = *job.buffer;
+    if (buffer.size() < outBufferSize) {
+        //! NOTE Only if the block is bigger than the preallocated size
+        buffer.resize(outBufferSize, 0.f);
+    }
 
-        for (auto& pair : futures) {
-            outTracksData.emplace(pair.first, pair.second.get());
-        }
-    } else {
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    std::fill(buffer.begin(), buffer.begin() + outBufferSize, 0.f);
 
-            if (pair.second->muted()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    if (!job.processingTime) {
+        job.channel->process(buffer.data(), samplesPerChannel);
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    job.channel->process(buffer.data(), samplesPerChannel);
+    *job.processingTime += std::chrono::steady_clock::now() - start;
+}
+
+const float* Mixer::lastTrackOutput(const TrackId trackId) const
+{
+    ONLY_AUDIO_WORKER_THREAD;
 
-            outTracksData.emplace(pair.first, processChannel(pair.second));
+    for (const TrackChannelJob& job : m_trackChannelJobs) {
+        if (job.channel->trackId() == trackId) {
+            return job.buffer->data();
         }
     }
+
+    return nullptr;
+}
+
+void Mixer::setTrackProcessingTimeMeasured(bool measured)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_measureTrackProcessingTime = measured;
+
+    for (auto& pair : m_trackProcessingTime) {
+        pair.second = std::chrono::steady_clock::duration::zero();
+    }
+}
+
+std::chrono::steady_clock::duration Mixer::trackProcessingTime(const TrackId trackId) const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    auto it = m_trackProcessingTime.find(trackId);
+    return it != m_trackProcessingTime.cend() ? it->second : std::chrono::steady_clock::duration::zero();
 }
 
 bool Mixer::useMultithreading() const
@@ -22,6 +22,7 @@
 #ifndef MUSE_AUDIO_MIXER_H
 #define MUSE_AUDIO_MIXER_H
 
+#include <chrono>
 #include <memory>
 #include <map>
 
@@ -68,6 +69,13 @@ public:
     void setIsIdle(bool idle);
     void setTracksToProcessWhenIdle(std::unordered_set<TrackId>&& trackIds);
 
+    //! NOTE For the offline bounce: the output of the track channel in the last processed block,
+    //! nullptr if the track was not processed (e.g. muted)
+    const float* lastTrackOutput(const TrackId trackId) const;
+
+    void setTrackProcessingTimeMeasured(bool measured);
+    std::chrono::steady_clock::duration trackProcessingTime(const TrackId trackId) const;
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -75,9 +83,14 @@ public:
     void setIsActive(bool arg) override;
 
 private:
-    using TracksData = std::map<TrackId, std::vector<float> >;
+    struct TrackChannelJob {
+        MixerChannel* channel = nullptr;
+        std::vector<float>* buffer = nullptr;
+        std::chrono::steady_clock::duration* processingTime = nullptr; // only if measured
+    };
 
-    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData);
+    void processTrackChannels(size_t outBufferSize, samples_t samplesPerChannel);
+    void processTrackChannel(const TrackChannelJob& job, size_t outBufferSize, samples_t samplesPerChannel);
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, bool& outBufferIsSilent);
     void prepareAuxBuffers(size_t outBufferSize);
     void writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel);
@@ -98,6 +111,10 @@ private:
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
     std::map<TrackId, MixerChannelPtr> m_trackChannels = {};
+    std::map<TrackId, std::vector<float> > m_trackBuffers = {};
+    std::map<TrackId, std::chrono::steady_clock::duration> m_trackProcessingTime = {};
+    bool m_measureTrackProcessingTime = false;
+    std::vector<TrackChannelJob> m_trackChannelJobs; // the channels to process in the current block, in the order of mixing
     std::unordered_set<TrackId> m_tracksToProcessWhenIdle;
 
     struct AuxChannelInfo {
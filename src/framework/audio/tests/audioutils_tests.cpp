@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "audio/audioutils.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+class Audio_AudioUtilsTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Audio_AudioUtilsTests, StemDestinations_OneFilePerTrack)
+{
+    //! [GIVEN] The tracks of a score, two of them with the same name
+    const std::map<TrackId, std::string> trackNames = {
+        { 1, "Flute" },
+        { 2, "Piano" },
+        { 3, "Violin I" },
+        { 4, "Piano" },
+    };
+
+    //! [WHEN] Make the destinations of the stems
+    StemDestinations destinations = makeStemDestinations("/scores/Symphony.wav", trackNames);
+
+    //! [THEN] There is a file for every track
+    ASSERT_EQ(destinations.size(), trackNames.size());
+
+    //! [THEN] The files are next to the master mix and have its suffix
+    EXPECT_EQ(destinations.at(1), io::path_t("/scores/Symphony-Flute.wav"));
+    EXPECT_EQ(destinations.at(2), io::path_t("/scores/Symphony-Piano.wav"));
+    EXPECT_EQ(destinations.at(3), io::path_t("/scores/Symphony-Violin_I.wav"));
+
+    //! [THEN] The tracks with the same name don't overwrite each other's files, nor the master mix
+    EXPECT_EQ(destinations.at(4), io::path_t("/scores/Symphony-Piano-2.wav"));
+
+    std::set<io::path_t> paths { "/scores/Symphony.wav" };
+    for (const auto& pair : destinations) {
+        paths.insert(pair.second);
+    }
+
+    EXPECT_EQ(paths.size(), trackNames.size() + 1);
+}
@@ -98,6 +98,10 @@ void AbPaintProvider::paintData(muse::draw::IPaintProviderPtr provider, const mu
         for (const DrawText& t : d.texts) {
             if (t.mode == DrawText::Point) {
                 provider->drawText(t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Workaround) {
+                provider->drawTextWorkaround(st.font, t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Symbol) {
+                provider->drawSymbol(t.rect.topLeft(), t.symbolCode());
             } else {
                 provider->drawText(t.rect, t.flags, t.text);
             }
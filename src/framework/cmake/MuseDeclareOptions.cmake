@@ -66,3 +66,4 @@ option(MUSE_ENABLE_UNIT_TESTS "Build framework unit tests" ON)
 
 # === Tools ===
 option(MUSE_ENABLE_CUSTOM_ALLOCATOR "Enable custom allocator" OFF)
+option(MUSE_ENABLE_ARENA_ALLOCATOR "Allocate objects in per-document memory arenas" OFF)
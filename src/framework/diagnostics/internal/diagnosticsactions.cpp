@@ -46,6 +46,16 @@ const UiActionList DiagnosticsActions::m_actions = {
              muse::shortcuts::CTX_ANY,
              TranslatableString("action", "Show pr&ofiler…")
              ),
+    UiAction("diagnostic-start-tracing",
+             muse::ui::UiCtxAny,
+             muse::shortcuts::CTX_ANY,
+             TranslatableString("action", "Start &tracing")
+             ),
+    UiAction("diagnostic-stop-tracing",
+             muse::ui::UiCtxAny,
+             muse::shortcuts::CTX_ANY,
+             TranslatableString("action", "Stop tracing and save &trace")
+             ),
     UiAction("diagnostic-show-navigation-tree",
              muse::ui::UiCtxAny,
              muse::shortcuts::CTX_ANY,
@@ -65,6 +75,11 @@ const UiActionList DiagnosticsActions::m_actions = {
              muse::ui::UiCtxAny,
              muse::shortcuts::CTX_ANY,
              TranslatableString("action", "Show engraving &elements")
+             ),
+    UiAction("diagnostic-print-memory-state",
+             muse::ui::UiCtxAny,
+             muse::shortcuts::CTX_ANY,
+             TranslatableString("action", "Print &memory allocators state to console")
              )
 };
 
@@ -21,7 +21,11 @@
  */
 #include "diagnosticsactionscontroller.h"
 
+#include <QDateTime>
+
 #include "types/uri.h"
+#include "global/allocator.h"
+#include "global/tracer.h"
 
 #include "view/diagnosticaccessiblemodel.h"
 
@@ -41,10 +45,15 @@ void DiagnosticsActionsController::init()
 {
     dispatcher()->reg(this, "diagnostic-show-paths", [this]() { openUri(SYSTEM_PATHS_URI); });
     dispatcher()->reg(this, "diagnostic-show-profiler", [this]() { openUri(PROFILER_URI); });
+    dispatcher()->reg(this, "diagnostic-start-tracing", this, &DiagnosticsActionsController::startTracing);
+    dispatcher()->reg(this, "diagnostic-stop-tracing", this, &DiagnosticsActionsController::stopTracing);
     dispatcher()->reg(this, "diagnostic-show-navigation-tree", [this]() { openUri(NAVIGATION_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-show-accessible-tree", [this]() { openUri(ACCESSIBLE_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-accessible-tree-dump", []() { DiagnosticAccessibleModel::dumpTree(); });
     dispatcher()->reg(this, "diagnostic-show-engraving-elements", [this]() { openUri(ENGRAVING_ELEMENTS_URI, false); });
+    dispatcher()->reg(this, "diagnostic-print-memory-state", []() {
+        AllocatorsRegister::instance()->printState("=== Memory allocators state ===");
+    });
     dispatcher()->reg(this, "diagnostic-save-diagnostic-files", this, &DiagnosticsActionsController::saveDiagnosticFiles);
 }
 
@@ -64,3 +73,29 @@ void DiagnosticsActionsController::saveDiagnosticFiles()
         LOGE() << ret.toString();
     }
 }
+
+void DiagnosticsActionsController::startTracing()
+{
+    LOGI() << "tracing started";
+    Tracer::setEnabled(true);
+}
+
+void DiagnosticsActionsController::stopTracing()
+{
+    if (!Tracer::enabled()) {
+        return;
+    }
+
+    Tracer::setEnabled(false);
+
+    //! NOTE Into the logs dir, so that the trace gets into the diagnostic files
+    io::path_t path = globalConfiguration()->userAppDataPath() + "/logs/trace_"
+                      + QDateTime::currentDateTime().toString("yyMMdd_HHmmss") + ".json";
+
+    if (!Tracer::save(path.toStdString())) {
+        LOGE() << "failed save trace: " << path;
+        return;
+    }
+
+    LOGI() << "trace saved: " << path;
+}
@@ -26,6 +26,7 @@
 #include "actions/iactionsdispatcher.h"
 #include "actions/actionable.h"
 #include "iinteractive.h"
+#include "iglobalconfiguration.h"
 #include "accessibility/iaccessibilitycontroller.h"
 #include "isavediagnosticfilesscenario.h"
 
@@ -35,6 +36,7 @@ class DiagnosticsActionsController : public muse::actions::Actionable
     INJECT(muse::actions::IActionsDispatcher, dispatcher)
     INJECT(muse::IInteractive, interactive)
     INJECT(diagnostics::ISaveDiagnosticFilesScenario, saveDiagnosticsScenario)
+    INJECT(IGlobalConfiguration, globalConfiguration)
 
 public:
     DiagnosticsActionsController() = default;
@@ -44,6 +46,8 @@ public:
 private:
     void openUri(const muse::UriQuery& uri, bool isSingle = true);
     void saveDiagnosticFiles();
+    void startTracing();
+    void stopTracing();
 };
 }
 
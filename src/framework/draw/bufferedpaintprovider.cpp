@@ -302,13 +302,15 @@ void BufferedPaintProvider::drawText(const RectF& rect, int flags, const String&
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const String& text)
 {
+    //! NOTE The workaround depends on the scale of the target, so it's applied when the data is drawn
     setFont(f);
-    drawText(pos, text);
+    editableData().texts.push_back(DrawText { DrawText::Workaround, RectF(pos, SizeF()), 0, text });
 }
 
 void BufferedPaintProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 {
-    drawText(point, String::fromUcs4(&ucs4Code, 1));
+    //! NOTE Recorded with the texts to keep the order of the calls
+    editableData().texts.push_back(DrawText { DrawText::Symbol, RectF(point, SizeF()), 0, String::fromUcs4(ucs4Code) });
 }
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const Pixmap& pm)
@@ -322,31 +324,49 @@ void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm,
 }
 
 #ifndef NO_QT_SUPPORT
+//! NOTE Encoding is slow, and usually the same pixmap is drawn again and again (e.g. the wallpaper of each page).
+//! QPixmap is only used on the GUI thread, so is this cache
+static Pixmap encodedPixmap(const QPixmap& pm)
+{
+    static qint64 s_key = 0;
+    static Pixmap s_pixmap;
+
+    if (pm.cacheKey() != s_key) {
+        s_pixmap = Pixmap::fromQPixmap(pm);
+        s_key = pm.cacheKey();
+    }
+
+    return s_pixmap;
+}
+
 void BufferedPaintProvider::drawPixmap(const PointF& p, const QPixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Single, RectF(p, SizeF()), Pixmap::fromQPixmap(pm), PointF() });
+    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Single, RectF(p, SizeF()), encodedPixmap(pm), PointF() });
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
-    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Tiled, rect, Pixmap::fromQPixmap(pm), offset });
+    editableData().pixmaps.push_back(DrawPixmap { DrawPixmap::Tiled, rect, encodedPixmap(pm), offset });
 }
 
 #endif
 
 bool BufferedPaintProvider::hasClipping() const
 {
-    return false;
+    return currentState().isClipping;
 }
 
 void BufferedPaintProvider::setClipRect(const RectF& rect)
 {
-    UNUSED(rect);
+    //! NOTE As QPainter does, the rect is mapped with the current transform and enables the clipping
+    DrawData::State& st = editableState();
+    st.clipRect = st.transform.map(rect);
+    st.isClipping = true;
 }
 
 void BufferedPaintProvider::setClipping(bool enable)
 {
-    UNUSED(enable);
+    editableState().isClipping = enable;
 }
 
 DrawDataPtr BufferedPaintProvider::drawData() const
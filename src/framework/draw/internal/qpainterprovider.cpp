@@ -49,8 +49,12 @@ QPainterProvider::QPainterProvider(QPainter* painter, bool ownsPainter)
     }
 }
 
+static constexpr size_t MAX_SYMBOL_FONTS = 8;
+
 QPainterProvider::~QPainterProvider()
 {
+    flushSymbols();
+
     if (m_ownsPainter) {
         delete m_painter;
     }
@@ -70,6 +74,7 @@ IPaintProviderPtr QPainterProvider::make(QPainter* qp, bool ownsPainter)
 
 QPainter* QPainterProvider::qpainter() const
 {
+    flushSymbols();
     return m_painter;
 }
 
@@ -83,6 +88,8 @@ void QPainterProvider::beforeEndTargetHook(Painter*)
 
 bool QPainterProvider::endTarget(bool endDraw)
 {
+    flushSymbols();
+
     if (endDraw) {
         return m_painter->end();
     }
@@ -97,16 +104,20 @@ bool QPainterProvider::isActive() const
 void QPainterProvider::beginObject(const std::string& name)
 {
     UNUSED(name)
+    //! NOTE The objects are pages, the device may start a new page between them (see Paint::paintScore)
+    flushSymbols();
     //m_drawObjectsLogger->beginObject(name);
 }
 
 void QPainterProvider::endObject()
 {
+    flushSymbols();
     //m_drawObjectsLogger->endObject();
 }
 
 void QPainterProvider::setAntialiasing(bool arg)
 {
+    flushSymbols();
     m_painter->setRenderHint(QPainter::Antialiasing, arg);
     m_painter->setRenderHint(QPainter::TextAntialiasing, arg);
 }
@@ -120,6 +131,7 @@ void QPainterProvider::setCompositionMode(CompositionMode mode)
         }
         return QPainter::CompositionMode_SourceOver;
     };
+    flushSymbols();
     m_painter->setCompositionMode(toQPainter(mode));
 }
 
@@ -138,6 +150,7 @@ void QPainterProvider::setViewport(const RectF& viewport)
 void QPainterProvider::setFont(const Font& font)
 {
     if (m_font != font) {
+        flushSymbols();
         m_painter->setFont(font.toQFont());
         m_font = font;
     }
@@ -150,12 +163,17 @@ const Font& QPainterProvider::font() const
 
 void QPainterProvider::setPen(const Pen& pen)
 {
+    if (m_pen != pen) {
+        flushSymbols();
+    }
+
     m_pen = pen;
     m_painter->setPen(Pen::toQPen(m_pen));
 }
 
 void QPainterProvider::setNoPen()
 {
+    flushSymbols();
     m_pen = Pen(PenStyle::NoPen);
     m_painter->setPen(Pen::toQPen(m_pen));
 }
@@ -178,11 +196,14 @@ const Brush& QPainterProvider::brush() const
 
 void QPainterProvider::save()
 {
+    //! NOTE The painter may be used directly until restore(), which would apply to the collected symbols
+    flushSymbols();
     m_painter->save();
 }
 
 void QPainterProvider::restore()
 {
+    flushSymbols();
     m_painter->restore();
     m_font = Font::fromQFont(m_painter->font(), Font::Type::Undefined);
     m_pen = Pen::fromQPen(m_painter->pen());
@@ -205,6 +226,7 @@ const Transform& QPainterProvider::transform() const
 
 void QPainterProvider::drawPath(const PainterPath& path)
 {
+    flushSymbols();
     m_painter->drawPath(PainterPath::toQPainterPath(path));
 }
 
@@ -212,6 +234,8 @@ void QPainterProvider::drawPolygon(const PointF* points, size_t pointCount, Poly
 {
     static_assert(sizeof(QPointF) == sizeof(PointF), "sizeof(QPointF) and sizeof(PointF) must be equal");
 
+    flushSymbols();
+
     const QPointF* qpoints = reinterpret_cast<const QPointF*>(points);
 
     switch (mode) {
@@ -232,6 +256,7 @@ void QPainterProvider::drawPolygon(const PointF* points, size_t pointCount, Poly
 
 void QPainterProvider::drawText(const PointF& point, const String& text)
 {
+    flushSymbols();
     QPointF p = point.toQPointF();
     QString t = text.toQString();
     m_painter->drawText(p, t);
@@ -239,11 +264,13 @@ void QPainterProvider::drawText(const PointF& point, const String& text)
 
 void QPainterProvider::drawText(const RectF& rect, int flags, const String& text)
 {
+    flushSymbols();
     m_painter->drawText(rect.toQRectF(), flags, text);
 }
 
 void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, const String& text)
 {
+    flushSymbols();
     m_painter->save();
     double mm = m_painter->worldTransform().m11();
     double dx = m_painter->worldTransform().dx();
@@ -305,16 +332,117 @@ void QPainterProvider::drawTextWorkaround(const Font& f, const PointF& pos, cons
 
 void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 {
-    static QHash<char32_t, QString> cache;
-    if (!cache.contains(ucs4Code)) {
-        cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
+    SymbolFont& font = symbolFont();
+    quint32 glyph = symbolGlyph(font, ucs4Code);
+
+    const QTransform& transform = m_painter->worldTransform();
+
+    bool isSameRun = !m_symbolRun.glyphs.isEmpty()
+                     && transform.m11() == m_symbolRun.transform.m11()
+                     && transform.m12() == m_symbolRun.transform.m12()
+                     && transform.m21() == m_symbolRun.transform.m21()
+                     && transform.m22() == m_symbolRun.transform.m22();
+
+    if (!isSameRun) {
+        flushSymbols();
+    }
+
+    //! NOTE Not in the font (will be drawn with a fallback font) or not batchable
+    if (glyph == 0 || !transform.isAffine() || !transform.isInvertible()) {
+        //! NOTE No shared cache here, the providers are also used on the worker threads
+        drawText(point, QString::fromUcs4(&ucs4Code, 1));
+        return;
+    }
+
+    if (m_symbolRun.glyphs.isEmpty()) {
+        m_symbolRun.rawFont = font.rawFont;
+        m_symbolRun.transform = transform;
+        m_symbolRun.inverted = transform.inverted();
+        m_symbolRun.glyphs.append(glyph);
+        m_symbolRun.positions.append(point.toQPointF());
+        return;
+    }
+
+    //! NOTE To the coordinates of the run (differ only by translation)
+    m_symbolRun.glyphs.append(glyph);
+    m_symbolRun.positions.append(m_symbolRun.inverted.map(transform.map(point.toQPointF())));
+}
+
+QPainterProvider::SymbolFont& QPainterProvider::symbolFont()
+{
+    for (SymbolFont& f : m_symbolFonts) {
+        if (f.font == m_font) {
+            return f;
+        }
+    }
+
+    if (m_symbolFonts.size() >= MAX_SYMBOL_FONTS) {
+        flushSymbols();
+        m_symbolFonts.erase(m_symbolFonts.begin());
+    }
+
+    SymbolFont f;
+    f.font = m_font;
+    //! NOTE Resolved for the device, as QPainter::drawText does
+    f.rawFont = QRawFont::fromFont(QFont(m_painter->font(), m_painter->device()));
+    m_symbolFonts.push_back(std::move(f));
+
+    return m_symbolFonts.back();
+}
+
+quint32 QPainterProvider::symbolGlyph(SymbolFont& font, char32_t ucs4Code) const
+{
+    auto it = font.glyphs.constFind(ucs4Code);
+    if (it != font.glyphs.cend()) {
+        return it.value();
+    }
+
+    quint32 glyph = 0;
+    if (font.rawFont.isValid() && font.rawFont.supportsCharacter(ucs4Code)) {
+        QString str = QString::fromUcs4(&ucs4Code, 1);
+        quint32 glyphs[2] = { 0, 0 };
+        int glyphsCount = 2;
+        if (font.rawFont.glyphIndexesForChars(str.constData(), int(str.size()), glyphs, &glyphsCount) && glyphsCount == 1) {
+            glyph = glyphs[0];
+        }
+    }
+
+    font.glyphs.insert(ucs4Code, glyph);
+    return glyph;
+}
+
+void QPainterProvider::flushSymbols() const
+{
+    if (m_symbolRun.glyphs.isEmpty()) {
+        return;
+    }
+
+    if (m_painter && m_painter->isActive()) {
+        QGlyphRun run;
+        run.setRawFont(m_symbolRun.rawFont);
+        run.setGlyphIndexes(m_symbolRun.glyphs);
+        run.setPositions(m_symbolRun.positions);
+
+        const QTransform current = m_painter->worldTransform();
+        bool isOtherTransform = current != m_symbolRun.transform;
+        if (isOtherTransform) {
+            m_painter->setWorldTransform(m_symbolRun.transform);
+        }
+
+        m_painter->drawGlyphRun(QPointF(), run);
+
+        if (isOtherTransform) {
+            m_painter->setWorldTransform(current);
+        }
     }
 
-    drawText(point, cache.value(ucs4Code));
+    m_symbolRun.glyphs.clear();
+    m_symbolRun.positions.clear();
 }
 
 void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 {
+    flushSymbols();
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
@@ -327,6 +455,7 @@ void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 
 void QPainterProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
+    flushSymbols();
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
@@ -339,11 +468,13 @@ void QPainterProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, cons
 
 void QPainterProvider::drawPixmap(const PointF& point, const QPixmap& pm)
 {
+    flushSymbols();
     m_painter->drawPixmap(QPointF(point.x(), point.y()), pm);
 }
 
 void QPainterProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
+    flushSymbols();
     m_painter->drawTiledPixmap(rect.toQRectF(), pm, QPointF(offset.x(), offset.y()));
 }
 
@@ -354,10 +485,12 @@ bool QPainterProvider::hasClipping() const
 
 void QPainterProvider::setClipRect(const RectF& rect)
 {
+    flushSymbols();
     m_painter->setClipRect(rect.toQRectF());
 }
 
 void QPainterProvider::setClipping(bool enable)
 {
+    flushSymbols();
     m_painter->setClipping(enable);
 }
@@ -21,6 +21,13 @@
  */
 #pragma once
 
+#include <vector>
+
+#include <QHash>
+#include <QRawFont>
+#include <QTransform>
+#include <QVector>
+
 #include "../ipaintprovider.h"
 
 class QPainter;
@@ -90,9 +97,32 @@ public:
     void setClipping(bool enable) override;
 
 protected:
+    //! NOTE Draws the collected symbols, must be called before the painter is used directly
+    void flushSymbols() const;
+
     QPainter* m_painter = nullptr;
 
 private:
+    struct SymbolFont {
+        Font font;
+        QRawFont rawFont;
+        QHash<char32_t, quint32> glyphs;
+    };
+
+    //! NOTE Consecutive symbols drawn with the same font, pen and scale (the items are only translated)
+    //! are collected into one glyph run, so they are drawn at once, without text layout,
+    //! from the glyph cache of the font engine
+    struct SymbolRun {
+        QRawFont rawFont;
+        QTransform transform;
+        QTransform inverted;
+        QVector<quint32> glyphs;
+        QVector<QPointF> positions;
+    };
+
+    SymbolFont& symbolFont();
+    quint32 symbolGlyph(SymbolFont& font, char32_t ucs4Code) const;
+
     bool m_ownsPainter = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
     Font m_font;
@@ -100,5 +130,8 @@ private:
     Brush m_brush;
 
     Transform m_transform;
+
+    std::vector<SymbolFont> m_symbolFonts;
+    mutable SymbolRun m_symbolRun;
 };
 }
@@ -25,6 +25,8 @@
 #include <QImage>
 
 #include "draw/painter.h"
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
 
 #include "draw/internal/qpainterprovider.h"
 
@@ -156,3 +158,121 @@ TEST_F(Draw_PainterTests, Painter_SaveRestore)
 
     EXPECT_EQ(painter.provider()->transform(), worldTransform * expectedViewTransform);
 }
+
+static bool hasNotWhitePixels(const QImage& image, const QRect& rect)
+{
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        for (int x = rect.left(); x <= rect.right(); ++x) {
+            if (image.pixel(x, y) != qRgb(255, 255, 255)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST_F(Draw_PainterTests, Painter_SymbolsDrawnInOrder)
+{
+    //! GIVEN Painter
+    QImage pd(100, 100, QImage::Format_RGB32);
+    pd.fill(Qt::white);
+    QPainter qp(&pd);
+
+    {
+        Painter painter(&qp, "test");
+        painter.setPen(Color::BLACK);
+
+        Font font = painter.font();
+        font.setPointSizeF(30.0);
+        painter.setFont(font);
+
+        //! DO Draw symbols of two items, which differ only by translation (so they are batched)
+        painter.translate(5.0, 60.0);
+        painter.drawSymbol(PointF(), U'H');
+        painter.translate(50.0, 0.0);
+        painter.drawSymbol(PointF(), U'H');
+
+        //! DO Cover the first item
+        painter.fillRect(RectF(-55.0, -60.0, 50.0, 100.0), Brush(Color::WHITE));
+    }
+
+    //! CHECK The first symbol is covered, as it was drawn before the rect
+    EXPECT_FALSE(hasNotWhitePixels(pd, QRect(0, 0, 50, 100)));
+
+    //! CHECK The second symbol is drawn at its position
+    EXPECT_TRUE(hasNotWhitePixels(pd, QRect(50, 0, 50, 100)));
+}
+
+static void collectDatas(const DrawData::Item& item, std::vector<const DrawData::Data*>& datas)
+{
+    for (const DrawData::Data& d : item.datas) {
+        datas.push_back(&d);
+    }
+
+    for (const DrawData::Item& ch : item.chilren) {
+        collectDatas(ch, datas);
+    }
+}
+
+TEST_F(Draw_PainterTests, BufferedPaintProvider_SymbolsAndClip)
+{
+    //! GIVEN Painter that records the drawing
+    std::shared_ptr<BufferedPaintProvider> provider = std::make_shared<BufferedPaintProvider>();
+
+    {
+        Painter painter(provider, "test");
+        painter.setPen(Color::BLACK);
+
+        Font font = painter.font();
+        font.setPointSizeF(30.0);
+        painter.setFont(font);
+
+        //! DO Draw two symbols, the second one outside of the clip
+        painter.translate(5.0, 60.0);
+        painter.setClipRect(RectF(-5.0, -60.0, 50.0, 100.0));
+        painter.drawSymbol(PointF(), U'H');
+        painter.drawSymbol(PointF(50.0, 0.0), U'H');
+    }
+
+    DrawDataPtr data = provider->drawData();
+
+    std::vector<const DrawData::Data*> datas;
+    collectDatas(data->item, datas);
+
+    //! CHECK The symbols are recorded as texts of the symbol mode, in order
+    std::vector<DrawText> symbols;
+    const DrawData::State* symbolsState = nullptr;
+    for (const DrawData::Data* d : datas) {
+        for (const DrawText& t : d->texts) {
+            if (t.mode == DrawText::Symbol) {
+                symbols.push_back(t);
+                symbolsState = &data->states.at(d->state);
+            }
+        }
+    }
+
+    ASSERT_EQ(symbols.size(), 2);
+    EXPECT_EQ(symbols.at(0).rect.topLeft(), PointF());
+    EXPECT_EQ(symbols.at(0).symbolCode(), U'H');
+    EXPECT_EQ(symbols.at(1).rect.topLeft(), PointF(50.0, 0.0));
+    EXPECT_EQ(symbols.at(1).symbolCode(), U'H');
+
+    //! CHECK The clip is recorded in the target coordinates
+    ASSERT_TRUE(symbolsState);
+    EXPECT_TRUE(symbolsState->isClipping);
+    EXPECT_EQ(symbolsState->clipRect, RectF(0.0, 0.0, 50.0, 100.0));
+
+    //! DO Draw the recording
+    QImage pd(100, 100, QImage::Format_RGB32);
+    pd.fill(Qt::white);
+    QPainter qp(&pd);
+
+    {
+        Painter painter(&qp, "test");
+        DrawDataPaint::paint(&painter, data);
+    }
+
+    //! CHECK Only the first symbol is drawn, the second one is clipped
+    EXPECT_TRUE(hasNotWhitePixels(pd, QRect(0, 0, 50, 100)));
+    EXPECT_FALSE(hasNotWhitePixels(pd, QRect(50, 0, 50, 100)));
+}
@@ -76,11 +76,13 @@ struct DrawText {
     enum Mode {
         Undefined = 0,
         Point,
-        Rect
+        Rect,
+        Workaround, // As Point, but drawn with IPaintProvider::drawTextWorkaround
+        Symbol      // As Point, a single symbol drawn with IPaintProvider::drawSymbol
     };
 
     Mode mode = Mode::Undefined;
-    RectF rect;     // If mode is Point when use topLeft point
+    RectF rect;     // If mode is Point, Workaround or Symbol when use topLeft point
     int flags = 0;
     String text;
     bool operator==(const DrawText& o) const
@@ -89,6 +91,20 @@ struct DrawText {
     }
 
     bool operator!=(const DrawText& o) const { return !this->operator==(o); }
+
+    // If mode is Symbol
+    char32_t symbolCode() const
+    {
+        if (text.empty()) {
+            return 0;
+        }
+
+        if (text.size() > 1 && text.at(0).isHighSurrogate()) {
+            return Char::surrogateToUcs4(text.at(0), text.at(1));
+        }
+
+        return text.at(0).unicode();
+    }
 };
 
 struct DrawPixmap {
@@ -115,11 +131,14 @@ struct DrawData
         Transform transform;
         bool isAntialiasing = false;
         CompositionMode compositionMode = CompositionMode::SourceOver;
+        bool isClipping = false;
+        RectF clipRect; // in the target coordinates (not affected by the transform)
 
         bool operator==(const State& o) const
         {
             return pen == o.pen && brush == o.brush && font == o.font && transform == o.transform
-                   && isAntialiasing == o.isAntialiasing && compositionMode == o.compositionMode;
+                   && isAntialiasing == o.isAntialiasing && compositionMode == o.compositionMode
+                   && isClipping == o.isClipping && clipRect == o.clipRect;
         }
 
         bool operator!=(const State& o) const { return !this->operator==(o); }
@@ -246,6 +246,14 @@ static bool isEqual(const DrawData::State& s1, const DrawData::State& s2, DrawDa
         return false;
     }
 
+    if (s1.isClipping != s2.isClipping) {
+        return false;
+    }
+
+    if (s1.isClipping && !isEqual(s1.clipRect, s2.clipRect, tolerance.base)) {
+        return false;
+    }
+
     return true;
 }
 
@@ -329,9 +337,15 @@ static bool isEqual(const DrawPolygon& v1, const DrawPolygon& v2, DrawDataComp::
     return true;
 }
 
+static DrawText::Mode compMode(DrawText::Mode mode)
+{
+    //! NOTE A symbol is drawn as the text of its code
+    return mode == DrawText::Symbol ? DrawText::Point : mode;
+}
+
 static bool isEqual(const DrawText& v1, const DrawText& v2, DrawDataComp::Tolerance tolerance)
 {
-    if (v1.mode != v2.mode) {
+    if (compMode(v1.mode) != compMode(v2.mode)) {
         return false;
     }
 
@@ -183,6 +183,9 @@ static JsonObject toObj(const DrawData::State& st)
     obj["isAntialiasing"] = st.isAntialiasing;
     obj["transform"] = toArr(st.transform);
     obj["compositionMode"] = static_cast<int>(st.compositionMode);
+    if (st.isClipping) {
+        obj["clipRect"] = toArr(st.clipRect);
+    }
     return obj;
 }
 
@@ -194,6 +197,10 @@ static void fromObj(const JsonObject& obj, DrawData::State& st)
     st.isAntialiasing = obj["isAntialiasing"].toBool();
     fromArr(obj["transform"].toArray(), st.transform);
     st.compositionMode = static_cast<CompositionMode>(obj["compositionMode"].toInt());
+    if (obj.contains("clipRect")) {
+        st.isClipping = true;
+        fromArr(obj["clipRect"].toArray(), st.clipRect);
+    }
 }
 
 static JsonObject toObj(const PainterPath& path)
@@ -313,11 +320,15 @@ static void fromObj(const JsonObject& obj, DrawPolygon& pol)
 static JsonObject toObj(const DrawText& text)
 {
     JsonObject o;
-    if (text.mode == DrawText::Point) {
+    //! NOTE A symbol is written as the text of its code, the format doesn't distinguish them
+    if (text.mode == DrawText::Point || text.mode == DrawText::Workaround || text.mode == DrawText::Symbol) {
         o["point"] = toArr(text.rect.topLeft());
     } else {
         o["rect"] = toArr(text.rect);
     }
+    if (text.mode == DrawText::Workaround) {
+        o["workaround"] = true;
+    }
     o["flags"] = text.flags;
     o["text"] = text.text;
     return o;
@@ -328,7 +339,7 @@ static void fromObj(const JsonObject& obj, DrawText& text)
     if (obj.contains("point")) {
         PointF point;
         fromArr(obj["point"].toArray(), point);
-        text.mode = DrawText::Point;
+        text.mode = obj["workaround"].toBool() ? DrawText::Workaround : DrawText::Point;
         text.rect = RectF(point, SizeF());
     } else {
         fromArr(obj["rect"].toArray(), text.rect);
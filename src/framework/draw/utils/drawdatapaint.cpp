@@ -40,6 +40,14 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
         provider->setPen(st.pen);
         provider->setBrush(st.brush);
         provider->setFont(st.font);
+
+        if (st.isClipping) {
+            provider->setTransform(Transform());
+            provider->setClipRect(st.clipRect);
+        } else if (provider->hasClipping()) {
+            provider->setClipping(false);
+        }
+
         provider->setTransform(st.transform);
         provider->setAntialiasing(st.isAntialiasing);
         provider->setCompositionMode(st.compositionMode);
@@ -60,6 +68,10 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
         for (const DrawText& t : d.texts) {
             if (t.mode == DrawText::Point) {
                 provider->drawText(t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Workaround) {
+                provider->drawTextWorkaround(st.font, t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Symbol) {
+                provider->drawSymbol(t.rect.topLeft(), t.symbolCode());
             } else {
                 provider->drawText(t.rect, t.flags, t.text);
             }
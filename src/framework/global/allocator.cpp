@@ -230,6 +230,18 @@ void AllocatorsRegister::unreg(ObjectAllocator* a)
     m_allocators.remove(a);
 }
 
+void AllocatorsRegister::regArena(MemoryArena* a)
+{
+    std::lock_guard<std::mutex> lock(m_arenasMutex);
+    m_arenas.push_back(a);
+}
+
+void AllocatorsRegister::unregArena(MemoryArena* a)
+{
+    std::lock_guard<std::mutex> lock(m_arenasMutex);
+    m_arenas.remove(a);
+}
+
 void AllocatorsRegister::cleanupAll(const std::string& module)
 {
     for (ObjectAllocator* a : m_allocators) {
@@ -303,5 +315,28 @@ void AllocatorsRegister::printState(const std::string& title)
     stream << "-----------------------------------------------------\n";
     stream << "Total allocated: " << totalBytes << " bytes\n";
 
+    std::lock_guard<std::mutex> lock(m_arenasMutex);
+    if (!m_arenas.empty()) {
+        stream << "\n";
+        stream << "arenas: " << m_arenas.size() << '\n';
+        stream << TITLE("Arena") << TITLE("blockCount") << TITLE("usedObjects") << TITLE("usedBytes") << TITLE("allocatedBytes") << "\n";
+
+        uint64_t totalArenaBytes = 0;
+        for (const MemoryArena* a : m_arenas) {
+            MemoryArena::Info info = a->stateInfo();
+            stream << FORMAT(info.name, 20)
+                   << VALUE(info.blockCount)
+                   << VALUE(info.usedCount())
+                   << VALUE(info.usedBytes)
+                   << VALUE(info.allocatedBytes)
+                   << "\n";
+
+            totalArenaBytes += info.allocatedBytes;
+        }
+
+        stream << "-----------------------------------------------------\n";
+        stream << "Total allocated by arenas: " << totalArenaBytes << " bytes\n";
+    }
+
     LOGD() << stream.str() << '\n';
 }
@@ -25,8 +25,11 @@
 #include <cstdint>
 #include <vector>
 #include <list>
+#include <mutex>
 #include <string>
 
+#include "memoryarena.h"
+
 namespace muse {
 #define OBJECT_ALLOCATOR(Module, ClassName) \
 public: \
@@ -35,10 +38,15 @@ public: \
         return a; \
     } \
     static void* operator new(size_t sz) { \
+        if (muse::MemoryArena::enabled()) { \
+            return muse::MemoryArena::allocate(sz); \
+        } \
         return muse::ObjectAllocator::enabled() ? allocator().alloc(sz) : ::operator new(sz); \
     } \
     static void operator delete(void* ptr) { \
-        if (muse::ObjectAllocator::enabled()) { \
+        if (muse::MemoryArena::enabled()) { \
+            muse::MemoryArena::deallocate(ptr); \
+        } else if (muse::ObjectAllocator::enabled()) { \
             allocator().free(ptr); \
         } else { \
             ::operator delete(ptr); \
@@ -159,6 +167,9 @@ public:
     void reg(ObjectAllocator* a);
     void unreg(ObjectAllocator* a);
 
+    void regArena(MemoryArena* a);
+    void unregArena(MemoryArena* a);
+
     void cleanupAll(const std::string& module);
 
     void printStatistic(const std::string& title);
@@ -166,6 +177,8 @@ public:
 
 private:
     std::list<ObjectAllocator*> m_allocators;
+    std::list<MemoryArena*> m_arenas;
+    std::mutex m_arenasMutex;
 };
 }
 
@@ -0,0 +1,316 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "taskscheduler.h"
+
+using namespace muse;
+
+static constexpr size_t WORKER_QUEUE_CAPACITY = 1024;
+static constexpr size_t SHARED_QUEUE_CAPACITY = 4096;
+
+static thread_local const TaskScheduler* s_workerScheduler = nullptr;
+static thread_local size_t s_workerIdx = 0;
+
+//! NOTE A bounded ring buffer of tasks, guarded by a spin lock:
+//! the critical sections are a few moves, so it is cheaper than a mutex and never sleeps
+class TaskScheduler::WorkQueue
+{
+public:
+    explicit WorkQueue(size_t capacity)
+        : m_tasks(capacity) {}
+
+    bool empty() const
+    {
+        return m_size.load(std::memory_order_relaxed) == 0;
+    }
+
+    //! NOTE The task is moved only if there is room for it
+    bool pushBack(Task& task)
+    {
+        Lock lock(m_lock);
+        size_t size = m_size.load(std::memory_order_relaxed);
+        if (size == m_tasks.size()) {
+            return false;
+        }
+
+        m_tasks[(m_head + size) % m_tasks.size()] = std::move(task);
+        m_size.store(size + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool popBack(Task& task)
+    {
+        if (empty()) {
+            return false;
+        }
+
+        Lock lock(m_lock);
+        size_t size = m_size.load(std::memory_order_relaxed);
+        if (size == 0) {
+            return false;
+        }
+
+        task = std::move(m_tasks[(m_head + size - 1) % m_tasks.size()]);
+        m_size.store(size - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool popFront(Task& task)
+    {
+        if (empty()) {
+            return false;
+        }
+
+        Lock lock(m_lock);
+        size_t size = m_size.load(std::memory_order_relaxed);
+        if (size == 0) {
+            return false;
+        }
+
+        task = std::move(m_tasks[m_head]);
+        m_head = (m_head + 1) % m_tasks.size();
+        m_size.store(size - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    struct Lock {
+        explicit Lock(std::atomic_flag& flag)
+            : m_flag(flag)
+        {
+            while (m_flag.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        ~Lock()
+        {
+            m_flag.clear(std::memory_order_release);
+        }
+
+        std::atomic_flag& m_flag;
+    };
+
+    std::atomic_flag m_lock = ATOMIC_FLAG_INIT;
+    std::vector<Task> m_tasks;
+    size_t m_head = 0;
+    std::atomic<size_t> m_size = 0;
+};
+
+TaskScheduler::TaskScheduler(const thread_pool_size_t desiredThreadCount)
+    : m_threadPoolSize(vaildateThreadPoolCapacity(desiredThreadCount)),
+    m_threadPool(std::make_unique<std::thread[]>(vaildateThreadPoolCapacity(desiredThreadCount)))
+{
+    m_highPriorityQueue = std::make_unique<WorkQueue>(WORKER_QUEUE_CAPACITY);
+    m_sharedQueue = std::make_unique<WorkQueue>(SHARED_QUEUE_CAPACITY);
+    for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+        m_workerQueues.push_back(std::make_unique<WorkQueue>(WORKER_QUEUE_CAPACITY));
+    }
+
+    setupThreads();
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    waitForAllTasksComplete();
+    terminateThreads();
+}
+
+void TaskScheduler::schedule(Task&& task, TaskPriority priority)
+{
+    m_queuedCount.fetch_add(1);
+
+    bool pushed = false;
+    if (priority == TaskPriority::High) {
+        pushed = m_highPriorityQueue->pushBack(task);
+    } else {
+        if (s_workerScheduler == this) {
+            pushed = m_workerQueues[s_workerIdx]->pushBack(task);
+        }
+
+        if (!pushed) {
+            pushed = m_sharedQueue->pushBack(task);
+        }
+    }
+
+    if (!pushed) {
+        //! NOTE The queue is full, so run the task here
+        m_runningCount.fetch_add(1);
+        m_queuedCount.fetch_sub(1);
+        runTask(task);
+        return;
+    }
+
+    wakeUpWorker();
+}
+
+void TaskScheduler::waitForAllTasksComplete()
+{
+    while (m_queuedCount.load() > 0 || m_runningCount.load() > 0) {
+        if (!tryRunPendingTask(TaskPriority::Normal)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskScheduler::setupThreads()
+{
+    m_isActive = true;
+    for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+        m_threadPool[i] = std::thread(&TaskScheduler::th_workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+void TaskScheduler::terminateThreads()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_isActive = false;
+    }
+
+    m_newTaskAvailableCv.notify_all();
+    for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+        m_threadPool[i].join();
+    }
+}
+
+thread_pool_size_t TaskScheduler::vaildateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount)
+{
+    thread_pool_size_t maxCapacity = std::thread::hardware_concurrency();
+
+    if (maxCapacity <= 1) {
+        return 1;
+    }
+
+    thread_pool_size_t optimalCapacity = maxCapacity / 2;
+
+    if (desiredThreadCount <= 0) {
+        return optimalCapacity;
+    }
+
+    return desiredThreadCount;
+}
+
+bool TaskScheduler::tryRunPendingTask(TaskPriority priority)
+{
+    Task task;
+    if (!popTask(task, priority)) {
+        return false;
+    }
+
+    runTask(task);
+    return true;
+}
+
+bool TaskScheduler::popTask(Task& task, TaskPriority priority)
+{
+    if (m_queuedCount.load() == 0) {
+        return false;
+    }
+
+    const bool isWorker = s_workerScheduler == this;
+
+    //! NOTE High priority tasks (e.g. audio processing) must only run on the pool workers
+    //! or on threads that wait for them, not on a thread that waits for a normal group
+    bool found = false;
+    if (isWorker || priority == TaskPriority::High) {
+        found = m_highPriorityQueue->popFront(task);
+    }
+
+    if (!found && priority == TaskPriority::Normal) {
+        if (isWorker) {
+            found = m_workerQueues[s_workerIdx]->popBack(task);
+        }
+
+        if (!found) {
+            found = m_sharedQueue->popFront(task);
+        }
+
+        // steal
+        const size_t workerCount = m_workerQueues.size();
+        const size_t startIdx = isWorker ? s_workerIdx + 1 : 0;
+        for (size_t i = 0; i < workerCount && !found; ++i) {
+            found = m_workerQueues[(startIdx + i) % workerCount]->popFront(task);
+        }
+    }
+
+    if (found) {
+        //! NOTE Counted as running before it is not queued anymore, see waitForAllTasksComplete
+        m_runningCount.fetch_add(1);
+        m_queuedCount.fetch_sub(1);
+    }
+
+    return found;
+}
+
+void TaskScheduler::runTask(Task& task)
+{
+    TaskGroup* group = task.group();
+
+    std::exception_ptr exception;
+    try {
+        task.run();
+    } catch (...) {
+        exception = std::current_exception();
+        if (!group) {
+            LOGE() << "Unhandled exception in a task";
+        }
+    }
+
+    task.reset();
+
+    m_runningCount.fetch_sub(1);
+
+    if (group) {
+        group->taskFinished(exception);
+    }
+}
+
+void TaskScheduler::wakeUpWorker()
+{
+    if (m_sleepingCount.load() == 0) {
+        return;
+    }
+
+    {
+        //! NOTE Don't notify between the check and the wait of a worker
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+
+    m_newTaskAvailableCv.notify_one();
+}
+
+void TaskScheduler::th_workerLoop(size_t workerIdx)
+{
+    s_workerScheduler = this;
+    s_workerIdx = workerIdx;
+
+    while (m_isActive) {
+        if (tryRunPendingTask(TaskPriority::Normal)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingCount.fetch_add(1);
+        m_newTaskAvailableCv.wait(lock, [this] { return m_queuedCount.load() > 0 || !m_isActive; });
+        m_sleepingCount.fetch_sub(1);
+    }
+}
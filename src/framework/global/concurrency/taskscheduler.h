@@ -24,93 +24,207 @@
 #define MUSE_GLOBAL_TASKCHEDULER_H
 
 #include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <atomic>
-#include <queue>
+#include <new>
+#include <set>
 #include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "log.h"
 
 namespace muse {
 typedef std::invoke_result_t<decltype(std::thread::hardware_concurrency)> thread_pool_size_t;
 
-class TaskScheduler
+class TaskGroup;
+
+enum class TaskPriority {
+    Normal = 0,
+    //! NOTE Real-time work (e.g. audio processing); runs before all normal tasks
+    High
+};
+
+//! NOTE A type-erased callable with inline storage,
+//! so scheduling a small task (e.g. a lambda with a few captures) doesn't allocate
+class Task
 {
 public:
+    static constexpr size_t INLINE_SIZE = 48;
 
-    //!Note Would be moved into globalmodule.cpp for better lifetime control
-    static TaskScheduler* instance()
+    Task() = default;
+
+    template<typename FuncT, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FuncT>, Task> > >
+    Task(FuncT&& func, TaskGroup* group = nullptr)
+        : m_group(group)
     {
-        static TaskScheduler s;
-        return &s;
+        using F = std::decay_t<FuncT>;
+        if constexpr (isInline<F>) {
+            new (&m_storage) F(std::forward<FuncT>(func));
+            m_ops = &InlineOps<F>::ops;
+        } else {
+            *reinterpret_cast<F**>(&m_storage) = new F(std::forward<FuncT>(func));
+            m_ops = &HeapOps<F>::ops;
+        }
+    }
+
+    Task(Task&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        reset();
+    }
+
+    bool isValid() const { return m_ops != nullptr; }
+    TaskGroup* group() const { return m_group; }
+
+    void run()
+    {
+        m_ops->invoke(&m_storage);
     }
 
-    explicit TaskScheduler(const thread_pool_size_t desiredThreadCount = 0)
-        : m_threadPoolSize(vaildateThreadPoolCapacity(desiredThreadCount)),
-        m_threadPool(std::make_unique<std::thread[]>(vaildateThreadPoolCapacity(desiredThreadCount)))
+    void reset()
     {
-        setupThreads();
+        if (m_ops) {
+            m_ops->destroy(&m_storage);
+            m_ops = nullptr;
+        }
+        m_group = nullptr;
     }
 
-    ~TaskScheduler()
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src); // move to dst and destroy src
+        void (*destroy)(void* storage);
+    };
+
+    template<typename F>
+    static constexpr bool isInline = sizeof(F) <= INLINE_SIZE
+                                     && alignof(F) <= alignof(std::max_align_t)
+                                     && std::is_nothrow_move_constructible_v<F>;
+
+    template<typename F>
+    struct InlineOps {
+        static F* get(void* s) { return std::launder(reinterpret_cast<F*>(s)); }
+        static void invoke(void* s) { (*get(s))(); }
+        static void move(void* dst, void* src)
+        {
+            new (dst) F(std::move(*get(src)));
+            get(src)->~F();
+        }
+
+        static void destroy(void* s) { get(s)->~F(); }
+        static constexpr Ops ops { &invoke, &move, &destroy };
+    };
+
+    template<typename F>
+    struct HeapOps {
+        static F*& get(void* s) { return *reinterpret_cast<F**>(s); }
+        static void invoke(void* s) { (*get(s))(); }
+        static void move(void* dst, void* src) { *reinterpret_cast<F**>(dst) = get(src); }
+        static void destroy(void* s) { delete get(s); }
+        static constexpr Ops ops { &invoke, &move, &destroy };
+    };
+
+    void moveFrom(Task& other)
     {
-        waitForAllTasksComplete();
-        terminateThreads();
+        m_ops = other.m_ops;
+        m_group = other.m_group;
+        if (m_ops) {
+            m_ops->move(&m_storage, &other.m_storage);
+        }
+        other.m_ops = nullptr;
+        other.m_group = nullptr;
+    }
+
+    std::aligned_storage_t<INLINE_SIZE, alignof(std::max_align_t)> m_storage;
+    const Ops* m_ops = nullptr;
+    TaskGroup* m_group = nullptr;
+};
+
+//! NOTE Work-stealing thread pool.
+//! Every worker has its own queue: tasks scheduled from a worker go to its queue and
+//! idle workers steal from the others. Tasks scheduled from other threads go to a shared queue.
+//! High priority tasks have their own queue, which is checked first.
+//! The queues have a fixed capacity and don't allocate; if a queue is full, the task is run by the caller.
+class TaskScheduler
+{
+public:
+
+    //!Note Would be moved into globalmodule.cpp for better lifetime control
+    static TaskScheduler* instance()
+    {
+        static TaskScheduler s;
+        return &s;
     }
 
+    explicit TaskScheduler(const thread_pool_size_t desiredThreadCount = 0);
+    ~TaskScheduler();
+
     thread_pool_size_t threadPoolSize() const
     {
         return m_threadPoolSize;
     }
 
+    void schedule(Task&& task, TaskPriority priority = TaskPriority::Normal);
+
     template<typename FuncT, typename ... ArgsT>
     void push(FuncT&& task, ArgsT&&... args)
     {
-        std::function<void()> taskFunctor = std::bind(std::forward<FuncT>(task), std::forward<ArgsT>(args)...);
-        {
-            const std::lock_guard lock(m_mutex);
-            m_taskQueue.push(taskFunctor);
-        }
-        m_newTaskAvailableCv.notify_one();
+        schedule(Task(bindArgs(std::forward<FuncT>(task), std::forward<ArgsT>(args)...)));
     }
 
+    //! NOTE Allocates the shared state of the future; use TaskGroup for allocation-free scheduling
     template<typename FuncT, typename ... ArgsT, typename ReturnT = std::invoke_result_t<std::decay_t<FuncT>, std::decay_t<ArgsT>...> >
     std::future<ReturnT> submit(FuncT&& task, ArgsT&&... args)
     {
-        std::function<ReturnT()> taskFunctor = std::bind(std::forward<FuncT>(task), std::forward<ArgsT>(args)...);
-        std::shared_ptr<std::promise<ReturnT> > promise = std::make_shared<std::promise<ReturnT> >();
-        push([taskFunctor, promise] {
+        std::promise<ReturnT> promise;
+        std::future<ReturnT> future = promise.get_future();
+
+        schedule(Task([func = bindArgs(std::forward<FuncT>(task), std::forward<ArgsT>(args)...), promise = std::move(promise)]() mutable {
             try {
                 if constexpr (std::is_void_v<ReturnT>) {
-                    std::invoke(taskFunctor);
-                    promise->set_value();
+                    func();
+                    promise.set_value();
                 } else {
-                    promise->set_value(std::invoke(taskFunctor));
+                    promise.set_value(func());
                 }
             } catch (...) {
                 try {
-                    promise->set_exception(std::current_exception());
+                    promise.set_exception(std::current_exception());
                 } catch (...) {
                     LOGE() << "Unable to schedule a task";
                 }
             }
-        });
+        }));
 
-        return promise->get_future();
+        return future;
     }
 
-    void waitForAllTasksComplete()
-    {
-        m_isWaitingForAllTasksDone = true;
-        std::unique_lock<std::mutex> tasks_lock(m_mutex);
-        m_taskFinishedCv.wait(tasks_lock, [this] { return m_taskQueue.empty(); });
-        m_isWaitingForAllTasksDone = false;
-    }
+    void waitForAllTasksComplete();
 
     const std::set<std::thread::id>& threadIdSet() const
     {
@@ -132,73 +246,119 @@ public:
     }
 
 private:
-    void setupThreads()
-    {
-        m_isActive = true;
-        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
-            m_threadPool[i] = std::thread(&TaskScheduler::th_workerLoop, this);
-        }
-    }
+    friend class TaskGroup;
+
+    class WorkQueue;
 
-    void terminateThreads()
+    template<typename FuncT, typename ... ArgsT>
+    static auto bindArgs(FuncT&& func, ArgsT&&... args)
     {
-        m_isActive = false;
-        m_newTaskAvailableCv.notify_all();
-        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
-            m_threadPool[i].join();
+        if constexpr (sizeof...(ArgsT) == 0) {
+            return std::forward<FuncT>(func);
+        } else {
+            return [func = std::forward<FuncT>(func), args = std::make_tuple(std::forward<ArgsT>(args)...)]() mutable {
+                return std::apply(func, args);
+            };
         }
     }
 
-    thread_pool_size_t vaildateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount)
-    {
-        thread_pool_size_t maxCapacity = std::thread::hardware_concurrency();
+    void setupThreads();
+    void terminateThreads();
+    thread_pool_size_t vaildateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount);
 
-        if (maxCapacity <= 1) {
-            return 1;
-        }
+    //! NOTE Runs one of the scheduled tasks on the calling thread, returns false if there are none.
+    //! With the High priority, only high priority tasks are taken;
+    //! with the Normal priority, high priority tasks are taken only by the pool workers
+    bool tryRunPendingTask(TaskPriority priority);
 
-        thread_pool_size_t optimalCapacity = maxCapacity / 2;
+    bool popTask(Task& task, TaskPriority priority);
+    void runTask(Task& task);
+    void wakeUpWorker();
 
-        if (desiredThreadCount <= 0) {
-            return optimalCapacity;
-        }
+    void th_workerLoop(size_t workerIdx);
 
-        return desiredThreadCount;
-    }
+    std::atomic<bool> m_isActive = false;
+
+    std::atomic<size_t> m_queuedCount = 0;
+    std::atomic<size_t> m_runningCount = 0;
+    std::atomic<size_t> m_sleepingCount = 0;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_newTaskAvailableCv;
+
+    std::unique_ptr<WorkQueue> m_highPriorityQueue;
+    std::unique_ptr<WorkQueue> m_sharedQueue;
+    std::vector<std::unique_ptr<WorkQueue> > m_workerQueues;
+
+    thread_pool_size_t m_threadPoolSize = 0;
+    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+};
+
+//! NOTE A set of tasks that can be waited for.
+//! The waiting thread doesn't block: it runs scheduled tasks until the group is done.
+//! If a task throws, wait() rethrows the first exception.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(TaskPriority priority = TaskPriority::Normal, TaskScheduler* scheduler = TaskScheduler::instance())
+        : m_scheduler(scheduler), m_priority(priority) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
 
-    void th_workerLoop()
+    ~TaskGroup()
     {
-        while (m_isActive) {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_newTaskAvailableCv.wait(lock, [this] { return !m_taskQueue.empty() || !m_isActive; });
+        waitForPending();
+    }
 
-            if (!m_isActive) {
-                return;
-            }
+    template<typename FuncT>
+    void run(FuncT&& func)
+    {
+        m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+        m_scheduler->schedule(Task(std::forward<FuncT>(func), this), m_priority);
+    }
 
-            std::function<void()> task = m_taskQueue.front();
-            m_taskQueue.pop();
+    void wait()
+    {
+        waitForPending();
 
-            lock.unlock();
+        if (m_exception) {
+            std::exception_ptr e = std::move(m_exception);
+            m_exception = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
 
-            task();
+private:
+    friend class TaskScheduler;
 
-            if (m_isWaitingForAllTasksDone) {
-                m_taskFinishedCv.notify_one();
+    void waitForPending()
+    {
+        while (m_pendingCount.load(std::memory_order_acquire) > 0) {
+            if (!m_scheduler->tryRunPendingTask(m_priority)) {
+                std::this_thread::yield();
             }
         }
     }
 
-    std::atomic<bool> m_isActive = false;
-    std::atomic<bool> m_isWaitingForAllTasksDone = false;
+    void taskFinished(std::exception_ptr e)
+    {
+        if (e) {
+            std::lock_guard<std::mutex> lock(m_exceptionMutex);
+            if (!m_exception) {
+                m_exception = e;
+            }
+        }
 
-    mutable std::mutex m_mutex;
-    std::condition_variable m_newTaskAvailableCv;
-    std::condition_variable m_taskFinishedCv;
-    std::queue<std::function<void()> > m_taskQueue;
+        //! NOTE Must be the last access to the group, it can be destroyed right after
+        m_pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+    }
 
-    thread_pool_size_t m_threadPoolSize = 0;
-    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+    TaskScheduler* m_scheduler = nullptr;
+    TaskPriority m_priority = TaskPriority::Normal;
+    std::atomic<size_t> m_pendingCount = 0;
+    std::mutex m_exceptionMutex;
+    std::exception_ptr m_exception;
 };
 }
 
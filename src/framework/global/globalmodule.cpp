@@ -29,6 +29,7 @@
 #include "logger.h"
 #include "logremover.h"
 #include "profiler.h"
+#include "tracer.h"
 
 #include "internal/baseapplication.h"
 #include "internal/invoker.h"
@@ -209,6 +210,12 @@ void GlobalModule::onPreInit(const IApplication::RunMode& mode)
     Profiler* profiler = Profiler::instance();
     profiler->setup(profOpt, new MyPrinter());
 
+    //! --- Setup tracer ---
+    if (m_traceFilePath) {
+        LOGI() << "tracing enabled, trace path: " << m_traceFilePath.value();
+        Tracer::setEnabled(true);
+    }
+
     //! --- Setup Invoker ---
 
     Invoker::setup();
@@ -259,6 +266,13 @@ void GlobalModule::onDeinit()
 {
     invokeQueuedCalls();
 
+    if (m_traceFilePath) {
+        Tracer::setEnabled(false);
+        if (!Tracer::save(m_traceFilePath.value().toStdString())) {
+            LOGE() << "failed save trace: " << m_traceFilePath.value();
+        }
+    }
+
 #ifdef Q_OS_WIN
     if (m_endTimePeriod) {
         timeEndPeriod(1);
@@ -275,3 +289,8 @@ void GlobalModule::setLoggerLevel(const muse::logger::Level& level)
 {
     m_loggerLevel = level;
 }
+
+void GlobalModule::setTraceFilePath(const io::path_t& path)
+{
+    m_traceFilePath = path;
+}
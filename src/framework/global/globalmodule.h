@@ -55,11 +55,15 @@ public:
 
     void setLoggerLevel(const muse::logger::Level& level);
 
+    //! NOTE Trace from the start, save on exit (see Tracer)
+    void setTraceFilePath(const io::path_t& path);
+
 private:
     std::shared_ptr<GlobalConfiguration> m_configuration;
     std::shared_ptr<SystemInfo> m_systemInfo;
 
     std::optional<muse::logger::Level> m_loggerLevel;
+    std::optional<io::path_t> m_traceFilePath;
 
     static std::shared_ptr<Invoker> s_asyncInvoker;
 
@@ -0,0 +1,286 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "memoryarena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#include "allocator.h"
+
+#include "log.h"
+
+using namespace muse;
+
+#ifdef MUSE_ENABLE_ARENA_ALLOCATOR
+const bool MemoryArena::s_enabled = true;
+#else
+const bool MemoryArena::s_enabled = false;
+#endif
+
+size_t MemoryArena::DEFAULT_BLOCK_SIZE(1024 * 1024); // 1 MB
+
+static thread_local MemoryArena* s_current = nullptr;
+
+static inline size_t alignSize(size_t n, size_t alignment)
+{
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+MemoryArena::MemoryArena(const std::string& name)
+    : m_ownerThread(std::this_thread::get_id()), m_name(name)
+{
+    AllocatorsRegister::instance()->regArena(this);
+}
+
+MemoryArena::~MemoryArena()
+{
+    AllocatorsRegister::instance()->unregArena(this);
+
+    if (s_current == this) {
+        s_current = nullptr;
+    }
+
+    //! NOTE The objects left would point to the freed memory
+    assert(m_totalAllocatedCount == m_totalFreeCount);
+
+    for (uint8_t* b : m_blocks) {
+        std::free(b);
+    }
+}
+
+void MemoryArena::release(MemoryArena* arena)
+{
+    if (!arena) {
+        return;
+    }
+
+    const uint64_t usedCount = arena->m_totalAllocatedCount - arena->m_totalFreeCount;
+    if (usedCount > 0) {
+        LOGW() << "arena: " << arena->name() << ", objects not deleted: " << usedCount << ", the arena is detached";
+    }
+
+    //! NOTE Destroyed here or by the last free
+    arena->unref();
+}
+
+const std::string& MemoryArena::name() const
+{
+    return m_name;
+}
+
+void MemoryArena::setName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_nameMutex);
+    m_name = name;
+}
+
+MemoryArena* MemoryArena::current()
+{
+    return s_current;
+}
+
+void MemoryArena::setCurrent(MemoryArena* arena)
+{
+    s_current = arena;
+}
+
+void* MemoryArena::allocate(size_t size)
+{
+    if (s_current) {
+        return s_current->alloc(size);
+    }
+
+    return heapAlloc(size);
+}
+
+void MemoryArena::deallocate(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    Header* h = reinterpret_cast<Header*>(ptr) - 1;
+    if (h->arena) {
+        h->arena->free(ptr);
+    } else {
+        std::free(h);
+    }
+}
+
+void* MemoryArena::heapAlloc(size_t size)
+{
+    Header* h = reinterpret_cast<Header*>(std::malloc(sizeof(Header) + size));
+    if (!h) {
+        throw std::bad_alloc();
+    }
+
+    h->arena = nullptr;
+    h->size = size;
+    return h + 1;
+}
+
+void* MemoryArena::alloc(size_t size)
+{
+    //! NOTE The blocks and the free lists are not locked, they belong to the owner thread
+    if (!isOwnerThread()) {
+        return heapAlloc(size);
+    }
+
+    const size_t chunkSize = alignSize(sizeof(Header) + size, ALIGNMENT);
+
+    Header* h = reinterpret_cast<Header*>(allocChunk(chunkSize));
+    h->arena = this;
+    h->size = chunkSize;
+
+    m_refs.fetch_add(1, std::memory_order_relaxed);
+    m_usedBytes.fetch_add(chunkSize, std::memory_order_relaxed);
+    m_totalAllocatedCount.fetch_add(1, std::memory_order_relaxed);
+
+    return h + 1;
+}
+
+void MemoryArena::free(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    Header* h = reinterpret_cast<Header*>(ptr) - 1;
+    if (!h->arena) {
+        std::free(h);
+        return;
+    }
+
+    assert(h->arena == this);
+
+    const size_t chunkSize = h->size;
+
+    //! NOTE Big chunks are not reused, they are released together with the arena
+    if (chunkSize <= MAX_CHUNK_SIZE) {
+        Chunk* chunk = reinterpret_cast<Chunk*>(h);
+        if (isOwnerThread()) {
+            pushFree(chunk, chunkSize);
+        } else {
+            //! NOTE Chunk::next overlaps Header::arena only, the size is kept for the owner
+            chunk->next = m_remoteFree.load(std::memory_order_relaxed);
+            while (!m_remoteFree.compare_exchange_weak(chunk->next, chunk, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    m_usedBytes.fetch_sub(chunkSize, std::memory_order_relaxed);
+    m_totalFreeCount.fetch_add(1, std::memory_order_relaxed);
+
+    unref();
+}
+
+void MemoryArena::unref()
+{
+    if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void MemoryArena::pushFree(Chunk* chunk, size_t chunkSize)
+{
+    if (m_free.empty()) {
+        m_free.resize(MAX_CHUNK_SIZE / ALIGNMENT + 1, nullptr);
+    }
+
+    size_t idx = chunkSize / ALIGNMENT;
+    chunk->next = m_free[idx];
+    m_free[idx] = chunk;
+}
+
+void MemoryArena::takeRemoteFree()
+{
+    Chunk* chunk = m_remoteFree.exchange(nullptr, std::memory_order_acquire);
+    while (chunk) {
+        Chunk* next = chunk->next;
+        pushFree(chunk, reinterpret_cast<Header*>(chunk)->size);
+        chunk = next;
+    }
+}
+
+void* MemoryArena::allocChunk(size_t chunkSize)
+{
+    if (chunkSize <= MAX_CHUNK_SIZE) {
+        if (m_free.empty()) {
+            m_free.resize(MAX_CHUNK_SIZE / ALIGNMENT + 1, nullptr);
+        }
+
+        size_t idx = chunkSize / ALIGNMENT;
+        if (!m_free[idx] && m_remoteFree.load(std::memory_order_relaxed)) {
+            takeRemoteFree();
+        }
+
+        if (Chunk* chunk = m_free[idx]) {
+            m_free[idx] = chunk->next;
+            return chunk;
+        }
+    }
+
+    if (static_cast<size_t>(m_end - m_pos) < chunkSize) {
+        allocateBlock(chunkSize);
+    }
+
+    // Bump the allocation pointer
+    void* chunk = m_pos;
+    m_pos += chunkSize;
+    return chunk;
+}
+
+void MemoryArena::allocateBlock(size_t minSize)
+{
+    size_t blockSize = std::max(DEFAULT_BLOCK_SIZE, minSize);
+
+    uint8_t* block = reinterpret_cast<uint8_t*>(std::malloc(blockSize));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+
+    //! NOTE The rest of the previous block is not used
+    m_blocks.push_back(block);
+    m_pos = block;
+    m_end = block + blockSize;
+    m_blockCount.fetch_add(1, std::memory_order_relaxed);
+    m_allocatedBytes.fetch_add(blockSize, std::memory_order_relaxed);
+}
+
+MemoryArena::Info MemoryArena::stateInfo() const
+{
+    Info info;
+    {
+        std::lock_guard<std::mutex> lock(m_nameMutex);
+        info.name = m_name;
+    }
+
+    info.blockCount = m_blockCount;
+    info.allocatedBytes = m_allocatedBytes;
+    info.usedBytes = m_usedBytes;
+    info.totalAllocatedCount = m_totalAllocatedCount;
+    info.totalFreeCount = m_totalFreeCount;
+
+    return info;
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_GLOBAL_MEMORYARENA_H
+#define MUSE_GLOBAL_MEMORYARENA_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace muse {
+//! NOTE A region of memory owned by a document (for example, an engraving project).
+//! Objects declared with OBJECT_ALLOCATOR, which are created while the arena is current
+//! (see MemoryArena::Scope), are placed in its blocks. This keeps the objects of one document
+//! close to each other in memory, makes their deletion cheap (a chunk is only put back in a free list)
+//! and releases all memory at once when the arena is destroyed.
+//!
+//! Every chunk has a small header with the owning arena, so an object can be deleted
+//! at any time, from any scope. Objects created when no arena is current are allocated on the heap,
+//! with the same header.
+//!
+//! The objects are still destroyed one by one (their destructors release what they own on the heap
+//! and unlink them from other objects), only the memory of the arena itself is released at once.
+//!
+//! An arena belongs to the thread which created it, which allocates and frees without locking.
+//! The chunks freed on other threads are passed back to it through a lock-free list.
+//! Allocations on other threads (with the arena current there) go to the heap.
+//!
+//! Arenas are off by default, they are enabled with the MUSE_ENABLE_ARENA_ALLOCATOR build option.
+class MemoryArena
+{
+public:
+
+    explicit MemoryArena(const std::string& name);
+
+    //! NOTE All the objects of the arena must be deleted before, see release()
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    static size_t DEFAULT_BLOCK_SIZE;
+
+    //! NOTE Fixed at build time: the objects allocated in an arena and on the heap are deleted differently
+    static bool enabled() { return s_enabled; }
+
+    //! NOTE Destroys the arena. If some of its objects are still alive, the arena is detached
+    //! from its owner instead: it keeps its blocks and is destroyed when the last of them is deleted
+    static void release(MemoryArena* arena);
+
+    const std::string& name() const;
+    void setName(const std::string& name);
+
+    void* alloc(size_t size);
+    void free(void* ptr);
+
+    //! NOTE Allocate in the current arena (if any) or on the heap
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr);
+
+    static MemoryArena* current();
+    static void setCurrent(MemoryArena* arena);
+
+    class Scope
+    {
+    public:
+        explicit Scope(MemoryArena* arena)
+            : m_prev(MemoryArena::current())
+        {
+            MemoryArena::setCurrent(arena);
+        }
+
+        ~Scope()
+        {
+            MemoryArena::setCurrent(m_prev);
+        }
+
+    private:
+        MemoryArena* m_prev = nullptr;
+    };
+
+    struct Info
+    {
+        std::string name;
+        size_t blockCount = 0;
+        size_t allocatedBytes = 0;
+        size_t usedBytes = 0;
+
+        uint64_t totalAllocatedCount = 0;
+        uint64_t totalFreeCount = 0;
+
+        uint64_t usedCount() const { return totalAllocatedCount - totalFreeCount; }
+    };
+
+    Info stateInfo() const;
+
+private:
+
+    struct Header {
+        MemoryArena* arena = nullptr;
+        size_t size = 0;
+    };
+
+    struct Chunk {
+        Chunk* next = nullptr;
+    };
+
+    static constexpr size_t ALIGNMENT = sizeof(Header);
+    static constexpr size_t MAX_CHUNK_SIZE = 4096;
+
+    static const bool s_enabled;
+
+    static void* heapAlloc(size_t size);
+
+    bool isOwnerThread() const { return std::this_thread::get_id() == m_ownerThread; }
+
+    void* allocChunk(size_t chunkSize);
+    void allocateBlock(size_t minSize);
+    void pushFree(Chunk* chunk, size_t chunkSize);
+    void takeRemoteFree();
+    void unref();
+
+    const std::thread::id m_ownerThread;
+
+    mutable std::mutex m_nameMutex;
+    std::string m_name;
+
+    // used only on the owner thread
+    std::vector<uint8_t*> m_blocks;
+    uint8_t* m_pos = nullptr;
+    uint8_t* m_end = nullptr;
+    std::vector<Chunk*> m_free; // by chunk size / ALIGNMENT
+
+    std::atomic<Chunk*> m_remoteFree = nullptr; // freed on other threads, taken back by the owner
+    std::atomic<uint64_t> m_refs = 1; // the owner and every live object
+
+    std::atomic<size_t> m_blockCount = 0;
+    std::atomic<size_t> m_allocatedBytes = 0;
+    std::atomic<size_t> m_usedBytes = 0;
+    std::atomic<uint64_t> m_totalAllocatedCount = 0;
+    std::atomic<uint64_t> m_totalFreeCount = 0;
+};
+}
+
+#endif // MUSE_GLOBAL_MEMORYARENA_H
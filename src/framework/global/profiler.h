@@ -22,6 +22,21 @@
 #ifndef MU_PROFILER_H
 #define MU_PROFILER_H
 
+#include "tracer.h" // IWYU pragma: export
+
+#ifdef KORS_PROFILER_ENABLED
+//! NOTE Function markers go to the tracer too (if it's enabled)
+#define TRACEFUNC \
+    static std::string __func_info(CLASSFUNC); \
+    kors::profiler::FuncMarker __funcMarker(__func_info); \
+    muse::TraceScope __funcTraceScope(__func_info.c_str());
+
+#define TRACEFUNC_C(info) \
+    static std::string __func_info(info); \
+    kors::profiler::FuncMarker __funcMarkerInfo(__func_info); \
+    muse::TraceScope __funcTraceScopeInfo(__func_info.c_str());
+#endif
+
 #include "thirdparty/kors_profiler/profiler/profiler.h" // IWYU pragma: export
 
 namespace muse::profiler {
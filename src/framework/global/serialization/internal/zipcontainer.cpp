@@ -23,6 +23,7 @@
 
 #include <ctime>
 #include <cstring>
+#include <mutex>
 #include <zlib.h>
 
 #include "global/io/dir.h"
@@ -149,6 +150,49 @@ static int inflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourc
     return err;
 }
 
+//! NOTE Inflates until the output is full, the rest of the input is left
+static int inflatePrefix(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourceLen)
+{
+    z_stream stream;
+    int err;
+
+    stream.next_in = const_cast<Bytef*>(source);
+    stream.avail_in = (uInt)sourceLen;
+    if ((uLong)stream.avail_in != sourceLen) {
+        return Z_BUF_ERROR;
+    }
+
+    stream.next_out = dest;
+    stream.avail_out = (uInt) * destLen;
+    if ((uLong)stream.avail_out != *destLen) {
+        return Z_BUF_ERROR;
+    }
+
+    stream.zalloc = (alloc_func)0;
+    stream.zfree = (free_func)0;
+
+    err = inflateInit2(&stream, -MAX_WBITS);
+    if (err != Z_OK) {
+        return err;
+    }
+
+    err = inflate(&stream, Z_SYNC_FLUSH);
+    *destLen = stream.total_out;
+    const bool isOutputFull = stream.avail_out == 0;
+
+    inflateEnd(&stream);
+
+    if (err == Z_STREAM_END || err == Z_OK || (err == Z_BUF_ERROR && isOutputFull)) {
+        return Z_OK;
+    }
+
+    if (err == Z_NEED_DICT || err == Z_BUF_ERROR) {
+        return Z_DATA_ERROR;
+    }
+
+    return err;
+}
+
 static int deflate(Bytef* dest, ulong* destLen, const Bytef* source, ulong sourceLen)
 {
     z_stream stream;
@@ -372,6 +416,10 @@ LocalFileHeader CentralFileHeader::toLocalHeader() const
 struct ZipContainer::Impl {
     IODevice* device = nullptr;
 
+    //! NOTE Guards the device and the file tree, so files can be read from several threads;
+    //! decompression is done outside of the lock
+    std::mutex readMutex;
+
     bool dirtyFileTree = true;
     std::vector<FileHeader> fileHeaders;
     ByteArray comment;
@@ -384,7 +432,7 @@ struct ZipContainer::Impl {
         Directory, File, Symlink
     };
 
-    void addEntry(EntryType type, const std::string& fileName, const ByteArray& contents);
+    void addEntry(EntryType type, const std::string& fileName, const PackedFile& file);
     bool writeToDevice(const uint8_t* data, size_t len);
     bool writeToDevice(const ByteArray& data);
 
@@ -559,7 +607,7 @@ ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(size_t index) const
     return fileInfo;
 }
 
-void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const ByteArray& contents)
+void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, const PackedFile& file)
 {
     if (!(device->isOpen() || device->open(IODevice::WriteOnly))) {
         status = ZipContainer::FileOpenError;
@@ -567,22 +615,12 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     }
     device->seek(start_of_directory);
 
-    // don't compress small files
-    ZipContainer::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == ZipContainer::AutoCompress) {
-        if (contents.size() < 64) {
-            compression = ZipContainer::NeverCompress;
-        } else {
-            compression = ZipContainer::AlwaysCompress;
-        }
-    }
-
     FileHeader header;
     std::memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, (uint)contents.size());
+    writeUInt(header.h.uncompressed_size, (uint)file.uncompressedSize);
 
     std::time_t t = std::time(0);   // get time now
     std::tm now;
@@ -592,37 +630,9 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     localtime_r(&t, &now);
 #endif
     writeMSDosDate(header.h.last_mod_file, now);
-    ByteArray data = contents;
-    if (compression == ZipContainer::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-        ulong len = (ulong)contents.size();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uint8_t*)data.data(), &len, (const uint8_t*)contents.constData(), (ulong)contents.size());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.size() > contents.size().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, (uint)data.size());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uint8_t*)contents.constData(), (uint)contents.size());
-    writeUInt(header.h.crc_32, crc_32);
+    writeUShort(header.h.compression_method, (ushort)file.compressionMethod);
+    writeUInt(header.h.compressed_size, (uint)file.data.size());
+    writeUInt(header.h.crc_32, file.crc);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -673,7 +683,7 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     LocalFileHeader h = header.h.toLocalHeader();
     ok &= writeToDevice((const uint8_t*)&h, sizeof(LocalFileHeader));
     ok &= writeToDevice(header.file_name);
-    ok &= writeToDevice(data);
+    ok &= writeToDevice(file.data);
 
     start_of_directory = (uint)device->pos();
     dirtyFileTree = true;
@@ -707,6 +717,7 @@ ZipContainer::~ZipContainer()
 
 std::vector<ZipContainer::FileInfo> ZipContainer::fileInfoList() const
 {
+    std::lock_guard<std::mutex> lock(p->readMutex);
     p->scanFiles();
     std::vector<FileInfo> files;
     const size_t numFileHeaders = p->fileHeaders.size();
@@ -719,12 +730,14 @@ std::vector<ZipContainer::FileInfo> ZipContainer::fileInfoList() const
 
 int ZipContainer::count() const
 {
+    std::lock_guard<std::mutex> lock(p->readMutex);
     p->scanFiles();
     return (int)p->fileHeaders.size();
 }
 
 bool ZipContainer::fileExists(const std::string& fileName) const
 {
+    std::lock_guard<std::mutex> lock(p->readMutex);
     p->scanFiles();
     ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
     for (size_t i = 0; i < p->fileHeaders.size(); ++i) {
@@ -737,6 +750,12 @@ bool ZipContainer::fileExists(const std::string& fileName) const
 
 ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
+    return unpack(packedFileData(fileName));
+}
+
+ZipContainer::PackedFile ZipContainer::packedFileData(const std::string& fileName) const
+{
+    std::lock_guard<std::mutex> lock(p->readMutex);
     p->scanFiles();
 
     ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
@@ -749,7 +768,7 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
     }
 
     if (i == p->fileHeaders.size()) {
-        return ByteArray();
+        return PackedFile();
     }
 
     FileHeader header = p->fileHeaders.at(i);
@@ -757,7 +776,7 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         LOGW("Zip: .ZIP specification version %d implementation is needed to extract the data.", version_needed);
-        return ByteArray();
+        return PackedFile();
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
@@ -771,29 +790,36 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
     uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
     p->device->seek(p->device->pos() + skip);
 
-    int compression_method = readUShort(lh.compression_method);
-
     if ((general_purpose_bits & Encrypted) != 0) {
         LOGW("Zip: Unsupported encryption method is needed to extract the data.");
-        return ByteArray();
+        return PackedFile();
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
-    if (compression_method == CompressionMethodStored) {
+    PackedFile file;
+    file.compressionMethod = readUShort(lh.compression_method);
+    file.uncompressedSize = uncompressed_size;
+    file.crc = readUInt(header.h.crc_32);
+    file.data = p->device->read(compressed_size);
+
+    return file;
+}
+
+ByteArray ZipContainer::unpack(const PackedFile& file)
+{
+    if (file.compressionMethod == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
+        ByteArray data = file.data;
+        data.truncate(file.uncompressedSize);
+        return data;
+    } else if (file.compressionMethod == CompressionMethodDeflated) {
         // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         ByteArray baunzip;
-        ulong len = std::max(uncompressed_size,  1);
+        ulong len = std::max(static_cast<int>(file.uncompressedSize), 1);
         int res;
         do {
             baunzip.resize(len);
             res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
+                          (const uint8_t*)file.data.constData(), static_cast<ulong>(file.data.size()));
 
             switch (res) {
             case Z_OK:
@@ -815,7 +841,43 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
         return baunzip;
     }
 
-    LOGW("Zip: Unsupported compression method %d is needed to extract the data.", compression_method);
+    LOGW("Zip: Unsupported compression method %d is needed to extract the data.", file.compressionMethod);
+    return ByteArray();
+}
+
+ByteArray ZipContainer::unpack(const PackedFile& file, size_t maxSize)
+{
+    if (maxSize >= file.uncompressedSize) {
+        return unpack(file);
+    }
+
+    if (file.compressionMethod == CompressionMethodStored) {
+        ByteArray data = file.data;
+        data.truncate(maxSize);
+        return data;
+    } else if (file.compressionMethod == CompressionMethodDeflated) {
+        ByteArray baunzip;
+        baunzip.resize(maxSize);
+        ulong len = static_cast<ulong>(maxSize);
+        int res = inflatePrefix((uint8_t*)baunzip.data(), &len,
+                                (const uint8_t*)file.data.constData(), static_cast<ulong>(file.data.size()));
+
+        switch (res) {
+        case Z_OK:
+            baunzip.resize(len);
+            return baunzip;
+        case Z_MEM_ERROR:
+            LOGW("Zip: Z_MEM_ERROR: Not enough memory");
+            break;
+        case Z_DATA_ERROR:
+            LOGW("Zip: Z_DATA_ERROR: Input data is corrupted");
+            break;
+        }
+
+        return ByteArray();
+    }
+
+    LOGW("Zip: Unsupported compression method %d is needed to extract the data.", file.compressionMethod);
     return ByteArray();
 }
 
@@ -834,9 +896,60 @@ ZipContainer::CompressionPolicy ZipContainer::compressionPolicy() const
     return p->compressionPolicy;
 }
 
+ZipContainer::PackedFile ZipContainer::pack(const ByteArray& data, CompressionPolicy policy)
+{
+    PackedFile file;
+    file.uncompressedSize = data.size();
+    file.crc = ::crc32(::crc32(0, 0, 0), (const uint8_t*)data.constData(), (uint)data.size());
+
+    // don't compress small files
+    if (policy == ZipContainer::AutoCompress) {
+        policy = data.size() < 64 ? ZipContainer::NeverCompress : ZipContainer::AlwaysCompress;
+    }
+
+    if (policy == ZipContainer::AlwaysCompress) {
+        ByteArray packed;
+        ulong len = (ulong)data.size();
+        // shamelessly copied form zlib
+        len += (len >> 12) + (len >> 14) + 11;
+        int res;
+        do {
+            packed.resize(len);
+            res = deflate((uint8_t*)packed.data(), &len, (const uint8_t*)data.constData(), (ulong)data.size());
+
+            switch (res) {
+            case Z_OK:
+                packed.resize(len);
+                break;
+            case Z_MEM_ERROR:
+                LOGW("Zip: Z_MEM_ERROR: Not enough memory to compress file, storing it uncompressed");
+                break;
+            case Z_BUF_ERROR:
+                len *= 2;
+                break;
+            }
+        } while (res == Z_BUF_ERROR);
+
+        if (res == Z_OK && packed.size() < data.size()) {
+            file.data = std::move(packed);
+            file.compressionMethod = CompressionMethodDeflated;
+            return file;
+        }
+    }
+
+    file.data = data;
+    file.compressionMethod = CompressionMethodStored;
+    return file;
+}
+
 void ZipContainer::addFile(const std::string& fileName, const ByteArray& data)
 {
-    p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), data);
+    addPackedFile(fileName, pack(data, p->compressionPolicy));
+}
+
+void ZipContainer::addPackedFile(const std::string& fileName, const PackedFile& file)
+{
+    p->addEntry(Impl::File, Dir::fromNativeSeparators(fileName).toStdString(), file);
 }
 
 void ZipContainer::addDirectory(const std::string& dirName)
@@ -846,7 +959,7 @@ void ZipContainer::addDirectory(const std::string& dirName)
     if (name.back() != '/') {
         name.push_back('/');
     }
-    p->addEntry(Impl::Directory, name, ByteArray());
+    p->addEntry(Impl::Directory, name, PackedFile());
 }
 
 void ZipContainer::close()
@@ -66,6 +66,19 @@ public:
     bool fileExists(const std::string& fileName) const;
     ByteArray fileData(const std::string& fileName) const;
 
+    struct PackedFile
+    {
+        ByteArray data;
+        int compressionMethod = 0;
+        size_t uncompressedSize = 0;
+        uint32_t crc = 0;
+    };
+
+    PackedFile packedFileData(const std::string& fileName) const;
+    static ByteArray unpack(const PackedFile& file);
+    //! NOTE Unpacks only the beginning of the file, at most maxSize bytes
+    static ByteArray unpack(const PackedFile& file, size_t maxSize);
+
     // Write
     enum CompressionPolicy {
         AlwaysCompress,
@@ -79,6 +92,11 @@ public:
     void addFile(const std::string& fileName, const ByteArray& data);
     void addDirectory(const std::string& dirName);
 
+    //! NOTE Compresses the data without touching the container, so it can be done on any thread;
+    //! the result is written with addPackedFile. If compression doesn't make the data smaller, it is stored
+    static PackedFile pack(const ByteArray& data, CompressionPolicy policy);
+    void addPackedFile(const std::string& fileName, const PackedFile& file);
+
 private:
 
     struct Impl;
@@ -22,25 +22,190 @@
 #include "xmlstreamreader.h"
 
 #include <cstring>
+#include <string_view>
 
 #include "global/types/string.h"
-#ifdef SYSTEM_TINYXML
-#include <tinyxml2.h>
-#else
-#include "thirdparty/tinyxml/tinyxml2.h"
-#endif
 
 #include "log.h"
 
 using namespace muse;
 using namespace muse::io;
-using namespace tinyxml2;
 
+static constexpr char UTF8_BOM[] = "\xEF\xBB\xBF";
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+static inline bool isNameStartChar(char c)
+{
+    return static_cast<unsigned char>(c) >= 128
+           || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+           || c == '_' || c == ':';
+}
+
+static inline bool isNameChar(char c)
+{
+    return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+}
+
+static char* writeUtf8(char* q, char32_t c)
+{
+    if (c < 0x80) {
+        *q++ = static_cast<char>(c);
+    } else if (c < 0x800) {
+        *q++ = static_cast<char>(0xC0 | (c >> 6));
+        *q++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        *q++ = static_cast<char>(0xE0 | (c >> 12));
+        *q++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *q++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+        *q++ = static_cast<char>(0xF0 | (c >> 18));
+        *q++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        *q++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *q++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+    return q;
+}
+
+//! NOTE Decodes the reference starting at p ('&') into q, returns the position after it.
+//! Unknown entities are kept as is (they may be declared in the DTD, see tryParseEntity)
+static char* decodeReference(char* p, const char* end, char*& q)
+{
+    struct Entity {
+        const char* pattern;
+        size_t length;
+        char value;
+    };
+
+    static constexpr Entity ENTITIES[] = {
+        { "quot;", 5, '\"' },
+        { "amp;", 4, '&' },
+        { "apos;", 5, '\'' },
+        { "lt;", 3, '<' },
+        { "gt;", 3, '>' }
+    };
+
+    const size_t available = static_cast<size_t>(end - p) - 1;
+
+    if (available > 0 && p[1] == '#') {
+        const bool hex = available > 1 && p[2] == 'x';
+        char* digits = p + (hex ? 3 : 2);
+        char* d = digits;
+        char32_t code = 0;
+        for (; d < end && code <= 0x10FFFF; ++d) {
+            const char c = *d;
+            if (c >= '0' && c <= '9') {
+                code = code * (hex ? 16 : 10) + (c - '0');
+            } else if (hex && c >= 'a' && c <= 'f') {
+                code = code * 16 + (c - 'a' + 10);
+            } else if (hex && c >= 'A' && c <= 'F') {
+                code = code * 16 + (c - 'A' + 10);
+            } else {
+                break;
+            }
+        }
+
+        //! NOTE The shortest reference is 4 bytes long, the longest UTF-8 sequence too,
+        //! so the decoded character never overtakes the read position
+        if (d > digits && d < end && *d == ';' && code > 0 && code <= 0x10FFFF) {
+            q = writeUtf8(q, code);
+            return d + 1;
+        }
+    } else {
+        for (const Entity& e : ENTITIES) {
+            if (available >= e.length && std::memcmp(p + 1, e.pattern, e.length) == 0) {
+                *q++ = e.value;
+                return p + e.length + 1;
+            }
+        }
+    }
+
+    *q++ = *p;
+    return p + 1;
+}
+
+//! NOTE Decodes references and normalizes line breaks ("\r\n" and "\r" to "\n") in place,
+//! the result is never longer than the source. Returns the new end
+static char* decode(char* begin, char* end, bool references)
+{
+    char* p = begin;
+    while (p < end && *p != '\r' && !(references && *p == '&')) {
+        ++p;
+    }
+
+    char* q = p;
+    while (p < end) {
+        const char c = *p;
+        if (c == '\r') {
+            *q++ = '\n';
+            p += (p + 1 < end && p[1] == '\n') ? 2 : 1;
+        } else if (c == '&' && references) {
+            p = decodeReference(p, end, q);
+        } else {
+            *q++ = *p++;
+        }
+    }
+
+    return q;
+}
+
+//! NOTE The reader is an incremental pull parser working in place over its own copy of the data:
+//! element names, attribute values and texts are decoded right inside the buffer and terminated with '\0',
+//! so they are all returned as AsciiStringView without allocations, and no document tree is built.
+//! Each call of readNext() parses just one token, so a malformed document is reported when the reader reaches the error.
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    ByteArray data;
+    char* pos = nullptr;
+    char* end = nullptr;
+
+    //! NOTE The '<' of the tag after a text was overwritten by the text terminator
+    bool tagOpened = false;
+    //! NOTE The current element is written as <name/>, its EndElement comes next
+    bool emptyElement = false;
+    //! NOTE Something other than the XML declaration was read
+    bool hasContent = false;
+    //! NOTE Inside the internal subset of DOCTYPE: '[' ... ']>'
+    bool dtdSubset = false;
+
+    int64_t line = 1;
+    const char* lineStart = nullptr;
+
+    std::vector<AsciiStringView> elements;
+    AsciiStringView name;
+    AsciiStringView value;
+    std::vector<AsciiAttribute> attributes;
+
+    Error err = NoError;
+    String errStr;
     String customErr;
+
+    char* skipSpaces(char* p)
+    {
+        while (p < end && isSpace(*p)) {
+            if (*p == '\n') {
+                ++line;
+                lineStart = p + 1;
+            }
+            ++p;
+        }
+        return p;
+    }
+
+    void countLines(const char* from, const char* to)
+    {
+        while (from < to) {
+            const char* nl = static_cast<const char*>(std::memchr(from, '\n', to - from));
+            if (!nl) {
+                break;
+            }
+            ++line;
+            lineStart = nl + 1;
+            from = nl + 1;
+        }
+    }
 };
 
 XmlStreamReader::XmlStreamReader()
@@ -51,22 +216,20 @@ XmlStreamReader::XmlStreamReader()
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+    init(device->readAll());
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
 {
     m_xml = new Xml();
-    setData(data);
+    init(data);
 }
 
 #ifndef NO_QT_SUPPORT
 XmlStreamReader::XmlStreamReader(const QByteArray& data)
 {
     m_xml = new Xml();
-    ByteArray ba = ByteArray::fromQByteArrayNoCopy(data);
-    setData(ba);
+    init(ByteArray::fromQByteArrayNoCopy(data));
 }
 
 #endif
@@ -76,41 +239,51 @@ XmlStreamReader::~XmlStreamReader()
     delete m_xml;
 }
 
-void XmlStreamReader::setData(const ByteArray& data_)
+void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->customErr.clear();
+    init(data);
+}
+
+void XmlStreamReader::init(ByteArray data)
+{
+    *m_xml = Xml();
+    m_entities.clear();
     m_token = TokenType::Invalid;
 
-    if (data_.size() < 4) {
-        m_xml->err = XML_ERROR_EMPTY_DOCUMENT;
-        LOGE() << m_xml->doc.ErrorIDToName(m_xml->err);
+    if (data.size() < 4) {
+        m_xml->err = PrematureEndOfDocumentError;
+        m_xml->errStr = u"empty document";
+        LOGE() << m_xml->errStr;
         return;
     }
 
-    UtfCodec::Encoding enc = UtfCodec::xmlEncoding(data_);
+    UtfCodec::Encoding enc = UtfCodec::xmlEncoding(data);
     if (enc == UtfCodec::Encoding::Unknown) {
-        m_xml->err = XML_CAN_NOT_CONVERT_TEXT;
-        LOGE() << "unknown encoding";
+        m_xml->err = NotWellFormedError;
+        m_xml->errStr = u"unknown encoding";
+        LOGE() << m_xml->errStr;
         return;
     }
 
-    ByteArray data = data_; // no copy, implicit sharing
     if (enc == UtfCodec::Encoding::UTF_16LE) {
-        String u16 = String::fromUtf16LE(data_);
-        data = u16.toUtf8();
+        data = String::fromUtf16LE(data).toUtf8();
     } else if (enc == UtfCodec::Encoding::UTF_16BE) {
-        String u16 = String::fromUtf16BE(data_);
-        data = u16.toUtf8();
+        data = String::fromUtf16BE(data).toUtf8();
     }
 
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
+    //! NOTE The parser writes into the buffer, so it must be our own.
+    //! No copy is made if nobody else holds the data (e.g. it was read from a device)
+    m_xml->data = std::move(data);
+    char* begin = reinterpret_cast<char*>(m_xml->data.data());
+    m_xml->end = begin + m_xml->data.size();
 
-    if (m_xml->err == XML_SUCCESS) {
-        m_token = TokenType::NoToken;
-    } else {
-        LOGE() << m_xml->doc.ErrorIDToName(m_xml->err);
+    if (std::memcmp(begin, UTF8_BOM, 3) == 0) {
+        begin += 3;
     }
+
+    m_xml->pos = begin;
+    m_xml->lineStart = begin;
+    m_token = TokenType::NoToken;
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -130,101 +303,321 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
+XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
+    if (m_token == TokenType::Invalid) {
+        return m_token;
+    }
+
+    if (m_token == TokenType::EndDocument) {
+        m_token = TokenType::Invalid;
+        return m_token;
     }
-    return XmlStreamReader::TokenType::Unknown;
+
+    m_token = parseNext();
+    return m_token;
 }
 
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
+XmlStreamReader::TokenType XmlStreamReader::parseNext()
 {
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
+    Xml* xml = m_xml;
+
+    if (xml->emptyElement) {
+        xml->emptyElement = false;
+        return EndElement;
+    }
+
+    char* p = xml->pos;
+    if (xml->tagOpened) {
+        xml->tagOpened = false;
+    } else {
+        char* start = p;
+        p = xml->skipSpaces(p);
+
+        if (xml->dtdSubset && p < xml->end && *p == ']') {
+            p = xml->skipSpaces(p + 1);
+            if (p == xml->end || *p != '>') {
+                return setParseError(p, NotWellFormedError, "expected '>' after DTD");
+            }
+            xml->dtdSubset = false;
+            start = p + 1;
+            p = xml->skipSpaces(start);
         }
 
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
+        if (p == xml->end) {
+            xml->pos = p;
+            if (!xml->elements.empty()) {
+                return setParseError(p, PrematureEndOfDocumentError, "unexpected end of document");
+            }
+            return EndDocument;
         }
+
+        //! NOTE Whitespace between tags is skipped, but a text keeps its leading whitespace
+        if (*p != '<') {
+            return parseText(start, p);
+        }
+
+        ++p;
     }
 
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
+    if (p == xml->end) {
+        return setParseError(p, PrematureEndOfDocumentError, "unexpected end of document");
     }
 
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
+    switch (*p) {
+    case '/': return parseEndElement(p + 1);
+    case '?':
+    case '!': return parseMarkup(p);
+    default: break;
     }
 
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
+    return parseStartElement(p);
 }
 
-XmlStreamReader::TokenType XmlStreamReader::readNext()
+XmlStreamReader::TokenType XmlStreamReader::parseText(char* start, char* from)
 {
-    if (m_token == TokenType::Invalid) {
-        return m_token;
+    Xml* xml = m_xml;
+
+    char* lt = static_cast<char*>(std::memchr(from, '<', xml->end - from));
+    if (!lt) {
+        xml->countLines(from, xml->end);
+        return setParseError(xml->end, PrematureEndOfDocumentError, "unexpected end of document in text");
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
-        m_token = TokenType::Invalid;
-        return m_token;
+    xml->countLines(from, lt);
+
+    char* textEnd = decode(start, lt, true);
+    *textEnd = '\0';
+
+    xml->value = AsciiStringView(start, textEnd - start);
+    xml->pos = lt + 1;
+    xml->tagOpened = true;
+    xml->hasContent = true;
+
+    return Characters;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::parseStartElement(char* p)
+{
+    Xml* xml = m_xml;
+
+    if (!isNameStartChar(*p)) {
+        return setParseError(p, NotWellFormedError, "invalid element name");
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
+    char* nameBegin = p;
+    while (p < xml->end && isNameChar(*p)) {
+        ++p;
     }
+    char* nameEnd = p;
 
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
+    xml->attributes.clear();
 
-    m_xml->node = p.first;
-    m_token = p.second;
+    while (true) {
+        p = xml->skipSpaces(p);
+        if (p == xml->end) {
+            return setParseError(p, PrematureEndOfDocumentError, "unexpected end of document in tag");
+        }
+
+        if (*p == '>') {
+            ++p;
+            break;
+        }
+
+        if (*p == '/') {
+            if (p + 1 < xml->end && p[1] == '>') {
+                p += 2;
+                xml->emptyElement = true;
+                break;
+            }
+            return setParseError(p, NotWellFormedError, "expected '>' after '/'");
+        }
+
+        if (!isNameStartChar(*p)) {
+            return setParseError(p, NotWellFormedError, "invalid attribute name");
+        }
+
+        char* attrBegin = p;
+        while (p < xml->end && isNameChar(*p)) {
+            ++p;
+        }
+        char* attrEnd = p;
 
-    if (m_token == XmlStreamReader::TokenType::DTD) {
-        tryParseEntity(m_xml);
+        p = xml->skipSpaces(p);
+        if (p == xml->end || *p != '=') {
+            return setParseError(p, NotWellFormedError, "expected '=' after attribute name");
+        }
+
+        p = xml->skipSpaces(p + 1);
+        if (p == xml->end || (*p != '\"' && *p != '\'')) {
+            return setParseError(p, NotWellFormedError, "expected quoted attribute value");
+        }
+
+        char* valueBegin = p + 1;
+        char* valueEnd = static_cast<char*>(std::memchr(valueBegin, *p, xml->end - valueBegin));
+        if (!valueEnd) {
+            xml->countLines(valueBegin, xml->end);
+            return setParseError(xml->end, PrematureEndOfDocumentError, "unexpected end of document in attribute value");
+        }
+
+        xml->countLines(valueBegin, valueEnd);
+        p = valueEnd + 1;
+
+        valueEnd = decode(valueBegin, valueEnd, true);
+        *valueEnd = '\0';
+        *attrEnd = '\0';
+
+        xml->attributes.push_back({ AsciiStringView(attrBegin, attrEnd - attrBegin),
+                                    AsciiStringView(valueBegin, valueEnd - valueBegin) });
     }
 
-    return m_token;
+    *nameEnd = '\0';
+    xml->name = AsciiStringView(nameBegin, nameEnd - nameBegin);
+    if (!xml->emptyElement) {
+        xml->elements.push_back(xml->name);
+    }
+
+    xml->pos = p;
+    xml->hasContent = true;
+
+    return StartElement;
 }
 
-#if (defined (_MSCVER) || defined (_MSC_VER))
-#define strdup _strdup // avoid a warning from MSVC on a perfectly valid POSIX function
-#endif
-void XmlStreamReader::tryParseEntity(Xml* xml)
+XmlStreamReader::TokenType XmlStreamReader::parseEndElement(char* p)
+{
+    Xml* xml = m_xml;
+
+    char* nameBegin = p;
+    while (p < xml->end && isNameChar(*p)) {
+        ++p;
+    }
+    char* nameEnd = p;
+
+    p = xml->skipSpaces(p);
+    if (p == xml->end) {
+        return setParseError(p, PrematureEndOfDocumentError, "unexpected end of document in tag");
+    }
+
+    if (*p != '>') {
+        return setParseError(p, NotWellFormedError, "expected '>' in end tag");
+    }
+
+    if (xml->elements.empty() || xml->elements.back() != AsciiStringView(nameBegin, nameEnd - nameBegin)) {
+        return setParseError(nameBegin, NotWellFormedError, "mismatched end tag");
+    }
+
+    xml->name = xml->elements.back();
+    xml->elements.pop_back();
+    xml->pos = p + 1;
+
+    return EndElement;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::parseMarkup(char* p)
+{
+    Xml* xml = m_xml;
+
+    const std::string_view rest(p, xml->end - p);
+
+    auto parseUntil = [xml, p, &rest](size_t valueOffset, std::string_view terminator, bool references) -> char* {
+        const size_t close = rest.find(terminator, valueOffset);
+        if (close == std::string_view::npos) {
+            xml->countLines(p, xml->end);
+            return nullptr;
+        }
+
+        char* valueBegin = p + valueOffset;
+        char* valueEnd = p + close;
+        xml->countLines(valueBegin, valueEnd);
+
+        char* decodedEnd = decode(valueBegin, valueEnd, references);
+        *decodedEnd = '\0';
+
+        xml->value = AsciiStringView(valueBegin, decodedEnd - valueBegin);
+        xml->pos = valueEnd + terminator.size();
+        return xml->pos;
+    };
+
+    if (*p == '?') {
+        if (!parseUntil(1, "?>", false)) {
+            return setParseError(xml->end, PrematureEndOfDocumentError, "unexpected end of document in declaration");
+        }
+
+        //! NOTE Declarations are only reported before anything else,
+        //! processing instructions in the middle (e.g. <?SmartMusic ...?> in MusicXML) are skipped
+        if (xml->hasContent || !xml->elements.empty()) {
+            return parseNext();
+        }
+        return StartDocument;
+    }
+
+    xml->hasContent = true;
+
+    if (rest.compare(0, 3, "!--") == 0) {
+        if (!parseUntil(3, "-->", false)) {
+            return setParseError(xml->end, PrematureEndOfDocumentError, "unexpected end of document in comment");
+        }
+        return Comment;
+    }
+
+    if (rest.compare(0, 8, "![CDATA[") == 0) {
+        if (!parseUntil(8, "]]>", false)) {
+            return setParseError(xml->end, PrematureEndOfDocumentError, "unexpected end of document in CDATA");
+        }
+        return Characters;
+    }
+
+    //! NOTE The declarations of an internal DTD subset are read one by one after DOCTYPE
+    if (rest.compare(0, 8, "!DOCTYPE") == 0) {
+        const size_t close = rest.find_first_of("[>");
+        if (close != std::string_view::npos && rest[close] == '[') {
+            parseUntil(1, "[", false);
+            xml->dtdSubset = true;
+            return DTD;
+        }
+    }
+
+    if (!parseUntil(1, ">", false)) {
+        return setParseError(xml->end, PrematureEndOfDocumentError, "unexpected end of document in DTD");
+    }
+
+    tryParseEntity();
+
+    return DTD;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::setParseError(char* pos, Error err, const char* message)
+{
+    m_xml->pos = pos;
+    m_xml->err = err;
+    m_xml->errStr = String::fromUtf8(message);
+
+    LOGE() << m_xml->errStr << ", line: " << lineNumber() << ", column: " << columnNumber();
+
+    return Invalid;
+}
+
+void XmlStreamReader::tryParseEntity()
 {
     static const char* ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
+    const char* str = m_xml->value.ascii();
     if (std::strncmp(str, ENTITY, 6) == 0) {
         // Syntax: '<!ENTITY [%] Name [SYSTEM|PUBLIC] "Value" [additional info] >'
         // the '<!' and '>' stripped away already from str
         // let's ignore %, SYSTEM, PUBLIC and any spaces in the 1st token
         // and not read the (optional) 3rd token at all
-        char* string = strdup(str); // create local copy
-        const char sep[] = "\"";
-        char* token = std::strtok(string + 6, sep); // start at the space after "ENTITY"
-        String name = String::fromUtf8(token).remove(u"%").remove(u"SYSTEM").remove(u"PUBLIC").remove(u" ");
-        token = std::strtok(NULL, sep); // read 2nd token
-        String value = String::fromUtf8(token);
-        free(string); // not needed anymore
+        const String decl = String::fromUtf8(str + 6);
+        const size_t quote = decl.indexOf(u'\"');
+        String name = decl.left(quote).remove(u"%").remove(u"SYSTEM").remove(u"PUBLIC").remove(u" ");
+        String value;
+        if (quote != muse::nidx) {
+            value = decl.mid(quote + 1);
+            const size_t valueEnd = value.indexOf(u'\"');
+            if (valueEnd != muse::nidx) {
+                value.truncate(valueEnd);
+            }
+        }
         if (!name.empty()) {
             m_entities[u'&' + name + u';'] = value;
             return;
@@ -233,13 +626,9 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
     }
 }
 
-#if (defined(_MSCVER) || defined(_MSC_VER))
-#undef strdup
-#endif
-
-String XmlStreamReader::nodeValue(Xml* xml) const
+String XmlStreamReader::nodeValue() const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(m_xml->value.ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -289,56 +678,51 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return (m_token == TokenType::StartElement || m_token == TokenType::EndElement) ? m_xml->name : AsciiStringView();
 }
 
-bool XmlStreamReader::hasAttribute(const char* name) const
+const XmlStreamReader::AsciiAttribute* XmlStreamReader::findAttribute(const char* name) const
 {
     if (m_token != TokenType::StartElement) {
-        return false;
+        return nullptr;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
+    const size_t len = std::strlen(name);
+    for (const AsciiAttribute& a : m_xml->attributes) {
+        if (a.name.size() == len && std::memcmp(a.name.ascii(), name, len) == 0) {
+            return &a;
+        }
     }
-    return e->FindAttribute(name) != nullptr;
+    return nullptr;
 }
 
-String XmlStreamReader::attribute(const char* name) const
+bool XmlStreamReader::hasAttribute(const char* name) const
 {
-    if (m_token != TokenType::StartElement) {
-        return String();
-    }
+    return findAttribute(name) != nullptr;
+}
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return String();
-    }
-    return String::fromUtf8(e->Attribute(name));
+String XmlStreamReader::attribute(const char* name) const
+{
+    const AsciiAttribute* a = findAttribute(name);
+    return a ? String::fromUtf8(a->value.ascii()) : String();
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
 {
-    return hasAttribute(name) ? attribute(name) : def;
+    const AsciiAttribute* a = findAttribute(name);
+    return a ? String::fromUtf8(a->value.ascii()) : def;
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
 {
-    if (m_token != TokenType::StartElement) {
-        return AsciiStringView();
-    }
-
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return AsciiStringView();
-    }
-    return e->Attribute(name);
+    const AsciiAttribute* a = findAttribute(name);
+    return a ? a->value : AsciiStringView();
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
 {
-    return hasAttribute(name) ? asciiAttribute(name) : def;
+    const AsciiAttribute* a = findAttribute(name);
+    return a ? a->value : def;
 }
 
 int XmlStreamReader::intAttribute(const char* name) const
@@ -348,7 +732,8 @@ int XmlStreamReader::intAttribute(const char* name) const
 
 int XmlStreamReader::intAttribute(const char* name, int def) const
 {
-    return hasAttribute(name) ? intAttribute(name) : def;
+    const AsciiAttribute* a = findAttribute(name);
+    return a ? a->value.toInt() : def;
 }
 
 double XmlStreamReader::doubleAttribute(const char* name) const
@@ -358,7 +743,8 @@ double XmlStreamReader::doubleAttribute(const char* name) const
 
 double XmlStreamReader::doubleAttribute(const char* name, double def) const
 {
-    return hasAttribute(name) ? doubleAttribute(name) : def;
+    const AsciiAttribute* a = findAttribute(name);
+    return a ? a->value.toDouble() : def;
 }
 
 std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
@@ -368,32 +754,34 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->attributes.size());
+    for (const AsciiAttribute& xa : m_xml->attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = xa.name;
+        a.value = String::fromUtf8(xa.value.ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
 }
 
+const std::vector<XmlStreamReader::AsciiAttribute>& XmlStreamReader::asciiAttributes() const
+{
+    static const std::vector<AsciiAttribute> NO_ATTRIBUTES;
+    return m_token == TokenType::StartElement ? m_xml->attributes : NO_ATTRIBUTES;
+}
+
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return nodeValue(m_xml);
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return nodeValue();
     }
     return String();
 }
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->value;
     }
     return AsciiStringView();
 }
@@ -402,17 +790,13 @@ String XmlStreamReader::readText()
 {
     if (isStartElement()) {
         String result;
-        while (1) {
-            switch (readNext()) {
+        while (readNext() != Invalid) {
+            switch (m_token) {
             case Characters:
-                result = nodeValue(m_xml);
+                result = nodeValue();
                 break;
             case EndElement:
                 return result;
-            case Comment:
-                break;
-            case StartElement:
-                break;
             default:
                 break;
             }
@@ -425,17 +809,13 @@ AsciiStringView XmlStreamReader::readAsciiText()
 {
     if (isStartElement()) {
         AsciiStringView result;
-        while (1) {
-            switch (readNext()) {
+        while (readNext() != Invalid) {
+            switch (m_token) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->value;
                 break;
             case EndElement:
                 return result;
-            case Comment:
-                break;
-            case StartElement:
-                break;
             default:
                 break;
             }
@@ -458,12 +838,15 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->line;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    if (!m_xml->pos || !m_xml->lineStart) {
+        return 0;
+    }
+    return static_cast<int64_t>(m_xml->pos - m_xml->lineStart);
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -472,12 +855,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
-    }
-
-    return NotWellFormedError;
+    return m_xml->err;
 }
 
 bool XmlStreamReader::isError() const
@@ -490,7 +868,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return m_xml->errStr;
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -65,6 +65,12 @@ public:
         String value;
     };
 
+    struct AsciiAttribute
+    {
+        AsciiStringView name;
+        AsciiStringView value;
+    };
+
     XmlStreamReader();
     explicit XmlStreamReader(io::IODevice* device);
     explicit XmlStreamReader(const ByteArray& data);
@@ -104,6 +110,7 @@ public:
     double doubleAttribute(const char* name) const;
     double doubleAttribute(const char* name, double def) const;
     std::vector<Attribute> attributes() const;
+    const std::vector<AsciiAttribute>& asciiAttributes() const;
 
     String text() const;
     AsciiStringView asciiText() const;
@@ -122,8 +129,17 @@ public:
 private:
     struct Xml;
 
-    void tryParseEntity(Xml* xml);
-    String nodeValue(Xml* xml) const;
+    void init(ByteArray data);
+    TokenType parseNext();
+    TokenType parseText(char* start, char* from);
+    TokenType parseStartElement(char* p);
+    TokenType parseEndElement(char* p);
+    TokenType parseMarkup(char* p);
+    TokenType setParseError(char* pos, Error err, const char* message);
+
+    void tryParseEntity();
+    String nodeValue() const;
+    const AsciiAttribute* findAttribute(const char* name) const;
 
     Xml* m_xml = nullptr;
     TokenType m_token = TokenType::NoToken;
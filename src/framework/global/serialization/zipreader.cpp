@@ -107,6 +107,35 @@ ByteArray ZipReader::fileData(const std::string& fileName) const
     return m_impl->zip->fileData(fileName);
 }
 
+ZipReader::PackedFile ZipReader::packedFileData(const std::string& fileName) const
+{
+    ZipContainer::PackedFile zipFile = m_impl->zip->packedFileData(fileName);
+
+    PackedFile file;
+    file.data = std::move(zipFile.data);
+    file.compressionMethod = zipFile.compressionMethod;
+    file.uncompressedSize = zipFile.uncompressedSize;
+    return file;
+}
+
+ByteArray ZipReader::unpack(const PackedFile& file)
+{
+    ZipContainer::PackedFile zipFile;
+    zipFile.data = file.data;
+    zipFile.compressionMethod = file.compressionMethod;
+    zipFile.uncompressedSize = file.uncompressedSize;
+    return ZipContainer::unpack(zipFile);
+}
+
+ByteArray ZipReader::unpack(const PackedFile& file, size_t maxSize)
+{
+    ZipContainer::PackedFile zipFile;
+    zipFile.data = file.data;
+    zipFile.compressionMethod = file.compressionMethod;
+    zipFile.uncompressedSize = file.uncompressedSize;
+    return ZipContainer::unpack(zipFile, maxSize);
+}
+
 // ===========================
 // ZipUnpack
 // ===========================
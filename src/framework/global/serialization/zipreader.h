@@ -44,6 +44,17 @@ public:
         bool isValid() const { return isDir || isFile || isSymLink; }
     };
 
+    //! NOTE A file as it is stored in the archive (usually compressed),
+    //! it can be kept in memory as it is and unpacked later, on any thread
+    struct PackedFile
+    {
+        ByteArray data;
+        int compressionMethod = 0; // 0 - stored, 8 - deflated
+        size_t uncompressedSize = 0;
+
+        bool isNull() const { return data.empty() && uncompressedSize == 0; }
+    };
+
     explicit ZipReader(const io::path_t& filePath);
     explicit ZipReader(io::IODevice* device);
     ~ZipReader();
@@ -56,6 +67,11 @@ public:
     bool fileExists(const std::string& fileName) const;
     ByteArray fileData(const std::string& fileName) const;
 
+    PackedFile packedFileData(const std::string& fileName) const;
+    static ByteArray unpack(const PackedFile& file);
+    //! NOTE Unpacks only the beginning of the file, at most maxSize bytes
+    static ByteArray unpack(const PackedFile& file, size_t maxSize);
+
 private:
     struct Impl;
     Impl* m_impl = nullptr;
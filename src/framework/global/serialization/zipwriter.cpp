@@ -21,17 +21,85 @@
  */
 #include "zipwriter.h"
 
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "global/io/file.h"
+#include "global/concurrency/taskscheduler.h"
 #include "internal/zipcontainer.h"
 
 #include "log.h"
 
 using namespace muse;
 
+//! NOTE Files smaller than this are packed right away, scheduling them costs more than deflating
+static constexpr size_t MIN_CONCURRENT_PACK_SIZE = 4 * 1024;
+
+//! NOTE Formats that are compressed already (images, audio, archives),
+//! deflating them again costs time and gains nothing
+static bool isCompressedData(const ByteArray& data)
+{
+    static const std::vector<ByteArray> SIGNATURES = {
+        ByteArray("\x89PNG\r\n\x1a\n", 8),  // PNG
+        ByteArray("\xff\xd8\xff", 3),       // JPEG
+        ByteArray("GIF8", 4),               // GIF
+        ByteArray("OggS", 4),               // Ogg
+        ByteArray("fLaC", 4),               // FLAC
+        ByteArray("ID3", 3),                // MP3
+        ByteArray("PK\x03\x04", 4),         // Zip
+        ByteArray("\x1f\x8b", 2),           // GZip
+    };
+
+    for (const ByteArray& signature : SIGNATURES) {
+        if (data.size() >= signature.size()
+            && std::memcmp(data.constData(), signature.constData(), signature.size()) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 struct ZipWriter::Impl
 {
+    //! NOTE A file waiting to be written. Files are packed on the thread pool,
+    //! but written to the device in the order they were added
+    struct PendingFile
+    {
+        std::string fileName;
+        ByteArray data;
+        ZipContainer::PackedFile packed;
+        std::atomic<bool> isPacked = false;
+        TaskGroup packTask;
+    };
+
     ZipContainer* zip = nullptr;
     bool isClosed = false;
+
+    std::deque<std::unique_ptr<PendingFile> > pendingFiles;
+
+    //! NOTE Bounds the memory held by the packed data that isn't written yet
+    size_t maxPendingFiles() const
+    {
+        return std::max<size_t>(2, 2 * TaskScheduler::instance()->threadPoolSize());
+    }
+
+    void writePackedFiles(size_t maxPending)
+    {
+        while (!pendingFiles.empty()) {
+            PendingFile* file = pendingFiles.front().get();
+            if (pendingFiles.size() <= maxPending && !file->isPacked.load(std::memory_order_acquire)) {
+                break;
+            }
+
+            file->packTask.wait();
+            zip->addPackedFile(file->fileName, file->packed);
+            pendingFiles.pop_front();
+        }
+    }
 };
 
 ZipWriter::ZipWriter(const io::path_t& filePath)
@@ -75,6 +143,7 @@ void ZipWriter::close()
         return;
     }
 
+    m_impl->writePackedFiles(0);
     m_impl->zip->close();
     if (m_device) {
         flush();
@@ -91,6 +160,29 @@ bool ZipWriter::hasError() const
 
 void ZipWriter::addFile(const std::string& fileName, const ByteArray& data)
 {
-    m_impl->zip->addFile(fileName, data);
+    ZipContainer::CompressionPolicy policy = m_impl->zip->compressionPolicy();
+    if (isCompressedData(data)) {
+        policy = ZipContainer::NeverCompress;
+    }
+
+    auto file = std::make_unique<Impl::PendingFile>();
+    file->fileName = fileName;
+
+    if (policy == ZipContainer::NeverCompress || data.size() < MIN_CONCURRENT_PACK_SIZE) {
+        file->packed = ZipContainer::pack(data, policy);
+        file->isPacked = true;
+    } else {
+        file->data = data;
+
+        Impl::PendingFile* f = file.get();
+        f->packTask.run([f, policy]() {
+            f->packed = ZipContainer::pack(f->data, policy);
+            f->data = ByteArray();
+            f->isPacked.store(true, std::memory_order_release);
+        });
+    }
+
+    m_impl->pendingFiles.push_back(std::move(file));
+    m_impl->writePackedFiles(m_impl->maxPendingFiles());
     flush();
 }
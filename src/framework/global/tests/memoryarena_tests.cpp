@@ -0,0 +1,231 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "memoryarena.h"
+
+using namespace muse;
+
+namespace muse {
+//! NOTE Allocated like an OBJECT_ALLOCATOR class with the arenas enabled,
+//! which is fixed at build time (see MemoryArena::enabled)
+class ArenaItem
+{
+public:
+    ArenaItem(int n)
+        : num(n) {}
+
+    static void* operator new(size_t sz) { return MemoryArena::allocate(sz); }
+    static void operator delete(void* ptr) { MemoryArena::deallocate(ptr); }
+
+    int num = 0;
+    std::string str = "some string";
+};
+}
+
+class Global_MemoryArenaTests : public ::testing::Test
+{
+};
+
+TEST_F(Global_MemoryArenaTests, AllocInCurrentArena)
+{
+    MemoryArena arena("test");
+
+    ArenaItem* item1 = nullptr;
+    ArenaItem* item2 = nullptr;
+    {
+        //! DO Create items while the arena is current
+        MemoryArena::Scope scope(&arena);
+        item1 = new ArenaItem(1);
+        item2 = new ArenaItem(2);
+
+        EXPECT_EQ(MemoryArena::current(), &arena);
+    }
+
+    EXPECT_EQ(MemoryArena::current(), nullptr);
+
+    //! CHECK Both items are in the arena
+    MemoryArena::Info info = arena.stateInfo();
+    EXPECT_EQ(info.blockCount, 1);
+    EXPECT_EQ(info.usedCount(), 2);
+    EXPECT_EQ(item1->num, 1);
+    EXPECT_EQ(item2->str, "some string");
+
+    //! DO Delete an item out of the arena scope
+    delete item1;
+
+    info = arena.stateInfo();
+    EXPECT_EQ(info.usedCount(), 1);
+
+    //! DO Create another item, the freed chunk is reused
+    {
+        MemoryArena::Scope scope(&arena);
+        ArenaItem* item3 = new ArenaItem(3);
+        EXPECT_EQ(item3, item1);
+        delete item3;
+    }
+
+    delete item2;
+
+    info = arena.stateInfo();
+    EXPECT_EQ(info.usedCount(), 0);
+    EXPECT_EQ(info.usedBytes, 0);
+    EXPECT_EQ(info.totalAllocatedCount, 3);
+}
+
+TEST_F(Global_MemoryArenaTests, AllocWithoutArena)
+{
+    MemoryArena arena("test");
+
+    //! DO Create an item when no arena is current
+    ArenaItem* item = new ArenaItem(1);
+
+    //! CHECK The arena was not used
+    EXPECT_EQ(arena.stateInfo().totalAllocatedCount, 0);
+    EXPECT_EQ(item->num, 1);
+
+    //! DO Delete the item inside the arena scope
+    {
+        MemoryArena::Scope scope(&arena);
+        delete item;
+    }
+
+    EXPECT_EQ(arena.stateInfo().totalFreeCount, 0);
+}
+
+TEST_F(Global_MemoryArenaTests, BigObjects)
+{
+    size_t blockSize = MemoryArena::DEFAULT_BLOCK_SIZE;
+    MemoryArena::DEFAULT_BLOCK_SIZE = 1024;
+
+    MemoryArena arena("test");
+    MemoryArena::Scope scope(&arena);
+
+    //! DO Allocate more than a block
+    void* big = MemoryArena::allocate(4000);
+    void* small = MemoryArena::allocate(100);
+
+    MemoryArena::Info info = arena.stateInfo();
+    EXPECT_EQ(info.blockCount, 2);
+    EXPECT_EQ(info.usedCount(), 2);
+
+    MemoryArena::deallocate(big);
+    MemoryArena::deallocate(small);
+
+    info = arena.stateInfo();
+    EXPECT_EQ(info.usedCount(), 0);
+
+    MemoryArena::DEFAULT_BLOCK_SIZE = blockSize;
+}
+
+TEST_F(Global_MemoryArenaTests, ReleaseWithLiveObjects)
+{
+    MemoryArena* arena = new MemoryArena("test");
+
+    ArenaItem* item = nullptr;
+    {
+        MemoryArena::Scope scope(arena);
+        item = new ArenaItem(1);
+    }
+
+    //! DO Release the arena while an item is alive
+    MemoryArena::release(arena);
+
+    //! CHECK The arena is detached, the item is still valid
+    EXPECT_EQ(arena->stateInfo().usedCount(), 1);
+    EXPECT_EQ(item->num, 1);
+    EXPECT_EQ(item->str, "some string");
+
+    //! DO Delete the last item, the arena is destroyed with it
+    delete item;
+}
+
+TEST_F(Global_MemoryArenaTests, FreeOnOtherThread)
+{
+    MemoryArena arena("test");
+
+    ArenaItem* item = nullptr;
+    {
+        MemoryArena::Scope scope(&arena);
+        item = new ArenaItem(1);
+    }
+
+    //! DO Delete the item on another thread
+    std::thread([item]() {
+        delete item;
+    }).join();
+
+    //! CHECK The free is counted
+    MemoryArena::Info info = arena.stateInfo();
+    EXPECT_EQ(info.usedCount(), 0);
+    EXPECT_EQ(info.usedBytes, 0);
+
+    //! DO Create another item on the owner thread, the chunk freed on the other thread is reused
+    MemoryArena::Scope scope(&arena);
+    ArenaItem* item2 = new ArenaItem(2);
+    EXPECT_EQ(item2, item);
+    delete item2;
+}
+
+TEST_F(Global_MemoryArenaTests, AllocOnOtherThread)
+{
+    MemoryArena arena("test");
+
+    //! DO Create an item on another thread with the arena current there
+    ArenaItem* item = nullptr;
+    std::thread([&arena, &item]() {
+        MemoryArena::Scope scope(&arena);
+        item = new ArenaItem(1);
+    }).join();
+
+    //! CHECK The item is on the heap, the arena was not used
+    EXPECT_EQ(arena.stateInfo().totalAllocatedCount, 0);
+    EXPECT_EQ(item->num, 1);
+
+    //! DO Delete it on the owner thread
+    {
+        MemoryArena::Scope scope(&arena);
+        delete item;
+    }
+
+    EXPECT_EQ(arena.stateInfo().totalFreeCount, 0);
+}
+
+TEST_F(Global_MemoryArenaTests, ReleaseWithLiveObjectsOnOtherThread)
+{
+    MemoryArena* arena = new MemoryArena("test");
+
+    ArenaItem* item = nullptr;
+    {
+        MemoryArena::Scope scope(arena);
+        item = new ArenaItem(1);
+    }
+
+    //! DO Release the arena while an item is alive, then delete the item on another thread
+    MemoryArena::release(arena);
+
+    std::thread([item]() {
+        delete item;
+    }).join();
+}
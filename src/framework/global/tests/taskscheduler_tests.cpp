@@ -0,0 +1,208 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include "concurrency/taskscheduler.h"
+
+using namespace muse;
+
+class Global_TaskSchedulerTests : public ::testing::Test
+{
+};
+
+TEST_F(Global_TaskSchedulerTests, Submit)
+{
+    TaskScheduler scheduler(2);
+
+    //! DO Submit tasks with arguments
+    std::future<int> sum = scheduler.submit([](int a, int b) { return a + b; }, 2, 3);
+    std::future<void> nothing = scheduler.submit([]() {});
+
+    //! CHECK
+    EXPECT_EQ(sum.get(), 5);
+    nothing.wait();
+}
+
+TEST_F(Global_TaskSchedulerTests, GroupWait)
+{
+    TaskScheduler scheduler(4);
+
+    std::vector<int> values(1000, 0);
+
+    //! DO Run a task per value and wait for all of them
+    TaskGroup group(TaskPriority::Normal, &scheduler);
+    for (size_t i = 0; i < values.size(); ++i) {
+        group.run([&values, i]() {
+            values[i] = static_cast<int>(i);
+        });
+    }
+    group.wait();
+
+    //! CHECK All tasks were done
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], static_cast<int>(i));
+    }
+}
+
+TEST_F(Global_TaskSchedulerTests, NestedGroups)
+{
+    TaskScheduler scheduler(2);
+
+    std::atomic<int> count = 0;
+
+    //! DO Tasks which run and wait for their own groups
+    TaskGroup group(TaskPriority::Normal, &scheduler);
+    for (int i = 0; i < 8; ++i) {
+        group.run([&scheduler, &count]() {
+            TaskGroup inner(TaskPriority::Normal, &scheduler);
+            for (int j = 0; j < 8; ++j) {
+                inner.run([&count]() { count++; });
+            }
+            inner.wait();
+        });
+    }
+    group.wait();
+
+    //! CHECK
+    EXPECT_EQ(count.load(), 64);
+}
+
+TEST_F(Global_TaskSchedulerTests, HighPriority)
+{
+    TaskScheduler scheduler(2);
+
+    std::vector<float> sums(16, 0.f);
+
+    //! DO Run high priority tasks
+    TaskGroup group(TaskPriority::High, &scheduler);
+    for (size_t i = 0; i < sums.size(); ++i) {
+        group.run([&sums, i]() {
+            std::vector<float> buf(256, 1.f);
+            sums[i] = std::accumulate(buf.begin(), buf.end(), 0.f);
+        });
+    }
+    group.wait();
+
+    //! CHECK
+    for (float s : sums) {
+        EXPECT_FLOAT_EQ(s, 256.f);
+    }
+}
+
+TEST_F(Global_TaskSchedulerTests, GroupException)
+{
+    TaskScheduler scheduler(2);
+
+    std::atomic<int> count = 0;
+
+    //! DO One of the tasks throws
+    TaskGroup group(TaskPriority::Normal, &scheduler);
+    for (int i = 0; i < 10; ++i) {
+        group.run([&count, i]() {
+            if (i == 5) {
+                throw std::runtime_error("error");
+            }
+            count++;
+        });
+    }
+
+    //! CHECK The other tasks are done, the exception is rethrown by wait
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(count.load(), 9);
+}
+
+TEST_F(Global_TaskSchedulerTests, BigTask)
+{
+    TaskScheduler scheduler(2);
+
+    //! DO Run a task which doesn't fit the inline storage
+    std::array<double, 32> data;
+    data.fill(1.0);
+
+    double result = 0.0;
+    TaskGroup group(TaskPriority::Normal, &scheduler);
+    group.run([data, &result]() {
+        result = std::accumulate(data.begin(), data.end(), 0.0);
+    });
+    group.wait();
+
+    //! CHECK
+    EXPECT_DOUBLE_EQ(result, 32.0);
+}
+
+TEST_F(Global_TaskSchedulerTests, NormalWaitDoesNotRunHighPriorityTasks)
+{
+    TaskScheduler scheduler(1);
+
+    //! GIVEN The only worker is busy
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    TaskGroup blocker(TaskPriority::Normal, &scheduler);
+    blocker.run([&started, &released]() {
+        started = true;
+        while (!released) {
+            std::this_thread::yield();
+        }
+    });
+
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    //! GIVEN High priority tasks are queued
+    const std::thread::id callerThread = std::this_thread::get_id();
+    std::atomic<int> highCount = 0;
+    std::atomic<int> highOnCallerCount = 0;
+    TaskGroup highGroup(TaskPriority::High, &scheduler);
+    for (int i = 0; i < 8; ++i) {
+        highGroup.run([&highCount, &highOnCallerCount, callerThread]() {
+            if (std::this_thread::get_id() == callerThread) {
+                highOnCallerCount++;
+            }
+            highCount++;
+        });
+    }
+
+    //! DO Wait for a normal group on a thread that is not a pool worker
+    std::atomic<int> normalCount = 0;
+    TaskGroup normalGroup(TaskPriority::Normal, &scheduler);
+    for (int i = 0; i < 8; ++i) {
+        normalGroup.run([&normalCount]() { normalCount++; });
+    }
+    normalGroup.wait();
+
+    //! CHECK The normal tasks are done by the waiting thread, the high priority ones are left to the worker
+    EXPECT_EQ(normalCount.load(), 8);
+    EXPECT_EQ(highCount.load(), 0);
+
+    released = true;
+    blocker.wait();
+    scheduler.waitForAllTasksComplete();
+
+    EXPECT_EQ(highCount.load(), 8);
+    EXPECT_EQ(highOnCallerCount.load(), 0);
+}
@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "tracer.h"
+#include "serialization/json.h"
+
+using namespace muse;
+
+class Global_TracerTests : public ::testing::Test
+{
+public:
+
+    void TearDown() override
+    {
+        Tracer::setEnabled(false);
+    }
+
+    static std::vector<JsonObject> completeEvents(const std::string& name)
+    {
+        std::string json = Tracer::toChromeTraceJson();
+        std::string err;
+        JsonObject root = JsonDocument::fromJson(ByteArray(json.data(), json.size()), &err).rootObject();
+        EXPECT_TRUE(err.empty()) << err;
+
+        std::vector<JsonObject> events;
+        JsonArray arr = root.value("traceEvents").toArray();
+        for (size_t i = 0; i < arr.size(); ++i) {
+            JsonObject e = arr.at(i).toObject();
+            if (e.value("ph").toStdString() == "X" && e.value("name").toStdString() == name) {
+                events.push_back(e);
+            }
+        }
+        return events;
+    }
+};
+
+TEST_F(Global_TracerTests, DisabledRecordsNothing)
+{
+    //! DO Trace a scope while the tracer is disabled
+    {
+        TRACE_SCOPE("tracer_disabled");
+    }
+
+    //! CHECK Nothing is recorded
+    EXPECT_TRUE(completeEvents("tracer_disabled").empty());
+}
+
+TEST_F(Global_TracerTests, ScopesOfThreads)
+{
+    Tracer::setEnabled(true);
+
+    //! DO Trace nested scopes in this thread and a scope in another one
+    {
+        TRACE_SCOPE("tracer_outer");
+        {
+            TRACE_SCOPE("tracer_inner");
+        }
+    }
+
+    std::thread th([]() {
+        TRACE_SCOPE("tracer_other");
+    });
+    th.join();
+
+    //! CHECK The events are recorded, the inner one inside the outer one
+    std::vector<JsonObject> outer = completeEvents("tracer_outer");
+    std::vector<JsonObject> inner = completeEvents("tracer_inner");
+    std::vector<JsonObject> other = completeEvents("tracer_other");
+    ASSERT_EQ(outer.size(), 1);
+    ASSERT_EQ(inner.size(), 1);
+    ASSERT_EQ(other.size(), 1);
+
+    double outerBegin = outer.front().value("ts").toDouble();
+    double outerEnd = outerBegin + outer.front().value("dur").toDouble();
+    double innerBegin = inner.front().value("ts").toDouble();
+    double innerEnd = innerBegin + inner.front().value("dur").toDouble();
+    EXPECT_LE(outerBegin, innerBegin);
+    EXPECT_GE(outerEnd, innerEnd);
+
+    //! CHECK The threads are different
+    EXPECT_EQ(outer.front().value("tid").toInt(), inner.front().value("tid").toInt());
+    EXPECT_NE(outer.front().value("tid").toInt(), other.front().value("tid").toInt());
+}
+
+TEST_F(Global_TracerTests, RestartDropsOldEvents)
+{
+    Tracer::setEnabled(true);
+    {
+        TRACE_SCOPE("tracer_old");
+    }
+
+    //! DO Start a new trace
+    Tracer::setEnabled(false);
+    Tracer::setEnabled(true);
+    {
+        TRACE_SCOPE("tracer_new");
+    }
+
+    //! CHECK Only the events of the new trace are exported
+    EXPECT_TRUE(completeEvents("tracer_old").empty());
+    EXPECT_EQ(completeEvents("tracer_new").size(), 1);
+}
+
+TEST_F(Global_TracerTests, RingBufferKeepsNewest)
+{
+    size_t capacity = Tracer::threadCapacity();
+    Tracer::setThreadCapacity(4);
+    Tracer::setEnabled(true);
+
+    //! DO Trace more scopes than fit in the buffer of a new thread
+    std::thread th([]() {
+        for (int i = 0; i < 10; ++i) {
+            TRACE_SCOPE("tracer_ring");
+        }
+    });
+    th.join();
+
+    Tracer::setThreadCapacity(capacity);
+
+    //! CHECK Only the newest events are kept
+    EXPECT_EQ(completeEvents("tracer_ring").size(), 4);
+}
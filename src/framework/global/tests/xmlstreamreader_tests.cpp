@@ -0,0 +1,355 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "serialization/xmlstreamreader.h"
+#include "io/dir.h"
+#include "io/file.h"
+
+#include "log.h"
+
+using namespace muse;
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+};
+
+static ByteArray xmlData(const char* str)
+{
+    return ByteArray(str);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Tokens)
+{
+    //! GIVEN Some document
+    ByteArray data = xmlData("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                             "<museScore version=\"4.50\">\n"
+                             "  <!-- comment -->\n"
+                             "  <Score>\n"
+                             "    <Division>480</Division>\n"
+                             "    <empty/>\n"
+                             "  </Score>\n"
+                             "</museScore>\n");
+
+    XmlStreamReader reader(data);
+
+    //! CHECK Tokens in the document order
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::StartDocument);
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(reader.name(), "museScore");
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::Comment);
+    EXPECT_EQ(reader.asciiText(), " comment ");
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(reader.name(), "Score");
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(reader.name(), "Division");
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::Characters);
+    EXPECT_EQ(reader.asciiText(), "480");
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(reader.name(), "Division");
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(reader.name(), "empty");
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(reader.name(), "empty");
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(reader.name(), "Score");
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(reader.name(), "museScore");
+
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndDocument);
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::Invalid);
+    EXPECT_FALSE(reader.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, EmptyElementFollowedByComment)
+{
+    //! GIVEN An empty element followed by a comment
+    XmlStreamReader reader(xmlData("<a><b/><!-- c --><d>1</d></a>"));
+
+    //! CHECK The empty element is closed before the comment
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.name(), "a");
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.name(), "b");
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::Comment);
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.name(), "d");
+    EXPECT_EQ(reader.readInt(), 1);
+    EXPECT_FALSE(reader.readNextStartElement());
+    EXPECT_EQ(reader.name(), "a");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Attributes)
+{
+    //! GIVEN An element with attributes
+    XmlStreamReader reader(xmlData("<note pitch=\"60\" tpc = '14' velo=\"0.5\" name=\"C&amp;D &#x263A;\"/>"));
+
+    EXPECT_TRUE(reader.readNextStartElement());
+
+    //! CHECK Values
+    EXPECT_TRUE(reader.hasAttribute("pitch"));
+    EXPECT_FALSE(reader.hasAttribute("pitc"));
+    EXPECT_EQ(reader.intAttribute("pitch"), 60);
+    EXPECT_EQ(reader.intAttribute("tpc"), 14);
+    EXPECT_EQ(reader.intAttribute("none", -1), -1);
+    EXPECT_DOUBLE_EQ(reader.doubleAttribute("velo"), 0.5);
+    EXPECT_EQ(reader.asciiAttribute("pitch"), "60");
+    EXPECT_EQ(reader.asciiAttribute("none", "def"), "def");
+    EXPECT_EQ(reader.attribute("name"), String(u"C&D ☺"));
+
+    //! CHECK Lists of attributes
+    const std::vector<XmlStreamReader::AsciiAttribute>& ascii = reader.asciiAttributes();
+    ASSERT_EQ(ascii.size(), 4);
+    EXPECT_EQ(ascii.at(0).name, "pitch");
+    EXPECT_EQ(ascii.at(1).name, "tpc");
+    EXPECT_EQ(ascii.at(1).value, "14");
+
+    std::vector<XmlStreamReader::Attribute> attrs = reader.attributes();
+    ASSERT_EQ(attrs.size(), 4);
+    EXPECT_EQ(attrs.at(3).name, "name");
+    EXPECT_EQ(attrs.at(3).value, String(u"C&D ☺"));
+
+    //! CHECK No attributes after the start element
+    EXPECT_EQ(reader.readNext(), XmlStreamReader::EndElement);
+    EXPECT_FALSE(reader.hasAttribute("pitch"));
+    EXPECT_TRUE(reader.asciiAttributes().empty());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Text)
+{
+    //! GIVEN Texts with entities, line breaks, whitespace and CDATA
+    XmlStreamReader reader(xmlData("<a>\n"
+                                   "  <b>x &lt; y &amp;&amp; y &gt; z &unknown; &#65;&#x42;</b>\n"
+                                   "  <c>line1\r\nline2\rline3</c>\n"
+                                   "  <d>  spaced  </d>\n"
+                                   "  <e><![CDATA[<raw> &amp;]]></e>\n"
+                                   "  <f>1.5</f>\n"
+                                   "  <g></g>\n"
+                                   "</a>"));
+
+    EXPECT_TRUE(reader.readNextStartElement());
+
+    //! CHECK Decoded texts
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.readText(), String(u"x < y && y > z &unknown; AB"));
+
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.readAsciiText(), "line1\nline2\nline3");
+
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.readAsciiText(), "  spaced  ");
+
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.readAsciiText(), "<raw> &amp;");
+
+    EXPECT_TRUE(reader.readNextStartElement());
+    bool ok = false;
+    EXPECT_DOUBLE_EQ(reader.readDouble(&ok), 1.5);
+    EXPECT_TRUE(ok);
+
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_TRUE(reader.readText().empty());
+
+    EXPECT_FALSE(reader.readNextStartElement());
+    EXPECT_FALSE(reader.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, DtdEntities)
+{
+    //! GIVEN A document with an internal DTD subset declaring entities
+    XmlStreamReader reader(xmlData("<?xml version=\"1.0\"?>\n"
+                                   "<!DOCTYPE museScore [\n"
+                                   "  <!ENTITY ext \"2.5\">\n"
+                                   "  ]>\n"
+                                   "<museScore><render>m:0:&ext;</render></museScore>"));
+
+    //! CHECK The entity is substituted in the text
+    while (reader.readNextStartElement()) {
+        if (reader.name() == "render") {
+            break;
+        }
+    }
+
+    EXPECT_EQ(reader.name(), "render");
+    EXPECT_EQ(reader.readText(), String(u"m:0:2.5"));
+    EXPECT_FALSE(reader.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, SkipCurrentElement)
+{
+    //! GIVEN Nested elements
+    XmlStreamReader reader(xmlData("<a><b><c x=\"1\"><d/>text</c></b><e>2</e></a>"));
+
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.name(), "b");
+
+    //! DO Skip the whole <b>
+    reader.skipCurrentElement();
+
+    //! CHECK
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.name(), "e");
+    EXPECT_EQ(reader.readInt(), 2);
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Utf16)
+{
+    //! GIVEN A document in UTF-16
+    String str = u"<a b=\"ä\">ö</a>";
+    ByteArray data;
+    data.push_back(reinterpret_cast<const uint8_t*>("\xFF\xFE"), 2);
+    for (size_t i = 0; i < str.size(); ++i) {
+        const char16_t ch = str.at(i).unicode();
+        const uint8_t bytes[2] = { static_cast<uint8_t>(ch & 0xFF), static_cast<uint8_t>(ch >> 8) };
+        data.push_back(bytes, 2);
+    }
+
+    XmlStreamReader reader(data);
+
+    //! CHECK
+    EXPECT_TRUE(reader.readNextStartElement());
+    EXPECT_EQ(reader.attribute("b"), String(u"ä"));
+    EXPECT_EQ(reader.readText(), String(u"ö"));
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, Errors)
+{
+    {
+        //! GIVEN A mismatched end tag on the third line
+        XmlStreamReader reader(xmlData("<a>\n<b>\n</c>\n</a>"));
+
+        //! DO Read until the error
+        while (reader.readNext() != XmlStreamReader::Invalid) {
+        }
+
+        //! CHECK
+        EXPECT_EQ(reader.error(), XmlStreamReader::NotWellFormedError);
+        EXPECT_EQ(reader.lineNumber(), 3);
+        EXPECT_FALSE(reader.errorString().empty());
+    }
+
+    {
+        //! GIVEN A truncated document
+        XmlStreamReader reader(xmlData("<a>\n<b>text</b>\n"));
+
+        //! CHECK The tokens before the error are read
+        EXPECT_TRUE(reader.readNextStartElement());
+        EXPECT_TRUE(reader.readNextStartElement());
+        EXPECT_EQ(reader.readAsciiText(), "text");
+        EXPECT_FALSE(reader.isError());
+
+        EXPECT_FALSE(reader.readNextStartElement());
+        EXPECT_TRUE(reader.atEnd());
+        EXPECT_EQ(reader.error(), XmlStreamReader::PrematureEndOfDocumentError);
+    }
+
+    {
+        //! GIVEN An unquoted attribute
+        XmlStreamReader reader(xmlData("<a b=1/>"));
+
+        //! CHECK
+        EXPECT_FALSE(reader.readNextStartElement());
+        EXPECT_EQ(reader.error(), XmlStreamReader::NotWellFormedError);
+    }
+
+    {
+        //! GIVEN An empty document
+        XmlStreamReader reader(xmlData(""));
+
+        //! CHECK
+        EXPECT_EQ(reader.readNext(), XmlStreamReader::Invalid);
+        EXPECT_TRUE(reader.isError());
+    }
+
+    {
+        //! GIVEN A valid document
+        XmlStreamReader reader(xmlData("<a/>"));
+        EXPECT_TRUE(reader.readNextStartElement());
+
+        //! DO Raise a custom error
+        reader.raiseError(u"custom");
+
+        //! CHECK
+        EXPECT_EQ(reader.error(), XmlStreamReader::CustomError);
+        EXPECT_EQ(reader.errorString(), String(u"custom"));
+    }
+}
+
+/**
+ * @brief Global_Ser_XmlStreamReaderTests_DISABLED_Benchmark_Read
+ * @details Reads every token of the vtest scores and of the MusicXML test files
+ */
+TEST_F(Global_Ser_XmlStreamReaderTests, DISABLED_Benchmark_Read)
+{
+    using clock = std::chrono::steady_clock;
+    using us = std::chrono::microseconds;
+
+    const std::vector<std::pair<io::path_t, std::vector<std::string> > > sets = {
+        { VTEST_SCORES_DIR, { "*.mscx" } },
+        { MUSICXML_TEST_FILES_DIR, { "*.xml", "*.musicxml" } }
+    };
+
+    for (const auto& set : sets) {
+        RetVal<io::paths_t> files = io::Dir::scanFiles(set.first, set.second);
+        ASSERT_TRUE(files.ret);
+
+        size_t bytes = 0;
+        size_t tokens = 0;
+        clock::duration total = clock::duration::zero();
+
+        for (const io::path_t& path : files.val) {
+            ByteArray data;
+            ASSERT_TRUE(io::File::readFile(path, data));
+            bytes += data.size();
+
+            clock::time_point start = clock::now();
+
+            XmlStreamReader reader(data);
+            while (reader.readNext() != XmlStreamReader::Invalid) {
+                if (reader.isStartElement()) {
+                    for (const XmlStreamReader::AsciiAttribute& a : reader.asciiAttributes()) {
+                        tokens += a.value.size() > 0;
+                    }
+                }
+                ++tokens;
+            }
+
+            total += clock::now() - start;
+            EXPECT_FALSE(reader.isError()) << path.toStdString();
+        }
+
+        const int64_t usecs = std::chrono::duration_cast<us>(total).count();
+        LOGI() << set.first << ": files: " << files.val.size() << ", bytes: " << bytes << ", tokens: " << tokens
+               << ", time: " << usecs << " us, " << (usecs > 0 ? bytes / static_cast<size_t>(usecs) : 0) << " MB/s";
+    }
+}
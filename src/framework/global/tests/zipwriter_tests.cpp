@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "io/buffer.h"
+#include "serialization/zipwriter.h"
+#include "serialization/zipreader.h"
+
+using namespace muse;
+using namespace muse::io;
+
+class Global_Ser_ZipWriterTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeXml(size_t lines, size_t seed)
+{
+    std::string xml;
+    for (size_t i = 0; i < lines; ++i) {
+        xml += "<Note><pitch>" + std::to_string((i * seed) % 128) + "</pitch></Note>\n";
+    }
+
+    return ByteArray(xml.c_str(), xml.size());
+}
+
+TEST_F(Global_Ser_ZipWriterTests, ZipWriter_WriteRead_ManyFiles)
+{
+    //! GIVEN Files of different sizes, big enough to be packed concurrently
+    std::vector<ByteArray> files;
+    for (size_t i = 0; i < 64; ++i) {
+        files.push_back(makeXml(100 * (i % 8) + 1, i));
+    }
+
+    //! DO Write them
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        buf.open(IODevice::WriteOnly);
+
+        ZipWriter writer(&buf);
+        for (size_t i = 0; i < files.size(); ++i) {
+            writer.addFile("file" + std::to_string(i) + ".xml", files.at(i));
+        }
+        writer.close();
+
+        EXPECT_FALSE(writer.hasError());
+    }
+
+    //! CHECK The files are in the order they were added and have the same data
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+
+    std::vector<ZipReader::FileInfo> infoList = reader.fileInfoList();
+    ASSERT_EQ(infoList.size(), files.size());
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string fileName = "file" + std::to_string(i) + ".xml";
+        EXPECT_EQ(infoList.at(i).filePath, path_t(fileName));
+        EXPECT_EQ(reader.fileData(fileName), files.at(i));
+    }
+}
+
+TEST_F(Global_Ser_ZipWriterTests, ZipWriter_StoreCompressedData)
+{
+    //! GIVEN A png image and an xml file
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    png += std::string(10000, 'a');
+    ByteArray pngData(png.c_str(), png.size());
+    ByteArray xmlData = makeXml(1000, 7);
+
+    //! DO Write them
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        buf.open(IODevice::WriteOnly);
+
+        ZipWriter writer(&buf);
+        writer.addFile("Thumbnails/thumbnail.png", pngData);
+        writer.addFile("score.mscx", xmlData);
+        writer.close();
+    }
+
+    //! CHECK The image is stored as is, the xml is deflated
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+
+    ZipReader::PackedFile packedPng = reader.packedFileData("Thumbnails/thumbnail.png");
+    EXPECT_EQ(packedPng.compressionMethod, 0);
+    EXPECT_EQ(ZipReader::unpack(packedPng), pngData);
+
+    ZipReader::PackedFile packedXml = reader.packedFileData("score.mscx");
+    EXPECT_EQ(packedXml.compressionMethod, 8);
+    EXPECT_LT(packedXml.data.size(), xmlData.size());
+    EXPECT_EQ(ZipReader::unpack(packedXml), xmlData);
+}
+
+TEST_F(Global_Ser_ZipWriterTests, ZipReader_UnpackBeginning)
+{
+    //! GIVEN A deflated xml file and a stored one
+    ByteArray xmlData = makeXml(1000, 7);
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    png += std::string(10000, 'a');
+    ByteArray pngData(png.c_str(), png.size());
+
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        buf.open(IODevice::WriteOnly);
+
+        ZipWriter writer(&buf);
+        writer.addFile("Thumbnails/thumbnail.png", pngData);
+        writer.addFile("score.mscx", xmlData);
+        writer.close();
+    }
+
+    Buffer buf(&zipData);
+    ZipReader reader(&buf);
+
+    //! CHECK Only the beginning is unpacked
+    ZipReader::PackedFile packedXml = reader.packedFileData("score.mscx");
+    ASSERT_EQ(packedXml.compressionMethod, 8);
+    EXPECT_EQ(ZipReader::unpack(packedXml, 100), xmlData.left(100));
+    EXPECT_EQ(ZipReader::unpack(packedXml, 5000), xmlData.left(5000));
+
+    ZipReader::PackedFile packedPng = reader.packedFileData("Thumbnails/thumbnail.png");
+    ASSERT_EQ(packedPng.compressionMethod, 0);
+    EXPECT_EQ(ZipReader::unpack(packedPng, 100), pngData.left(100));
+
+    //! CHECK A size beyond the file gives the whole file
+    EXPECT_EQ(ZipReader::unpack(packedXml, xmlData.size() + 1), xmlData);
+}
@@ -0,0 +1,233 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "runtime.h"
+#include "io/file.h"
+#include "types/bytearray.h"
+
+using namespace muse;
+
+namespace {
+struct Event {
+    std::atomic<const char*> name = nullptr;
+    std::atomic<int64_t> beginNs = 0;
+    std::atomic<int64_t> endNs = 0;
+};
+
+//! NOTE Written only by its thread, read by the export
+struct ThreadBuffer {
+    int tid = 0;
+    std::string threadName;
+    size_t capacity = 0;
+    std::unique_ptr<Event[]> events;
+    std::atomic<uint64_t> started = 0; // events being written or written
+    std::atomic<uint64_t> count = 0;   // events written
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+    size_t capacity = 1 << 16;
+    std::atomic<int64_t> startNs = 0;
+};
+
+static Registry& registry()
+{
+    static Registry r;
+    return r;
+}
+
+//! NOTE Buffers are kept after their thread is finished, so that its events can be exported
+static ThreadBuffer* registerThread()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto buf = std::make_unique<ThreadBuffer>();
+    buf->tid = static_cast<int>(r.buffers.size()) + 1;
+    buf->threadName = runtime::threadName();
+    buf->capacity = r.capacity;
+    buf->events = std::make_unique<Event[]>(r.capacity);
+
+    ThreadBuffer* ptr = buf.get();
+    r.buffers.push_back(std::move(buf));
+    return ptr;
+}
+
+static void appendEscaped(std::string& out, const char* str)
+{
+    for (const char* c = str; *c; ++c) {
+        switch (*c) {
+        case '"': out += "\\\"";
+            break;
+        case '\\': out += "\\\\";
+            break;
+        case '\n': out += "\\n";
+            break;
+        case '\t': out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(*c) < 0x20) {
+                char hex[8];
+                std::snprintf(hex, sizeof(hex), "\\u%04x", static_cast<unsigned char>(*c));
+                out += hex;
+            } else {
+                out += *c;
+            }
+        }
+    }
+}
+
+static void appendMicroseconds(std::string& out, int64_t ns)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(ns) / 1000.0);
+    out += buf;
+}
+}
+
+std::atomic<bool> Tracer::s_enabled = false;
+
+size_t Tracer::threadCapacity()
+{
+    return registry().capacity;
+}
+
+void Tracer::setThreadCapacity(size_t capacity)
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.capacity = std::max(capacity, size_t(1));
+}
+
+void Tracer::setEnabled(bool arg)
+{
+    if (arg) {
+        registry().startNs.store(nowNs(), std::memory_order_relaxed);
+    }
+
+    s_enabled.store(arg, std::memory_order_relaxed);
+}
+
+int64_t Tracer::nowNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::addEvent(const char* name, int64_t beginNs, int64_t endNs)
+{
+    static thread_local ThreadBuffer* buf = registerThread();
+
+    uint64_t idx = buf->count.load(std::memory_order_relaxed);
+    buf->started.store(idx + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Event& e = buf->events[idx % buf->capacity];
+    e.name.store(name, std::memory_order_relaxed);
+    e.beginNs.store(beginNs, std::memory_order_relaxed);
+    e.endNs.store(endNs, std::memory_order_relaxed);
+    buf->count.store(idx + 1, std::memory_order_release);
+}
+
+std::string Tracer::toChromeTraceJson()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    const int64_t startNs = r.startNs.load(std::memory_order_relaxed);
+
+    std::string out;
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    auto beginRecord = [&out, &first]() {
+        if (!first) {
+            out += ",";
+        }
+        out += "\n";
+        first = false;
+    };
+
+    for (const std::unique_ptr<ThreadBuffer>& buf : r.buffers) {
+        const std::string tid = std::to_string(buf->tid);
+
+        beginRecord();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"";
+        appendEscaped(out, buf->threadName.c_str());
+        out += "\"}}";
+
+        uint64_t count = buf->count.load(std::memory_order_acquire);
+        uint64_t from = count > buf->capacity ? count - buf->capacity : 0;
+
+        std::vector<Event> events(static_cast<size_t>(count - from));
+        for (uint64_t i = from; i < count; ++i) {
+            const Event& src = buf->events[i % buf->capacity];
+            Event& dst = events[static_cast<size_t>(i - from)];
+            dst.name.store(src.name.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            dst.beginNs.store(src.beginNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            dst.endNs.store(src.endNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        //! NOTE The thread may have overwritten the oldest events while copying, skip those
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t started = buf->started.load(std::memory_order_relaxed);
+        uint64_t validFrom = started > buf->capacity ? started - buf->capacity : 0;
+
+        for (uint64_t i = std::max(from, validFrom); i < count; ++i) {
+            const Event& e = events[static_cast<size_t>(i - from)];
+            const char* name = e.name.load(std::memory_order_relaxed);
+            int64_t beginNs = e.beginNs.load(std::memory_order_relaxed);
+            int64_t endNs = e.endNs.load(std::memory_order_relaxed);
+            if (!name || beginNs < startNs) {
+                continue;
+            }
+
+            beginRecord();
+            out += "{\"name\":\"";
+            appendEscaped(out, name);
+            out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+            appendMicroseconds(out, beginNs - startNs);
+            out += ",\"dur\":";
+            appendMicroseconds(out, endNs - beginNs);
+            out += "}";
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool Tracer::save(const std::string& filePath)
+{
+    std::string json = toChromeTraceJson();
+    Ret ret = io::File::writeFile(filePath, ByteArray(json.data(), json.size()));
+    return ret;
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_GLOBAL_TRACER_H
+#define MUSE_GLOBAL_TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace muse {
+//! NOTE Records scoped events (TRACEFUNC, TRACEFUNC_C, TRACE_SCOPE) with the thread they ran on,
+//! to see on a timeline which thread did what and how it overlapped with the others.
+//! The result is exported as Chrome trace JSON, which can be opened in ui.perfetto.dev or chrome://tracing
+//!
+//! Tracing is disabled by default, then a scope costs one relaxed atomic load.
+//! When enabled, each thread writes to its own ring buffer without locks,
+//! so the newest events of a thread are kept and the oldest are overwritten.
+class Tracer
+{
+public:
+
+    //! NOTE Events per thread, must be set before tracing is enabled
+    static size_t threadCapacity();
+    static void setThreadCapacity(size_t capacity);
+
+    static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    //! NOTE Enabling starts a new trace, the events recorded before are dropped
+    static void setEnabled(bool arg);
+
+    static int64_t nowNs();
+
+    //! NOTE The name must live as long as the process (string literal or static string)
+    static void addEvent(const char* name, int64_t beginNs, int64_t endNs);
+
+    static std::string toChromeTraceJson();
+    static bool save(const std::string& filePath);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name)
+    {
+        if (Tracer::enabled()) {
+            m_name = name;
+            m_beginNs = Tracer::nowNs();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_name) {
+            Tracer::addEvent(m_name, m_beginNs, Tracer::nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    int64_t m_beginNs = 0;
+};
+}
+
+//! NOTE Only for the tracer, unlike TRACEFUNC doesn't go to the profiler, so it's cheap enough for the audio threads
+#define TRACE_SCOPE(name) muse::TraceScope __traceScope(name)
+
+#endif // MUSE_GLOBAL_TRACER_H
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "async/channel.h"
+#include "async/notification.h"
 #include "realfn.h"
 
 #include "mpetypes.h"
@@ -47,7 +48,7 @@ using PlaybackParamList = std::vector<PlaybackParam>;
 using PlaybackParamMap = std::map<timestamp_t, PlaybackParamList>;
 using PlaybackParamLayers = std::map<layer_idx_t, PlaybackParamMap>;
 
-using MainStreamChanges = async::Channel<PlaybackEventsMap, DynamicLevelLayers, PlaybackParamLayers>;
+using MainStreamChanges = async::Channel<PlaybackEventsMap, DynamicLevelLayers, PlaybackParamLayers, uint64_t /*revision*/>;
 using OffStreamChanges = async::Channel<PlaybackEventsMap, PlaybackParamList>;
 
 struct ArrangementContext
@@ -315,13 +316,40 @@ struct PlaybackParam {
     }
 };
 
+//! NOTE The events of [from, to] (by the key timestamp) have been replaced by the given ones
+struct PlaybackEventsChanges {
+    timestamp_t from = 0;
+    timestamp_t to = 0;
+    PlaybackEventsMap events;
+};
+
+using PlaybackEventsChangesList = std::vector<PlaybackEventsChanges>;
+using MainStreamDelta = async::Channel<PlaybackEventsChangesList, DynamicLevelLayers, PlaybackParamLayers, uint64_t /*revision*/>;
+
+inline void applyChanges(PlaybackEventsMap& events, const PlaybackEventsChangesList& changesList)
+{
+    for (const PlaybackEventsChanges& changes : changesList) {
+        if (changes.from > changes.to) {
+            continue;
+        }
+
+        events.erase(events.lower_bound(changes.from), events.upper_bound(changes.to));
+        events.insert(changes.events.cbegin(), changes.events.cend());
+    }
+}
+
 struct PlaybackData {
     PlaybackEventsMap originEvents;
     PlaybackSetupData setupData;
     DynamicLevelLayers dynamics;
     PlaybackParamLayers params;
 
-    MainStreamChanges mainStream;
+    //! NOTE Each send of the main stream or of a delta increments the revision,
+    //! a consumer which misses a delta requests the whole stream again
+    uint64_t mainStreamRevision = 0;
+    MainStreamChanges mainStream; // all the events
+    MainStreamDelta mainStreamDelta; // only the changed ranges
+    async::Notification mainStreamRequested;
     OffStreamChanges offStream;
 
     bool operator==(const PlaybackData& other) const
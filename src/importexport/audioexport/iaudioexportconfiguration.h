@@ -46,6 +46,10 @@ public:
     virtual const std::vector<int>& availableSampleRates() const = 0;
 
     virtual muse::audio::samples_t exportBufferSize() const = 0;
+
+    //! NOTE Besides the mix, write the audio of every track to its own file
+    virtual bool exportStems() const = 0;
+    virtual void setExportStems(bool exportStems) = 0;
 };
 }
 
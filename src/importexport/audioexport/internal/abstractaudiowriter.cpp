@@ -27,7 +27,9 @@
 #include <QThread>
 
 #include "global/containers.h"
+#include "audio/audioutils.h"
 #include "audio/iaudiooutput.h"
+#include "audio/itracks.h"
 
 #include "log.h"
 
@@ -112,8 +114,10 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
         playbackController()->setNotation(globalContext()->currentNotation());
     });
 
+    const bool exportStems = configuration()->exportStems();
+
     playback()->sequenceIdList()
-    .onResolve(this, [this, path, &format](const TrackSequenceIdList& sequenceIdList) {
+    .onResolve(this, [this, path, &format, exportStems](const TrackSequenceIdList& sequenceIdList) {
         m_progress.started.notify();
 
         for (const TrackSequenceId sequenceId : sequenceIdList) {
@@ -122,18 +126,11 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
                 m_progress.progressChanged.send(current, total, title);
             });
 
-            playback()->audioOutput()->saveSoundTrack(sequenceId, muse::io::path_t(path), std::move(format))
-            .onResolve(this, [this, path](const bool /*result*/) {
-                LOGD() << "Successfully saved sound track by path: " << path;
-                m_writeRet = muse::make_ok();
-                m_isCompleted = true;
-                m_progress.finished.send(muse::make_ok());
-            })
-            .onReject(this, [this](int errorCode, const std::string& msg) {
-                m_writeRet = Ret(errorCode, msg);
-                m_isCompleted = true;
-                m_progress.finished.send(make_ret(errorCode, msg));
-            });
+            if (exportStems) {
+                saveSoundTrackStems(sequenceId, muse::io::path_t(path), format);
+            } else {
+                saveSoundTrack(sequenceId, muse::io::path_t(path), format);
+            }
         }
     })
     .onReject(this, [](int errorCode, const std::string& msg) {
@@ -148,6 +145,73 @@ Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation,
     return m_writeRet;
 }
 
+void AbstractAudioWriter::saveSoundTrack(const TrackSequenceId sequenceId, const muse::io::path_t& path, const SoundTrackFormat& format)
+{
+    playback()->audioOutput()->saveSoundTrack(sequenceId, path, format)
+    .onResolve(this, [this, path](const bool /*result*/) {
+        LOGD() << "Successfully saved sound track by path: " << path;
+        onSoundTrackSaved(muse::make_ok());
+    })
+    .onReject(this, [this](int errorCode, const std::string& msg) {
+        onSoundTrackSaved(make_ret(errorCode, msg));
+    });
+}
+
+void AbstractAudioWriter::saveSoundTrackStems(const TrackSequenceId sequenceId, const muse::io::path_t& path,
+                                              const SoundTrackFormat& format)
+{
+    //! NOTE Only the tracks of the instruments get their own files (not the metronome, for example)
+    std::vector<TrackId> trackIdList;
+    IMasterNotationPtr masterNotation = globalContext()->currentMasterNotation();
+
+    for (const auto& pair : playbackController()->instrumentTrackIdMap()) {
+        if (masterNotation && masterNotation->parts()->part(pair.first.partId)) {
+            trackIdList.push_back(pair.second);
+        }
+    }
+
+    if (trackIdList.empty()) {
+        saveSoundTrack(sequenceId, path, format);
+        return;
+    }
+
+    //! NOTE The files are named after the tracks, as they are shown in the mixer
+    auto trackNames = std::make_shared<std::map<TrackId, std::string> >();
+
+    for (const TrackId trackId : trackIdList) {
+        auto onNameReceived = [this, sequenceId, path, format, trackNames, trackId, count = trackIdList.size()](const std::string& name) {
+            trackNames->emplace(trackId, name);
+            if (trackNames->size() < count) {
+                return;
+            }
+
+            const StemDestinations stemDestinations = makeStemDestinations(path, *trackNames);
+
+            playback()->audioOutput()->saveSoundTrackStems(sequenceId, path, stemDestinations, format)
+            .onResolve(this, [this, path](const SoundTrackStemsResult& result) {
+                LOGD() << "Successfully saved sound track and " << result.stems.size() << " stems by path: " << path;
+                onSoundTrackSaved(muse::make_ok());
+            })
+            .onReject(this, [this](int errorCode, const std::string& msg) {
+                onSoundTrackSaved(make_ret(errorCode, msg));
+            });
+        };
+
+        playback()->tracks()->trackName(sequenceId, trackId)
+        .onResolve(this, onNameReceived)
+        .onReject(this, [onNameReceived, trackId](int, const std::string&) {
+            onNameReceived(std::to_string(trackId));
+        });
+    }
+}
+
+void AbstractAudioWriter::onSoundTrackSaved(const Ret& ret)
+{
+    m_writeRet = ret;
+    m_isCompleted = true;
+    m_progress.finished.send(ret);
+}
+
 INotationWriter::UnitType AbstractAudioWriter::unitTypeFromOptions(const Options& options) const
 {
     std::vector<UnitType> supported = supportedUnitTypes();
@@ -55,6 +55,12 @@ protected:
     muse::Ret doWriteAndWait(notation::INotationPtr notation, muse::io::IODevice& dstDevice, const muse::audio::SoundTrackFormat& format);
 
 private:
+    void saveSoundTrack(const muse::audio::TrackSequenceId sequenceId, const muse::io::path_t& path,
+                        const muse::audio::SoundTrackFormat& format);
+    void saveSoundTrackStems(const muse::audio::TrackSequenceId sequenceId, const muse::io::path_t& path,
+                             const muse::audio::SoundTrackFormat& format);
+    void onSoundTrackSaved(const muse::Ret& ret);
+
     UnitType unitTypeFromOptions(const Options& options) const;
 
     muse::Progress m_progress;
@@ -31,11 +31,13 @@ using namespace muse::audio;
 
 static const Settings::Key EXPORT_SAMPLE_RATE_KEY("iex_audioexport", "export/audio/sampleRate");
 static const Settings::Key EXPORT_MP3_BITRATE("iex_audioexport", "export/audio/mp3Bitrate");
+static const Settings::Key EXPORT_STEMS_KEY("iex_audioexport", "export/audio/stems");
 
 void AudioExportConfiguration::init()
 {
     settings()->setDefaultValue(EXPORT_SAMPLE_RATE_KEY, Val(44100));
     settings()->setDefaultValue(EXPORT_MP3_BITRATE, Val(128));
+    settings()->setDefaultValue(EXPORT_STEMS_KEY, Val(false));
 }
 
 int AudioExportConfiguration::exportMp3Bitrate() const
@@ -79,3 +81,13 @@ samples_t AudioExportConfiguration::exportBufferSize() const
 {
     return 4096;
 }
+
+bool AudioExportConfiguration::exportStems() const
+{
+    return settings()->value(EXPORT_STEMS_KEY).toBool();
+}
+
+void AudioExportConfiguration::setExportStems(bool exportStems)
+{
+    settings()->setSharedValue(EXPORT_STEMS_KEY, Val(exportStems));
+}
@@ -41,6 +41,9 @@ public:
 
     muse::audio::samples_t exportBufferSize() const override;
 
+    bool exportStems() const override;
+    void setExportStems(bool exportStems) override;
+
 private:
     std::optional<int> m_exportMp3BitrateOverride = std::nullopt;
 };
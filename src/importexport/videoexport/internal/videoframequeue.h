@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_VIDEOFRAMEQUEUE_H
+#define MU_IMPORTEXPORT_VIDEOFRAMEQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <QImage>
+
+namespace mu::iex::videoexport {
+//! NOTE Bounded queue between the thread that rasterizes frames and the thread that encodes them.
+//! push() blocks while the queue is full, so the rasterizer can't run ahead of the encoder
+//! by more than `capacity` frames (a 4K frame is ~33 MB)
+class VideoFrameQueue
+{
+public:
+    explicit VideoFrameQueue(size_t capacity)
+        : m_capacity(capacity > 0 ? capacity : 1) {}
+
+    //! NOTE Returns false if the queue was closed
+    bool push(QImage frame)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this]() { return m_closed || m_frames.size() < m_capacity; });
+        if (m_closed) {
+            return false;
+        }
+
+        m_frames.push_back(std::move(frame));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    //! NOTE Blocks until a frame is available; returns false when the queue is closed and drained
+    bool pop(QImage& frame)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return m_closed || !m_frames.empty(); });
+        if (m_frames.empty()) {
+            return false;
+        }
+
+        frame = std::move(m_frames.front());
+        m_frames.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+private:
+    const size_t m_capacity = 1;
+    std::deque<QImage> m_frames;
+    bool m_closed = false;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+}
+
+#endif // MU_IMPORTEXPORT_VIDEOFRAMEQUEUE_H
@@ -22,6 +22,7 @@
 #include "videowriter.h"
 
 #include "videoencoder.h"
+#include "videoframequeue.h"
 
 #include "engraving/dom/page.h"
 #include "engraving/dom/repeatlist.h"
@@ -31,6 +32,9 @@
 
 #include "log.h"
 
+#include <deque>
+#include <thread>
+
 #include <QPainter>
 
 using namespace mu::iex::videoexport;
@@ -174,19 +178,66 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
     score->setLayoutAll();
     score->update();
 
-    // Setup painting
-    QImage frame(config.width, config.height, QImage::Format_RGB32);
-    frame.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
-    frame.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+    auto painting = masterNotation->notation()->painting();
 
-    QPainter qp(&frame);
-    qp.setRenderHint(QPainter::Antialiasing, true);
-    qp.setRenderHint(QPainter::TextAntialiasing, true);
-    muse::RectF frameRect = muse::RectF::fromQRectF(QRectF(frame.rect()));
+    //! NOTE The score doesn't change while exporting, so each page is rasterized once
+    //! and every frame is a copy of its page raster with the cursor composited on top.
+    //! Frames usually go through the pages in order, but repeats may jump back,
+    //! so a few recent pages are kept
+    struct PageRaster {
+        int pageNo = -1;
+        QImage image;
+        QTransform transform; // of the page coordinates, the cursor is drawn with it
+    };
 
-    Painter painter(&qp, "video_writer");
+    static constexpr size_t PAGE_CACHE_CAPACITY = 4;
+    std::deque<PageRaster> pageCache;
+
+    auto pageRaster = [&](const Page* page) -> const PageRaster& {
+        const int pageNo = static_cast<int>(page->no());
+        for (auto it = pageCache.begin(); it != pageCache.end(); ++it) {
+            if (it->pageNo == pageNo) {
+                if (it != pageCache.begin()) {
+                    PageRaster raster = std::move(*it);
+                    pageCache.erase(it);
+                    pageCache.push_front(std::move(raster));
+                }
+                return pageCache.front();
+            }
+        }
 
-    auto painting = masterNotation->notation()->painting();
+        QImage image(config.width, config.height, QImage::Format_RGB32);
+        image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+        image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+        image.fill(Qt::white);
+
+        QTransform transform;
+        {
+            QPainter qp(&image);
+            qp.setRenderHint(QPainter::Antialiasing, true);
+            qp.setRenderHint(QPainter::TextAntialiasing, true);
+
+            {
+                Painter painter(&qp, "video_writer");
+
+                INotationPainting::Options opt;
+                opt.fromPage = pageNo;
+                opt.toPage = pageNo;
+                opt.deviceDpi = CANVAS_DPI;
+
+                painting->paintPrint(&painter, opt);
+            }
+
+            //! NOTE paintPrint leaves the page viewport set, the cursor is drawn in the same coordinates
+            transform = qp.combinedTransform();
+        }
+
+        if (pageCache.size() >= PAGE_CACHE_CAPACITY) {
+            pageCache.pop_back();
+        }
+        pageCache.push_front({ pageNo, std::move(image), transform });
+        return pageCache.front();
+    };
 
     // Setup duration
     INotationPlaybackPtr playback = masterNotation->playback();
@@ -208,11 +259,24 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
         return nullptr;
     };
 
-    const Color CURSOR_COLOR = Color(0, 0, 255, 50);
+    const QColor CURSOR_COLOR = QColor(0, 0, 255, 50);
 
     PlaybackCursor cursor(application()->iocContext());
     cursor.setNotation(masterNotation->notation());
 
+    //! NOTE Colour conversion and encoding run on their own thread, overlapped with compositing the next frames.
+    //! They share the encoder's YUV frame, so they stay on the same thread
+    //! (the H.264 encoder itself is multi-threaded)
+    static constexpr size_t FRAME_QUEUE_CAPACITY = 4;
+    VideoFrameQueue frameQueue(FRAME_QUEUE_CAPACITY);
+
+    std::thread encodeThread([&encoder, &frameQueue]() {
+        QImage frame;
+        while (frameQueue.pop(frame)) {
+            encoder.encodeImage(frame);
+        }
+    });
+
     for (int f = 0; f < frameCount; f++) {
         float currentTimeSec = (qreal)f / config.fps;
         currentTimeSec -= config.leadingSec;
@@ -230,14 +294,8 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
             break;
         }
 
-        INotationPainting::Options opt;
-        opt.fromPage = page->no();
-        opt.toPage = opt.fromPage;
-        opt.deviceDpi = CANVAS_DPI;
-
-        painter.fillRect(frameRect, Color::WHITE);
-
-        painting->paintPrint(&painter, opt);
+        const PageRaster& raster = pageRaster(page);
+        QImage frame = raster.image.copy();
 
         cursor.move(tick);
 
@@ -245,11 +303,19 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
         muse::PointF pagePos = page->pos();
         muse::RectF cursorAbsRect = cursorRect.translated(-pagePos);
 
-        painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+        {
+            QPainter qp(&frame);
+            qp.setRenderHint(QPainter::Antialiasing, true);
+            qp.setTransform(raster.transform);
+            qp.fillRect(cursorAbsRect.toQRectF(), CURSOR_COLOR);
+        }
 
-        encoder.encodeImage(frame);
+        frameQueue.push(std::move(frame));
     }
 
+    frameQueue.close();
+    encodeThread.join();
+
     encoder.close();
 
     return muse::make_ok();
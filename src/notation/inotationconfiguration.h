@@ -159,6 +159,10 @@ public:
     virtual int notePlayDurationMilliseconds() const = 0;
     virtual void setNotePlayDurationMilliseconds(int durationMs) = 0;
 
+    //! NOTE The parts of a score are read when they are first needed, not on load
+    virtual bool readExcerptsOnDemand() const = 0;
+    virtual void setReadExcerptsOnDemand(bool value) = 0;
+
     virtual void setTemplateModeEnabled(std::optional<bool> enabled) = 0;
     virtual void setTestModeEnabled(std::optional<bool> enabled) = 0;
 
@@ -46,6 +46,11 @@ public:
     virtual muse::SizeF pageSizeInch(const Options& opt) const = 0;
 
     virtual void paintView(muse::draw::Painter* painter, const muse::RectF& frameRect, bool isPrinting) = 0;
+
+    //! NOTE Paints one page in page coordinates, without the interaction overlays (grips, anchor lines, etc.)
+    virtual void paintPage(muse::draw::Painter* painter, int pageNo, bool isPrinting) = 0;
+    virtual void paintInteraction(muse::draw::Painter* painter) = 0;
+
     virtual void paintPdf(muse::draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(muse::draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(muse::draw::Painter* painter, const Options& opt) = 0;
@@ -39,6 +39,7 @@ ExcerptNotation::~ExcerptNotation()
 {
     //! NOTE: do not destroy the score here, because it may be stored in UndoStack
     //! (after opening an excerpt via the Parts dialog and pressing ctrl + z)
+    m_scoreDeferred = false;
     setScore(nullptr);
 }
 
@@ -48,10 +49,15 @@ void ExcerptNotation::init()
         return;
     }
 
-    setScore(m_excerpt->excerptScore());
+    //! NOTE The score of a deferred excerpt is set when it is first needed, see score()
+    m_scoreDeferred = m_excerpt->isDeferred();
 
-    if (isEmpty()) {
-        fillWithDefaultInfo();
+    if (!m_scoreDeferred) {
+        setScore(m_excerpt->excerptScore());
+
+        if (isEmpty()) {
+            fillWithDefaultInfo();
+        }
     }
 
     m_inited = true;
@@ -60,6 +66,7 @@ void ExcerptNotation::init()
 void ExcerptNotation::reinit(engraving::Excerpt* newExcerpt)
 {
     m_inited = false;
+    m_scoreDeferred = false;
     m_excerpt = newExcerpt;
 
     init();
@@ -82,6 +89,27 @@ bool ExcerptNotation::isEmpty() const
     return m_excerpt->parts().empty();
 }
 
+bool ExcerptNotation::isOpen() const
+{
+    //! NOTE A deferred excerpt is never open, there is no need to read it to find out
+    if (m_scoreDeferred && m_excerpt->isDeferred()) {
+        return false;
+    }
+
+    return Notation::isOpen();
+}
+
+mu::engraving::Score* ExcerptNotation::score() const
+{
+    if (m_scoreDeferred) {
+        m_scoreDeferred = false;
+        m_excerpt->readDeferred();
+        const_cast<ExcerptNotation*>(this)->setScore(m_excerpt->excerptScore());
+    }
+
+    return Notation::score();
+}
+
 void ExcerptNotation::fillWithDefaultInfo()
 {
     TRACEFUNC;
@@ -171,6 +199,8 @@ INotationPtr ExcerptNotation::notation()
 
 IExcerptNotationPtr ExcerptNotation::clone() const
 {
+    m_excerpt->readDeferred();
+
     mu::engraving::Excerpt* copy = new mu::engraving::Excerpt(*m_excerpt);
     copy->markAsCustom();
 
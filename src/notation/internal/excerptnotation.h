@@ -43,6 +43,8 @@ public:
     bool isCustom() const override;
     bool isEmpty() const override;
 
+    bool isOpen() const override;
+
     QString name() const override;
     void setName(const QString& name) override;
     void undoSetName(const QString& name) override;
@@ -54,11 +56,15 @@ public:
     INotationPtr notation() override;
     IExcerptNotationPtr clone() const override;
 
+protected:
+    mu::engraving::Score* score() const override;
+
 private:
     void fillWithDefaultInfo();
 
     mu::engraving::Excerpt* m_excerpt = nullptr;
     bool m_inited = false;
+    mutable bool m_scoreDeferred = false;
 };
 }
 
@@ -665,7 +665,8 @@ void MasterNotation::updateExcerpts()
         }
 
         IExcerptNotationPtr excerptNotation = createAndInitExcerptNotation(excerpt, iocContext());
-        bool open = excerpt->excerptScore()->isOpen();
+        //! NOTE A deferred excerpt is never open
+        bool open = excerpt->excerptScore() && excerpt->excerptScore()->isOpen();
         if (open) {
             excerptNotation->notation()->elements()->msScore()->doLayout();
         }
@@ -75,6 +75,7 @@ static const Settings::Key COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE(module_name
 static const Settings::Key WARN_GUITAR_BENDS(module_name, "score/note/warnGuitarBends");
 static const Settings::Key REALTIME_DELAY(module_name, "io/midi/realtimeDelay");
 static const Settings::Key NOTE_DEFAULT_PLAY_DURATION(module_name, "score/note/defaultPlayDuration");
+static const Settings::Key READ_EXCERPTS_ON_DEMAND(module_name, "score/readExcerptsOnDemand");
 
 static const Settings::Key FIRST_SCORE_ORDER_LIST_KEY(module_name, "application/paths/scoreOrderList1");
 static const Settings::Key SECOND_SCORE_ORDER_LIST_KEY(module_name, "application/paths/scoreOrderList2");
@@ -193,6 +194,13 @@ void NotationConfiguration::init()
     settings()->setDefaultValue(REALTIME_DELAY, Val(750));
     settings()->setDefaultValue(NOTE_DEFAULT_PLAY_DURATION, Val(500));
 
+    settings()->setDefaultValue(READ_EXCERPTS_ON_DEMAND, Val(true));
+    settings()->setDescription(READ_EXCERPTS_ON_DEMAND, muse::qtrc("notation", "Read parts when they are first opened").toStdString());
+    settings()->setCanBeManuallyEdited(READ_EXCERPTS_ON_DEMAND, true);
+    settings()->valueChanged(READ_EXCERPTS_ON_DEMAND).onReceive(this, [](const Val& val) {
+        mu::engraving::MScore::deferExcerpts = val.toBool();
+    });
+
     settings()->setDefaultValue(FIRST_SCORE_ORDER_LIST_KEY,
                                 Val(globalConfiguration()->appDataPath().toStdString() + "instruments/orders.xml"));
     settings()->valueChanged(FIRST_SCORE_ORDER_LIST_KEY).onReceive(nullptr, [this](const Val&) {
@@ -243,6 +251,7 @@ void NotationConfiguration::init()
     mu::engraving::MScore::warnPitchRange = colorNotesOutsideOfUsablePitchRange();
     mu::engraving::MScore::warnGuitarBends = warnGuitarBends();
     mu::engraving::MScore::defaultPlayDuration = notePlayDurationMilliseconds();
+    mu::engraving::MScore::deferExcerpts = readExcerptsOnDemand();
 
     mu::engraving::MScore::setHRaster(DEFAULT_GRID_SIZE_SPATIUM);
     mu::engraving::MScore::setVRaster(DEFAULT_GRID_SIZE_SPATIUM);
@@ -730,6 +739,17 @@ void NotationConfiguration::setNotePlayDurationMilliseconds(int durationMs)
     settings()->setSharedValue(NOTE_DEFAULT_PLAY_DURATION, Val(durationMs));
 }
 
+bool NotationConfiguration::readExcerptsOnDemand() const
+{
+    return settings()->value(READ_EXCERPTS_ON_DEMAND).toBool();
+}
+
+void NotationConfiguration::setReadExcerptsOnDemand(bool value)
+{
+    mu::engraving::MScore::deferExcerpts = value;
+    settings()->setSharedValue(READ_EXCERPTS_ON_DEMAND, Val(value));
+}
+
 void NotationConfiguration::setTemplateModeEnabled(std::optional<bool> enabled)
 {
     mu::engraving::MScore::saveTemplateMode = enabled ? enabled.value() : false;
@@ -164,6 +164,9 @@ public:
     int notePlayDurationMilliseconds() const override;
     void setNotePlayDurationMilliseconds(int durationMs) override;
 
+    bool readExcerptsOnDemand() const override;
+    void setReadExcerptsOnDemand(bool value) override;
+
     void setTemplateModeEnabled(std::optional<bool> enabled) override;
     void setTestModeEnabled(std::optional<bool> enabled) override;
 
@@ -117,6 +117,15 @@ void NotationPainting::doPaint(Painter* painter, const Options& opt)
         return;
     }
 
+    paintScore(painter, opt);
+
+    if (!opt.isPrinting) {
+        paintInteraction(painter);
+    }
+}
+
+void NotationPainting::paintScore(Painter* painter, const Options& opt)
+{
     Options myopt = opt;
     bool printPageBackground = myopt.printPageBackground;
     myopt.onPaintPageSheet = [this, printPageBackground](Painter* painter, const Page* page, const RectF& pageRect) {
@@ -124,10 +133,39 @@ void NotationPainting::doPaint(Painter* painter, const Options& opt)
     };
 
     scoreRenderer()->paintScore(painter, score(), myopt);
+}
+
+void NotationPainting::paintPage(Painter* painter, int pageNo, bool isPrinting)
+{
+    TRACEFUNC;
+    if (!score()) {
+        return;
+    }
 
-    if (!myopt.isPrinting) {
-        static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
+    Options opt;
+    opt.isSetViewport = false;
+    opt.isMultiPage = false;
+    opt.fromPage = pageNo;
+    opt.toPage = pageNo;
+    opt.deviceDpi = uiConfiguration()->logicalDpi();
+    opt.isPrinting = isPrinting;
+    paintScore(painter, opt);
+}
+
+void NotationPainting::paintInteraction(Painter* painter)
+{
+    if (!score()) {
+        return;
     }
+
+    //! NOTE The score may have been painted for printing since it was last painted for the view
+    score()->setPrinting(false);
+    MScore::pdfPrinting = false;
+    MScore::pixelRatio = DPI / uiConfiguration()->logicalDpi();
+
+    painter->setAntialiasing(true);
+
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
 }
 
 void NotationPainting::paintPageSheet(Painter* painter, const Page* page, const RectF& pageRect, bool printPageBackground) const
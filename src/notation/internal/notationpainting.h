@@ -56,6 +56,8 @@ public:
     muse::SizeF pageSizeInch(const Options& opt) const override;
 
     void paintView(muse::draw::Painter* painter, const muse::RectF& frameRect, bool isPrinting) override;
+    void paintPage(muse::draw::Painter* painter, int pageNo, bool isPrinting) override;
+    void paintInteraction(muse::draw::Painter* painter) override;
     void paintPdf(muse::draw::Painter* painter, const Options& opt) override;
     void paintPrint(muse::draw::Painter* painter, const Options& opt) override;
     void paintPng(muse::draw::Painter* painter, const Options& opt) override;
@@ -65,6 +67,7 @@ private:
 
     bool isPaintPageBorder() const;
     void doPaint(muse::draw::Painter* painter, const Options& opt);
+    void paintScore(muse::draw::Painter* painter, const Options& opt);
     void paintPageBorder(muse::draw::Painter* painter, const mu::engraving::Page* page) const;
     void paintPageSheet(muse::draw::Painter* painter, const engraving::Page* page, const muse::RectF& pageRect,
                         bool printPageBackground) const;
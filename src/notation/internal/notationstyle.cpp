@@ -84,6 +84,8 @@ void NotationStyle::applyToAllParts()
 
     mu::engraving::MStyle style = m_getScore->score()->style();
 
+    score()->masterScore()->readDeferredExcerpts();
+
     for (mu::engraving::Excerpt* excerpt : score()->masterScore()->excerpts()) {
         excerpt->excerptScore()->undo(new mu::engraving::ChangeStyle(excerpt->excerptScore(), style));
         excerpt->excerptScore()->update();
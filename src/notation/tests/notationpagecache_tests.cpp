@@ -0,0 +1,236 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "draw/bufferedpaintprovider.h"
+#include "draw/painter.h"
+
+#include "notation/view/abstractnotationpagecache.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace muse;
+using namespace muse::draw;
+
+//! NOTE 4 x 4 cells of 256
+static const RectF PAGE_RECT(0.0, 0.0, 1024.0, 1024.0);
+
+class NotationPageCacheTests : public ::testing::Test
+{
+public:
+    class PageCache : public AbstractNotationPageCache
+    {
+    public:
+        void paint(QPainter*, const RectF&, const Transform&, const INotationPaintingPtr&, const PageList&, bool) override {}
+
+        using AbstractNotationPageCache::PageSnapshot;
+        using AbstractNotationPageCache::PageSnapshotPtr;
+        using AbstractNotationPageCache::makeSnapshot;
+        using AbstractNotationPageCache::changedRects;
+
+    private:
+        void onPageChanged(int, const PageSnapshot*, const PageSnapshot&) override {}
+        void onPageRemoved(int) override {}
+        void onCleared() override {}
+    };
+
+    struct Line {
+        PointF from;
+        PointF to;
+        Pen pen;
+    };
+
+    struct Text {
+        PointF pos;
+        String text;
+        Font font;
+    };
+
+    static Font textFont()
+    {
+        Font font(u"Edwin", Font::Type::Text);
+        font.setPointSizeF(10.0);
+        return font;
+    }
+
+    PageCache::PageSnapshotPtr record(const std::vector<Line>& lines, const std::vector<Text>& texts = {},
+                                      const RectF& clipRect = RectF())
+    {
+        std::shared_ptr<BufferedPaintProvider> provider = std::make_shared<BufferedPaintProvider>();
+        {
+            Painter painter(provider, "page");
+            if (!clipRect.isNull()) {
+                painter.setClipRect(clipRect);
+            }
+
+            for (const Line& line : lines) {
+                PainterPath path;
+                path.moveTo(line.from);
+                path.lineTo(line.to);
+
+                painter.setPen(line.pen);
+                painter.setBrush(BrushStyle::NoBrush);
+                painter.drawPath(path);
+            }
+
+            for (const Text& text : texts) {
+                painter.setFont(text.font);
+                painter.drawText(text.pos, text.text);
+            }
+        }
+
+        return m_cache.makeSnapshot(provider->drawData(), PAGE_RECT);
+    }
+
+    //! NOTE The tiles of a page at the given scale (in page coordinates) which intersect the changed rects
+    static std::vector<RectF> changedTiles(const std::vector<RectF>& changedRects, double scale)
+    {
+        const double tileSize = 256.0 / scale;
+
+        std::vector<RectF> tiles;
+        for (double y = PAGE_RECT.top(); y < PAGE_RECT.bottom(); y += tileSize) {
+            for (double x = PAGE_RECT.left(); x < PAGE_RECT.right(); x += tileSize) {
+                const RectF tile(x, y, tileSize, tileSize);
+                for (const RectF& r : changedRects) {
+                    if (r.intersects(tile)) {
+                        tiles.push_back(tile);
+                        break;
+                    }
+                }
+            }
+        }
+
+        return tiles;
+    }
+
+    PageCache m_cache;
+};
+
+TEST_F(NotationPageCacheTests, DataBounds_PenWidthAndMargin)
+{
+    //! [GIVEN] A line of a pen 2 wide
+    PageCache::PageSnapshotPtr snapshot = record({ { PointF(10.0, 10.0), PointF(100.0, 10.0), Pen(Color::BLACK, 2.0) } });
+
+    //! [THEN] Its bounds include the pen width and the margin of 4
+    ASSERT_EQ(snapshot->entries.size(), 1u);
+    EXPECT_EQ(snapshot->entries.front().bounds, RectF(4.0, 4.0, 102.0, 12.0));
+}
+
+TEST_F(NotationPageCacheTests, DataBounds_Clip)
+{
+    //! [GIVEN] The same line, clipped
+    PageCache::PageSnapshotPtr snapshot = record({ { PointF(10.0, 10.0), PointF(100.0, 10.0), Pen(Color::BLACK, 2.0) } }, {},
+                                                 RectF(0.0, 0.0, 50.0, 50.0));
+
+    //! [THEN] Its bounds don't exceed the clip
+    ASSERT_EQ(snapshot->entries.size(), 1u);
+    EXPECT_EQ(snapshot->entries.front().bounds, RectF(4.0, 4.0, 46.0, 12.0));
+}
+
+TEST_F(NotationPageCacheTests, CellHashes_SameContent)
+{
+    //! [GIVEN] Two recordings of the same content
+    const std::vector<Line> lines = {
+        { PointF(10.0, 10.0), PointF(100.0, 10.0), Pen(Color::BLACK, 2.0) },
+        { PointF(600.0, 600.0), PointF(700.0, 600.0), Pen(Color::BLACK, 2.0) },
+    };
+
+    PageCache::PageSnapshotPtr oldSnapshot = record(lines);
+    PageCache::PageSnapshotPtr newSnapshot = record(lines);
+
+    //! [THEN] Nothing has changed
+    EXPECT_EQ(oldSnapshot->cellCols, 4);
+    EXPECT_EQ(oldSnapshot->cellRows, 4);
+    EXPECT_EQ(oldSnapshot->cellHashes, newSnapshot->cellHashes);
+    EXPECT_TRUE(PageCache::changedRects(*oldSnapshot, *newSnapshot).empty());
+}
+
+TEST_F(NotationPageCacheTests, ChangedRects_PenChangeInOneCell)
+{
+    //! [GIVEN] A line in the cell (0, 0) and one in the cell (2, 2)
+    std::vector<Line> lines = {
+        { PointF(10.0, 10.0), PointF(100.0, 10.0), Pen(Color::BLACK, 2.0) },
+        { PointF(600.0, 600.0), PointF(700.0, 600.0), Pen(Color::BLACK, 2.0) },
+    };
+
+    PageCache::PageSnapshotPtr oldSnapshot = record(lines);
+
+    //! [WHEN] The cap style of the second line changes, which doesn't change its bounds
+    lines[1].pen.setCapStyle(PenCapStyle::RoundCap);
+    PageCache::PageSnapshotPtr capSnapshot = record(lines);
+
+    //! [THEN] Only its cell has changed
+    std::vector<RectF> rects = PageCache::changedRects(*oldSnapshot, *capSnapshot);
+    ASSERT_EQ(rects.size(), 1u);
+    EXPECT_EQ(rects.front(), RectF(512.0, 512.0, 256.0, 256.0));
+
+    //! [THEN] Exactly the overlapping tiles are invalidated, at the zoom of the cells and at a lower zoom
+    EXPECT_EQ(changedTiles(rects, 1.0), std::vector<RectF>({ RectF(512.0, 512.0, 256.0, 256.0) }));
+    EXPECT_EQ(changedTiles(rects, 0.5), std::vector<RectF>({ RectF(512.0, 512.0, 512.0, 512.0) }));
+
+    //! [WHEN] The color of the first line changes
+    lines[0].pen.setColor(Color::RED);
+    PageCache::PageSnapshotPtr colorSnapshot = record(lines);
+
+    //! [THEN] Only its cell has changed
+    rects = PageCache::changedRects(*capSnapshot, *colorSnapshot);
+    ASSERT_EQ(rects.size(), 1u);
+    EXPECT_EQ(rects.front(), RectF(0.0, 0.0, 256.0, 256.0));
+    EXPECT_EQ(changedTiles(rects, 1.0), std::vector<RectF>({ RectF(0.0, 0.0, 256.0, 256.0) }));
+}
+
+TEST_F(NotationPageCacheTests, ChangedRects_PenChangeAcrossCells)
+{
+    //! [GIVEN] A line across the cells (0, 0) and (1, 0)
+    std::vector<Line> lines = { { PointF(200.0, 100.0), PointF(300.0, 100.0), Pen(Color::BLACK, 2.0) } };
+    PageCache::PageSnapshotPtr oldSnapshot = record(lines);
+
+    //! [WHEN] Its dash pattern changes
+    lines[0].pen.setStyle(PenStyle::DashLine);
+    PageCache::PageSnapshotPtr newSnapshot = record(lines);
+
+    //! [THEN] Both cells have changed
+    const std::vector<RectF> rects = PageCache::changedRects(*oldSnapshot, *newSnapshot);
+    EXPECT_EQ(rects, std::vector<RectF>({ RectF(0.0, 0.0, 256.0, 256.0), RectF(256.0, 0.0, 256.0, 256.0) }));
+}
+
+TEST_F(NotationPageCacheTests, ChangedRects_FontChangeInOneCell)
+{
+    //! [GIVEN] A line and a text in the middle of the cell (1, 1)
+    const std::vector<Line> lines = { { PointF(10.0, 10.0), PointF(100.0, 10.0), Pen(Color::BLACK, 2.0) } };
+    std::vector<Text> texts = { { PointF(370.0, 390.0), u"abc", textFont() } };
+
+    PageCache::PageSnapshotPtr oldSnapshot = record(lines, texts);
+
+    //! [WHEN] The text becomes underlined, then struck out
+    texts[0].font.setUnderline(true);
+    PageCache::PageSnapshotPtr underlineSnapshot = record(lines, texts);
+
+    texts[0].font.setStrike(true);
+    PageCache::PageSnapshotPtr strikeSnapshot = record(lines, texts);
+
+    //! [THEN] Only the cell of the text has changed each time
+    const std::vector<RectF> expected = { RectF(256.0, 256.0, 256.0, 256.0) };
+    EXPECT_EQ(PageCache::changedRects(*oldSnapshot, *underlineSnapshot), expected);
+    EXPECT_EQ(PageCache::changedRects(*underlineSnapshot, *strikeSnapshot), expected);
+}
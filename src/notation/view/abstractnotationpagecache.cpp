@@ -0,0 +1,638 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "abstractnotationpagecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+
+#include <QPainter>
+
+#include "concurrency/taskscheduler.h"
+#include "draw/bufferedpaintprovider.h"
+#include "draw/fontmetrics.h"
+#include "draw/painter.h"
+
+#include "engraving/dom/page.h"
+
+#include "log.h"
+
+using namespace mu::notation;
+using namespace muse;
+using namespace muse::draw;
+
+//! NOTE The cells in which the recordings are compared, in page coordinates
+static constexpr double CELL_SIZE = 256.0;
+
+//! NOTE Antialiasing and the estimated text bounds may spill a bit outside of the computed bounds
+static constexpr double BOUNDS_MARGIN = 4.0;
+
+static constexpr size_t MAX_IMAGES = 32;
+static constexpr size_t MAX_TEXT_BOUNDS = 4096;
+
+static int maxTasksInFlight()
+{
+    static const int max = std::max(4, static_cast<int>(TaskScheduler::instance()->threadPoolSize()) * 2);
+    return max;
+}
+
+static void hashCombine(uint64_t& seed, uint64_t value)
+{
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+static void hashCombine(uint64_t& seed, double value)
+{
+    hashCombine(seed, static_cast<uint64_t>(std::hash<double> {}(value)));
+}
+
+static void hashCombine(uint64_t& seed, const Color& color)
+{
+    hashCombine(seed, static_cast<uint64_t>((color.red() << 24) | (color.green() << 16) | (color.blue() << 8) | color.alpha()));
+}
+
+static void hashCombine(uint64_t& seed, const PointF& p)
+{
+    hashCombine(seed, p.x());
+    hashCombine(seed, p.y());
+}
+
+static void hashCombine(uint64_t& seed, const RectF& r)
+{
+    hashCombine(seed, r.x());
+    hashCombine(seed, r.y());
+    hashCombine(seed, r.width());
+    hashCombine(seed, r.height());
+}
+
+//! NOTE The hashes of the pen and the font cover everything their operator== compares,
+//! otherwise a change of e.g. the cap style or the underline wouldn't be noticed
+
+static void hashCombine(uint64_t& seed, const Pen& pen)
+{
+    hashCombine(seed, static_cast<uint64_t>(pen.style()));
+    hashCombine(seed, pen.widthF());
+    hashCombine(seed, pen.color());
+    hashCombine(seed, static_cast<uint64_t>(pen.capStyle()));
+    hashCombine(seed, static_cast<uint64_t>(pen.joinStyle()));
+    for (double d : pen.dashPattern()) {
+        hashCombine(seed, d);
+    }
+}
+
+static void hashCombine(uint64_t& seed, const Brush& brush)
+{
+    hashCombine(seed, static_cast<uint64_t>(brush.style()));
+    hashCombine(seed, brush.color());
+}
+
+static uint64_t pixmapHash(const Pixmap& pm)
+{
+    const ByteArray data = pm.data();
+    return std::hash<std::string_view> {}(std::string_view(reinterpret_cast<const char*>(data.constData()), data.size()));
+}
+
+static uint64_t fontHash(const Font& font)
+{
+    uint64_t h = 0;
+    hashCombine(h, static_cast<uint64_t>(font.family().hash()));
+    hashCombine(h, font.pointSizeF());
+    hashCombine(h, static_cast<uint64_t>(font.weight()));
+    hashCombine(h, static_cast<uint64_t>(font.bold()));
+    hashCombine(h, static_cast<uint64_t>(font.italic()));
+    hashCombine(h, static_cast<uint64_t>(font.underline()));
+    hashCombine(h, static_cast<uint64_t>(font.strike()));
+    hashCombine(h, static_cast<uint64_t>(font.noFontMerging()));
+    hashCombine(h, static_cast<uint64_t>(font.hinting()));
+    return h;
+}
+
+static uint64_t dataHash(const DrawData::Data& data, const DrawData::State& state)
+{
+    uint64_t h = 0;
+
+    hashCombine(h, state.pen);
+    hashCombine(h, state.brush);
+    hashCombine(h, fontHash(state.font));
+    hashCombine(h, state.transform.m11());
+    hashCombine(h, state.transform.m12());
+    hashCombine(h, state.transform.m21());
+    hashCombine(h, state.transform.m22());
+    hashCombine(h, state.transform.dx());
+    hashCombine(h, state.transform.dy());
+    hashCombine(h, static_cast<uint64_t>(state.isAntialiasing));
+    hashCombine(h, static_cast<uint64_t>(state.compositionMode));
+    hashCombine(h, static_cast<uint64_t>(state.isClipping));
+    if (state.isClipping) {
+        hashCombine(h, state.clipRect);
+    }
+
+    for (const DrawPath& path : data.paths) {
+        hashCombine(h, static_cast<uint64_t>(path.mode));
+        hashCombine(h, path.pen);
+        hashCombine(h, path.brush);
+        for (size_t i = 0; i < path.path.elementCount(); ++i) {
+            PainterPath::Element e = path.path.elementAt(i);
+            hashCombine(h, static_cast<uint64_t>(e.type));
+            hashCombine(h, e.x);
+            hashCombine(h, e.y);
+        }
+    }
+
+    for (const DrawPolygon& polygon : data.polygons) {
+        hashCombine(h, static_cast<uint64_t>(polygon.mode));
+        for (const PointF& p : polygon.polygon) {
+            hashCombine(h, p);
+        }
+    }
+
+    for (const DrawText& text : data.texts) {
+        hashCombine(h, static_cast<uint64_t>(text.mode));
+        hashCombine(h, text.rect);
+        hashCombine(h, static_cast<uint64_t>(text.flags));
+        hashCombine(h, static_cast<uint64_t>(text.text.hash()));
+    }
+
+    for (const DrawPixmap& pixmap : data.pixmaps) {
+        hashCombine(h, static_cast<uint64_t>(pixmap.mode));
+        hashCombine(h, pixmap.rect);
+        hashCombine(h, pixmapHash(pixmap.pm));
+        hashCombine(h, pixmap.offset);
+    }
+
+    return h;
+}
+
+RectF AbstractNotationPageCache::symbolBounds(const Font& font, char32_t code)
+{
+    uint64_t key = fontHash(font);
+    hashCombine(key, static_cast<uint64_t>(code));
+
+    auto it = m_symbolBounds.find(key);
+    if (it == m_symbolBounds.end()) {
+        it = m_symbolBounds.emplace(key, FontMetrics::boundingRect(font, String::fromUcs4(&code, 1))).first;
+    }
+
+    return it->second;
+}
+
+RectF AbstractNotationPageCache::textBounds(const Font& font, const String& text)
+{
+    uint64_t key = fontHash(font);
+    hashCombine(key, static_cast<uint64_t>(text.hash()));
+
+    auto it = m_textBounds.find(key);
+    if (it == m_textBounds.end()) {
+        //! NOTE The texts change with the edits, unlike the symbols
+        if (m_textBounds.size() >= MAX_TEXT_BOUNDS) {
+            m_textBounds.clear();
+        }
+
+        it = m_textBounds.emplace(key, FontMetrics::boundingRect(font, text)).first;
+    }
+
+    return it->second;
+}
+
+RectF AbstractNotationPageCache::dataBounds(const DrawData::Data& data, const DrawData::State& state)
+{
+    RectF bounds;
+
+    for (const DrawPath& path : data.paths) {
+        double w = path.pen.style() == PenStyle::NoPen ? 0.0 : path.pen.widthF();
+        bounds.unite(path.path.boundingRect().adjusted(-w, -w, w, w));
+    }
+
+    double penWidth = state.pen.style() == PenStyle::NoPen ? 0.0 : state.pen.widthF();
+    for (const DrawPolygon& polygon : data.polygons) {
+        if (polygon.polygon.empty()) {
+            continue;
+        }
+
+        double left = polygon.polygon.front().x();
+        double right = left;
+        double top = polygon.polygon.front().y();
+        double bottom = top;
+        for (const PointF& p : polygon.polygon) {
+            left = std::min(left, p.x());
+            right = std::max(right, p.x());
+            top = std::min(top, p.y());
+            bottom = std::max(bottom, p.y());
+        }
+        bounds.unite(RectF(left, top, right - left, bottom - top).adjusted(-penWidth, -penWidth, penWidth, penWidth));
+    }
+
+    for (const DrawText& text : data.texts) {
+        if (text.mode == DrawText::Symbol) {
+            const RectF symbolRect = symbolBounds(state.font, text.symbolCode()).translated(text.rect.topLeft());
+            const double m = symbolRect.height() / 4;
+            bounds.unite(symbolRect.adjusted(-m, -m, m, m));
+            continue;
+        }
+
+        RectF textRect;
+        if (text.mode == DrawText::Point || text.mode == DrawText::Workaround) {
+            textRect = textBounds(state.font, text.text).translated(text.rect.topLeft());
+        } else {
+            textRect = text.rect.united(FontMetrics(state.font).boundingRect(text.rect, text.flags, text.text));
+        }
+
+        double m = textRect.height() / 2;
+        bounds.unite(textRect.adjusted(-m, -m, m, m));
+    }
+
+    for (const DrawPixmap& pixmap : data.pixmaps) {
+        if (pixmap.mode == DrawPixmap::Single) {
+            bounds.unite(RectF(pixmap.rect.topLeft(), SizeF(pixmap.pm.width(), pixmap.pm.height())));
+        } else {
+            bounds.unite(pixmap.rect);
+        }
+    }
+
+    if (bounds.isNull()) {
+        return bounds;
+    }
+
+    bounds = state.transform.map(bounds).adjusted(-BOUNDS_MARGIN, -BOUNDS_MARGIN, BOUNDS_MARGIN, BOUNDS_MARGIN);
+    if (state.isClipping) {
+        bounds = bounds.intersected(state.clipRect);
+    }
+
+    return bounds;
+}
+
+static void collectDatas(const DrawData::Item& item, std::vector<const DrawData::Data*>& datas)
+{
+    for (const DrawData::Data& d : item.datas) {
+        if (!d.empty()) {
+            datas.push_back(&d);
+        }
+    }
+
+    for (const DrawData::Item& ch : item.chilren) {
+        collectDatas(ch, datas);
+    }
+}
+
+AbstractNotationPageCache::AbstractNotationPageCache()
+    : m_shared(std::make_shared<Shared>())
+{
+}
+
+AbstractNotationPageCache::~AbstractNotationPageCache()
+{
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    m_shared->onReady = nullptr;
+}
+
+void AbstractNotationPageCache::setReadyCallback(const std::function<void()>& func)
+{
+    std::lock_guard<std::mutex> lock(m_shared->mutex);
+    m_shared->onReady = func;
+}
+
+void AbstractNotationPageCache::markContentChanged()
+{
+    ++m_contentRevision;
+}
+
+void AbstractNotationPageCache::markPagesChanged(int firstPageNo, int lastPageNo)
+{
+    //! NOTE The pages that weren't recorded yet will be recorded anyway
+    const int last = std::min(lastPageNo, static_cast<int>(m_pages.size()) - 1);
+    for (int pageNo = std::max(firstPageNo, 0); pageNo <= last; ++pageNo) {
+        m_pages.at(pageNo).isChanged = true;
+    }
+}
+
+void AbstractNotationPageCache::clear()
+{
+    m_pages.clear();
+    m_images.clear();
+    ++m_contentRevision;
+
+    onCleared();
+}
+
+void AbstractNotationPageCache::setViewSize(const SizeF& size)
+{
+    m_viewSize = size;
+}
+
+void AbstractNotationPageCache::beginPaint(const QPainter* painter, const PageList& pages, bool isPrinting)
+{
+    applyFinishedTasks();
+
+    const QPaintDevice* device = painter->device();
+    if (isPrinting != m_isPrinting || device->logicalDpiX() != m_deviceDpiX || device->logicalDpiY() != m_deviceDpiY) {
+        clear();
+        m_isPrinting = isPrinting;
+        m_deviceDpiX = device->logicalDpiX();
+        m_deviceDpiY = device->logicalDpiY();
+    }
+
+    if (m_pages.size() > pages.size()) {
+        for (size_t pageNo = pages.size(); pageNo < m_pages.size(); ++pageNo) {
+            onPageRemoved(static_cast<int>(pageNo));
+        }
+        m_pages.resize(pages.size());
+    }
+}
+
+AbstractNotationPageCache::PageSnapshotPtr AbstractNotationPageCache::pageSnapshot(int pageNo, const Page* page,
+                                                                                   const INotationPaintingPtr& painting)
+{
+    if (pageNo >= static_cast<int>(m_pages.size())) {
+        m_pages.resize(pageNo + 1);
+    }
+
+    PageEntry& entry = m_pages.at(pageNo);
+    if (entry.snapshot && entry.contentRevision == m_contentRevision && !entry.isChanged) {
+        return entry.snapshot;
+    }
+
+    PageSnapshotPtr snapshot = recordPage(pageNo, page, painting);
+    entry.contentRevision = m_contentRevision;
+    entry.isChanged = false;
+
+    //! NOTE Most edits change a few pages only, the others keep their recording and everything made from it
+    if (entry.snapshot && entry.snapshot->pageRect == snapshot->pageRect && entry.snapshot->cellHashes == snapshot->cellHashes) {
+        return entry.snapshot;
+    }
+
+    onPageChanged(pageNo, entry.snapshot.get(), *snapshot);
+
+    entry.snapshot = snapshot;
+    return entry.snapshot;
+}
+
+AbstractNotationPageCache::PageSnapshotPtr AbstractNotationPageCache::recordPage(int pageNo, const Page* page,
+                                                                                 const INotationPaintingPtr& painting)
+{
+    TRACEFUNC;
+
+    std::shared_ptr<BufferedPaintProvider> provider = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(provider, "notation_page_cache");
+        painting->paintPage(&painter, pageNo, m_isPrinting);
+    }
+
+    return makeSnapshot(provider->drawData(), page->ldata()->bbox());
+}
+
+AbstractNotationPageCache::PageSnapshotPtr AbstractNotationPageCache::makeSnapshot(const DrawDataPtr& drawData, const RectF& pageRect)
+{
+    std::shared_ptr<PageSnapshot> snapshot = std::make_shared<PageSnapshot>();
+    snapshot->drawData = drawData;
+    snapshot->revision = ++m_lastSnapshotRevision;
+    snapshot->pageRect = pageRect;
+
+    std::vector<const DrawData::Data*> datas;
+    collectDatas(snapshot->drawData->item, datas);
+
+    snapshot->cellCols = std::max(1, static_cast<int>(std::ceil(snapshot->pageRect.width() / CELL_SIZE)));
+    snapshot->cellRows = std::max(1, static_cast<int>(std::ceil(snapshot->pageRect.height() / CELL_SIZE)));
+    snapshot->cellHashes.resize(snapshot->cellCols * snapshot->cellRows, 0);
+
+    snapshot->entries.reserve(datas.size());
+    for (const DrawData::Data* d : datas) {
+        auto stateIt = snapshot->drawData->states.find(d->state);
+        IF_ASSERT_FAILED(stateIt != snapshot->drawData->states.end()) {
+            continue;
+        }
+
+        const DrawData::State* state = &stateIt->second;
+        RectF bounds = dataBounds(*d, *state);
+        if (bounds.isNull()) {
+            bounds = snapshot->pageRect;
+        }
+
+        snapshot->entries.push_back({ d, state, bounds });
+
+        //! NOTE Pixmaps are decoded here, QPixmap can't be used on the worker threads
+        for (const DrawPixmap& px : d->pixmaps) {
+            const ByteArray data = px.pm.data();
+            if (snapshot->images.find(data.constData()) != snapshot->images.end()) {
+                continue;
+            }
+
+            const uint64_t key = pixmapHash(px.pm);
+            auto imageIt = m_images.find(key);
+            if (imageIt == m_images.end()) {
+                if (m_images.size() >= MAX_IMAGES) {
+                    m_images.clear();
+                }
+
+                QImage image;
+                image.loadFromData(data.toQByteArrayNoCopy());
+                imageIt = m_images.emplace(key, image).first;
+            }
+            snapshot->images.emplace(data.constData(), imageIt->second);
+        }
+
+        const uint64_t h = dataHash(*d, *state);
+        const RectF local = bounds.translated(-snapshot->pageRect.topLeft());
+        const int firstCol = std::clamp(static_cast<int>(std::floor(local.left() / CELL_SIZE)), 0, snapshot->cellCols - 1);
+        const int lastCol = std::clamp(static_cast<int>(std::floor(local.right() / CELL_SIZE)), 0, snapshot->cellCols - 1);
+        const int firstRow = std::clamp(static_cast<int>(std::floor(local.top() / CELL_SIZE)), 0, snapshot->cellRows - 1);
+        const int lastRow = std::clamp(static_cast<int>(std::floor(local.bottom() / CELL_SIZE)), 0, snapshot->cellRows - 1);
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int col = firstCol; col <= lastCol; ++col) {
+                hashCombine(snapshot->cellHashes[row * snapshot->cellCols + col], h);
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+bool AbstractNotationPageCache::pushTask(std::function<QImage()> render, std::function<void(QImage&)> apply)
+{
+    if (m_shared->tasksInFlight.load() >= maxTasksInFlight()) {
+        return false;
+    }
+
+    ++m_shared->tasksInFlight;
+
+    TaskScheduler::instance()->push([shared = m_shared, render = std::move(render), apply = std::move(apply)]() {
+        QImage image = render();
+
+        --shared->tasksInFlight;
+
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->finished.push_back({ std::move(apply), std::move(image) });
+        if (!shared->isNotified && shared->onReady) {
+            shared->isNotified = true;
+            shared->onReady();
+        }
+    });
+
+    return true;
+}
+
+void AbstractNotationPageCache::applyFinishedTasks()
+{
+    std::vector<FinishedTask> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_shared->mutex);
+        finished.swap(m_shared->finished);
+        m_shared->isNotified = false;
+    }
+
+    for (FinishedTask& f : finished) {
+        f.apply(f.image);
+    }
+}
+
+int AbstractNotationPageCache::deviceDpiX() const
+{
+    return m_deviceDpiX;
+}
+
+int AbstractNotationPageCache::deviceDpiY() const
+{
+    return m_deviceDpiY;
+}
+
+const SizeF& AbstractNotationPageCache::viewSize() const
+{
+    return m_viewSize;
+}
+
+std::vector<RectF> AbstractNotationPageCache::changedRects(const PageSnapshot& oldSnapshot, const PageSnapshot& newSnapshot)
+{
+    if (oldSnapshot.pageRect != newSnapshot.pageRect || oldSnapshot.cellHashes.size() != newSnapshot.cellHashes.size()) {
+        return { newSnapshot.pageRect.united(oldSnapshot.pageRect) };
+    }
+
+    std::vector<RectF> rects;
+    for (int row = 0; row < newSnapshot.cellRows; ++row) {
+        for (int col = 0; col < newSnapshot.cellCols; ++col) {
+            const size_t idx = row * newSnapshot.cellCols + col;
+            if (oldSnapshot.cellHashes.at(idx) != newSnapshot.cellHashes.at(idx)) {
+                rects.push_back(RectF(newSnapshot.pageRect.x() + col * CELL_SIZE, newSnapshot.pageRect.y() + row * CELL_SIZE,
+                                      CELL_SIZE, CELL_SIZE));
+            }
+        }
+    }
+
+    return rects;
+}
+
+void AbstractNotationPageCache::paintSnapshot(QPainter* qp, const PageSnapshot& snapshot, const Transform& base, const RectF& rect)
+{
+    Painter painter(qp, "notation_page_snapshot");
+    IPaintProviderPtr provider = painter.provider();
+
+    //! NOTE The recorded clip is applied within the clip of the painter
+    const DrawData::State* clipState = nullptr;
+
+    for (const PageSnapshot::Entry& e : snapshot.entries) {
+        if (!e.bounds.intersects(rect)) {
+            continue;
+        }
+
+        const DrawData::Data& d = *e.data;
+        const DrawData::State& st = *e.state;
+
+        const bool isSameClip = clipState ? (st.isClipping && st.clipRect == clipState->clipRect) : !st.isClipping;
+        if (!isSameClip) {
+            if (clipState) {
+                provider->restore();
+            }
+
+            clipState = st.isClipping ? &st : nullptr;
+            if (clipState) {
+                provider->save();
+                qp->setTransform(Transform::toQTransform(base));
+                qp->setClipRect(st.clipRect.toQRectF(), Qt::IntersectClip);
+            }
+        }
+
+        provider->setPen(st.pen);
+        provider->setBrush(st.brush);
+        provider->setFont(st.font);
+        provider->setTransform(st.transform * base);
+        provider->setAntialiasing(st.isAntialiasing);
+        provider->setCompositionMode(st.compositionMode);
+
+        for (const DrawPath& path : d.paths) {
+            provider->setPen(path.pen);
+            provider->setBrush(path.brush);
+            provider->drawPath(path.path);
+        }
+
+        if (!d.polygons.empty()) {
+            provider->setPen(st.pen);
+            provider->setBrush(st.brush);
+            for (const DrawPolygon& pl : d.polygons) {
+                if (pl.polygon.empty()) {
+                    continue;
+                }
+                provider->drawPolygon(&pl.polygon[0], pl.polygon.size(), pl.mode);
+            }
+        }
+
+        for (const DrawText& t : d.texts) {
+            if (t.mode == DrawText::Point) {
+                provider->drawText(t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Workaround) {
+                //! NOTE Here the painter has the final scale, which the workaround depends on
+                provider->drawTextWorkaround(st.font, t.rect.topLeft(), t.text);
+            } else if (t.mode == DrawText::Symbol) {
+                //! NOTE Consecutive symbols of the same pen and font are drawn as one glyph run
+                provider->drawSymbol(t.rect.topLeft(), t.symbolCode());
+            } else {
+                provider->drawText(t.rect, t.flags, t.text);
+            }
+        }
+
+        if (d.pixmaps.empty()) {
+            continue;
+        }
+
+        //! NOTE The images are drawn directly, save() draws the collected symbols before
+        provider->save();
+
+        for (const DrawPixmap& px : d.pixmaps) {
+            auto imageIt = snapshot.images.find(px.pm.data().constData());
+            if (imageIt == snapshot.images.end() || imageIt->second.isNull()) {
+                continue;
+            }
+
+            const QImage& image = imageIt->second;
+            if (px.mode == DrawPixmap::Single) {
+                qp->drawImage(px.rect.topLeft().toQPointF(), image);
+            } else {
+                QBrush brush(image);
+                brush.setTransform(QTransform::fromTranslate(px.rect.x() - px.offset.x(), px.rect.y() - px.offset.y()));
+                qp->fillRect(px.rect.toQRectF(), brush);
+            }
+        }
+
+        provider->restore();
+    }
+
+    if (clipState) {
+        provider->restore();
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_ABSTRACTNOTATIONPAGECACHE_H
+#define MU_NOTATION_ABSTRACTNOTATIONPAGECACHE_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QImage>
+
+#include "draw/types/geometry.h"
+#include "draw/types/transform.h"
+#include "draw/types/drawdata.h"
+
+#include "notation/inotationpainting.h"
+#include "notation/notationtypes.h"
+
+class QPainter;
+
+namespace mu::notation {
+//! NOTE Base of the caches from which the notation views are painted.
+//! Each page is recorded on the GUI thread into an immutable draw list, which can be rasterized
+//! on the TaskScheduler threads. When the score changes, the pages are recorded again on the next paint,
+//! and the subclasses are told which parts of a page differ from its previous recording.
+class AbstractNotationPageCache
+{
+public:
+    AbstractNotationPageCache();
+    virtual ~AbstractNotationPageCache();
+
+    //! NOTE Called on a worker thread when rasterized images are ready,
+    //! the receiver should schedule a repaint on its own thread
+    void setReadyCallback(const std::function<void()>& func);
+
+    //! NOTE The pages will be recorded again before they are painted next time
+    void markContentChanged();
+    void markPagesChanged(int firstPageNo, int lastPageNo);
+    void clear();
+
+    //! NOTE The size of the view, in the painter coordinates
+    void setViewSize(const muse::SizeF& size);
+
+    //! NOTE Paints the pages intersecting `frameRect` (canvas coordinates).
+    //! `transform` maps the canvas to the painter coordinates and must be a scale and translation
+    virtual void paint(QPainter* painter, const muse::RectF& frameRect, const muse::draw::Transform& transform,
+                       const INotationPaintingPtr& painting, const PageList& pages, bool isPrinting) = 0;
+
+protected:
+    struct PageSnapshot {
+        struct Entry {
+            const muse::draw::DrawData::Data* data = nullptr;
+            const muse::draw::DrawData::State* state = nullptr;
+            muse::RectF bounds;
+        };
+
+        //! NOTE Read-only once recorded, it's shared with the worker tasks
+        muse::draw::DrawDataPtr drawData;
+        std::vector<Entry> entries;
+        std::map<const uint8_t*, QImage> images; // by the pixmap data
+
+        muse::RectF pageRect;
+        int cellCols = 0;
+        int cellRows = 0;
+        std::vector<uint64_t> cellHashes;
+
+        uint64_t revision = 0;
+    };
+
+    using PageSnapshotPtr = std::shared_ptr<const PageSnapshot>;
+
+    //! NOTE Applies the finished tasks and resets the cache if the device or the print mode have changed
+    void beginPaint(const QPainter* painter, const PageList& pages, bool isPrinting);
+
+    //! NOTE Returns the recording of the page, recording it again if the content has changed since
+    PageSnapshotPtr pageSnapshot(int pageNo, const Page* page, const INotationPaintingPtr& painting);
+
+    //! NOTE Computes the bounds of the entries and the cell hashes of a recording
+    PageSnapshotPtr makeSnapshot(const muse::draw::DrawDataPtr& drawData, const muse::RectF& pageRect);
+
+    //! NOTE `render` is called on a worker thread, `apply` with its result on the cache thread,
+    //! when the next paint begins. Returns false if too many tasks are already in flight
+    bool pushTask(std::function<QImage()> render, std::function<void(QImage&)> apply);
+
+    int deviceDpiX() const;
+    int deviceDpiY() const;
+    const muse::SizeF& viewSize() const;
+
+    //! NOTE `newSnapshot` differs from `oldSnapshot`, which is null if the page wasn't recorded before
+    virtual void onPageChanged(int pageNo, const PageSnapshot* oldSnapshot, const PageSnapshot& newSnapshot) = 0;
+    virtual void onPageRemoved(int pageNo) = 0;
+    virtual void onCleared() = 0;
+
+    //! NOTE The page areas (in page coordinates) in which the two recordings differ
+    static std::vector<muse::RectF> changedRects(const PageSnapshot& oldSnapshot, const PageSnapshot& newSnapshot);
+
+    //! NOTE Replays the entries intersecting `rect` (page coordinates), `base` maps the page to the painter coordinates
+    static void paintSnapshot(QPainter* qp, const PageSnapshot& snapshot, const muse::draw::Transform& base, const muse::RectF& rect);
+
+private:
+    struct FinishedTask {
+        std::function<void(QImage&)> apply;
+        QImage image;
+    };
+
+    //! NOTE Shared with the worker tasks, which may outlive the cache
+    struct Shared {
+        std::mutex mutex;
+        std::function<void()> onReady;
+        std::vector<FinishedTask> finished;
+        bool isNotified = false;
+        std::atomic<int> tasksInFlight = 0;
+    };
+
+    struct PageEntry {
+        PageSnapshotPtr snapshot;
+        uint64_t contentRevision = 0;
+        bool isChanged = false;
+    };
+
+    PageSnapshotPtr recordPage(int pageNo, const Page* page, const INotationPaintingPtr& painting);
+    muse::RectF dataBounds(const muse::draw::DrawData::Data& data, const muse::draw::DrawData::State& state);
+    muse::RectF symbolBounds(const muse::draw::Font& font, char32_t code);
+    muse::RectF textBounds(const muse::draw::Font& font, const muse::String& text);
+    void applyFinishedTasks();
+
+    std::shared_ptr<Shared> m_shared;
+
+    std::vector<PageEntry> m_pages;
+    std::map<uint64_t, QImage> m_images; // decoded pixmaps, by their data hash
+    std::unordered_map<uint64_t, muse::RectF> m_symbolBounds; // by the font and the symbol
+    std::unordered_map<uint64_t, muse::RectF> m_textBounds; // by the font and the text
+
+    uint64_t m_contentRevision = 0;
+    uint64_t m_lastSnapshotRevision = 0;
+    bool m_isPrinting = false;
+    int m_deviceDpiX = 0;
+    int m_deviceDpiY = 0;
+    muse::SizeF m_viewSize;
+};
+}
+
+#endif // MU_NOTATION_ABSTRACTNOTATIONPAGECACHE_H
@@ -25,6 +25,12 @@
 
 #include "actions/actiontypes.h"
 
+#include "engraving/dom/page.h"
+#include "engraving/dom/score.h"
+#include "engraving/dom/spanner.h"
+
+#include "notationtilecache.h"
+
 #include "log.h"
 
 using namespace mu;
@@ -63,10 +69,15 @@ AbstractNotationPaintView::AbstractNotationPaintView(QQuickItem* parent)
     connect(&m_enableAutoScrollTimer, &QTimer::timeout, this, [this]() {
         m_autoScrollEnabled = true;
     });
+
+    setPageCache(std::make_unique<NotationTileCache>());
 }
 
 AbstractNotationPaintView::~AbstractNotationPaintView()
 {
+    //! NOTE Stop the cache callbacks before anything else is destroyed
+    m_pageCache.reset();
+
     if (m_notation && isMainView()) {
         m_notation->accessibility()->setMapToScreenFunc(nullptr);
         m_notation->interaction()->setGetViewRectFunc(nullptr);
@@ -92,6 +103,7 @@ void AbstractNotationPaintView::load()
     //! NOTE For diagnostic tools
     if (!dispatcher()->isReg(this)) {
         dispatcher()->reg(this, "diagnostic-notationview-redraw", [this]() {
+            m_pageCache->clear();
             scheduleRedraw();
         });
     }
@@ -240,9 +252,15 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 
     INotationInteractionPtr interaction = notationInteraction();
 
+    const mu::engraving::Score* score = notationElements()->msScore();
+    m_lastLayoutNo = score->layoutStatistics().layoutNo;
+    m_lastPageCount = score->npages();
+    m_selectionPageNumbers = selectionPageNumbers();
+
     m_notation->notationChanged().onNotify(this, [this, interaction]() {
         interaction->hideShadowNote();
         m_shadowNoteRect = RectF();
+        markChangedPages();
         scheduleRedraw();
     });
 
@@ -252,6 +270,7 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        markSelectionPages();
         scheduleRedraw();
     });
 
@@ -465,6 +484,75 @@ void AbstractNotationPaintView::onNoteInputStateChanged()
     }
 }
 
+void AbstractNotationPaintView::markChangedPages()
+{
+    const mu::engraving::Score* score = notationElements()->msScore();
+    const mu::engraving::LayoutStatistics& stat = score->layoutStatistics();
+
+    //! NOTE Only the pages laid out again differ, if the notification is about one layout which kept the page count.
+    //! Otherwise (no layout, several layouts, pages added or removed) any page may differ
+    const bool isOneLayout = stat.layoutNo == m_lastLayoutNo + 1;
+    const bool isSamePageCount = score->npages() == m_lastPageCount;
+    m_lastLayoutNo = stat.layoutNo;
+    m_lastPageCount = score->npages();
+
+    if (isOneLayout && isSamePageCount && !stat.isLayoutAll && stat.firstPageIdx >= 0) {
+        m_pageCache->markPagesChanged(stat.firstPageIdx, stat.lastPageIdx);
+    } else {
+        m_pageCache->markContentChanged();
+    }
+
+    //! NOTE The selected elements may have moved to other pages
+    m_selectionPageNumbers = selectionPageNumbers();
+}
+
+void AbstractNotationPaintView::markSelectionPages()
+{
+    //! NOTE The selected elements are painted in the selection color,
+    //! so the pages of the previous and of the new selection differ
+    std::set<int> pageNumbers = selectionPageNumbers();
+
+    for (int pageNo : m_selectionPageNumbers) {
+        m_pageCache->markPagesChanged(pageNo, pageNo);
+    }
+
+    for (int pageNo : pageNumbers) {
+        m_pageCache->markPagesChanged(pageNo, pageNo);
+    }
+
+    m_selectionPageNumbers = std::move(pageNumbers);
+}
+
+std::set<int> AbstractNotationPaintView::selectionPageNumbers() const
+{
+    std::set<int> pageNumbers;
+
+    INotationSelectionPtr selection = notationSelection();
+    if (!selection) {
+        return pageNumbers;
+    }
+
+    auto addPage = [&pageNumbers](const EngravingItem* item) {
+        //! NOTE The elements which aren't on a page aren't painted
+        const EngravingItem* page = item->findAncestor(ElementType::PAGE);
+        if (page) {
+            pageNumbers.insert(static_cast<int>(toPage(page)->no()));
+        }
+    };
+
+    for (const EngravingItem* item : selection->elements()) {
+        if (item->isSpanner()) {
+            for (const mu::engraving::SpannerSegment* segment : toSpanner(item)->spannerSegments()) {
+                addPage(segment);
+            }
+        } else {
+            addPage(item);
+        }
+    }
+
+    return pageNumbers;
+}
+
 void AbstractNotationPaintView::onShowItemRequested(const INotationInteraction::ShowItemRequest& request)
 {
     IF_ASSERT_FAILED(request.item) {
@@ -588,10 +676,18 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     Transform guiScalingCompensation;
     guiScalingCompensation.scale(guiScaling, guiScaling);
 
-    painter->setWorldTransform(m_matrix * guiScalingCompensation);
+    Transform worldTransform = m_matrix * guiScalingCompensation;
 
+    //! NOTE The score is painted from the page cache, the interaction overlays on top of it
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    m_pageCache->setViewSize(SizeF(width(), height()));
+    m_pageCache->paint(qp, toLogical(rect), worldTransform, notation()->painting(), notationElements()->pages(), isPrinting);
+
+    painter->setWorldTransform(worldTransform);
+
+    if (!isPrinting) {
+        notation()->painting()->paintInteraction(painter);
+    }
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -608,6 +704,16 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     }
 }
 
+void AbstractNotationPaintView::setPageCache(std::unique_ptr<AbstractNotationPageCache> cache)
+{
+    m_pageCache = std::move(cache);
+    m_pageCache->setReadyCallback([this]() {
+        QMetaObject::invokeMethod(this, [this]() {
+            scheduleRedraw();
+        }, Qt::QueuedConnection);
+    });
+}
+
 void AbstractNotationPaintView::onNotationSetup()
 {
     TRACEFUNC;
@@ -627,14 +733,17 @@ void AbstractNotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        m_pageCache->clear();
         scheduleRedraw();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        m_pageCache->clear();
         scheduleRedraw();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        m_pageCache->clear();
         scheduleRedraw();
     });
 }
@@ -1244,6 +1353,7 @@ void AbstractNotationPaintView::dropEvent(QDropEvent* event)
 void AbstractNotationPaintView::setNotation(INotationPtr notation)
 {
     m_notation = notation;
+    m_pageCache->clear();
     m_continuousPanel->setNotation(m_notation);
     m_playbackCursor->setNotation(m_notation);
     m_loopInMarker->setNotation(m_notation);
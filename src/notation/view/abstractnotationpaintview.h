@@ -22,6 +22,8 @@
 #ifndef MU_NOTATION_ABSTRACTNOTATIONPAINTVIEW_H
 #define MU_NOTATION_ABSTRACTNOTATIONPAINTVIEW_H
 
+#include <set>
+
 #include <QTimer>
 
 #include "modularity/ioc.h"
@@ -45,6 +47,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "abstractnotationpagecache.h"
 #include "abstractelementpopupmodel.h"
 
 namespace mu::notation {
@@ -175,6 +178,7 @@ protected:
 
     // Draw
     void paint(QPainter* painter) override;
+    void setPageCache(std::unique_ptr<AbstractNotationPageCache> cache);
 
     virtual void onNotationSetup();
 
@@ -235,6 +239,10 @@ private:
 
     void onNoteInputStateChanged();
 
+    void markChangedPages();
+    void markSelectionPages();
+    std::set<int> selectionPageNumbers() const;
+
     void onShowItemRequested(const INotationInteraction::ShowItemRequest& request);
 
     void onPlayingChanged();
@@ -260,6 +268,10 @@ private:
     std::unique_ptr<LoopMarker> m_loopInMarker;
     std::unique_ptr<LoopMarker> m_loopOutMarker;
     std::unique_ptr<ContinuousPanel> m_continuousPanel;
+    std::unique_ptr<AbstractNotationPageCache> m_pageCache;
+    int m_lastLayoutNo = 0;
+    size_t m_lastPageCount = 0;
+    std::set<int> m_selectionPageNumbers;
 
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
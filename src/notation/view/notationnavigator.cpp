@@ -21,6 +21,8 @@
  */
 #include "notationnavigator.h"
 
+#include "notationthumbnailcache.h"
+
 #include "log.h"
 
 using namespace muse;
@@ -52,6 +54,9 @@ NotationNavigator::NotationNavigator(QQuickItem* parent)
     : AbstractNotationPaintView(parent), m_cursorRectView(new NotationNavigatorCursorView(this))
 {
     setReadonly(true);
+
+    //! NOTE The navigator shows the whole score in miniature, it's painted from the page thumbnails
+    setPageCache(std::make_unique<NotationThumbnailCache>());
 }
 
 void NotationNavigator::load()
@@ -0,0 +1,218 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationthumbnailcache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+
+#include "engraving/dom/page.h"
+
+#include "log.h"
+
+using namespace mu::notation;
+using namespace muse;
+using namespace muse::draw;
+
+static constexpr double SCALE_KEY_PRECISION = 1000000.0;
+
+//! NOTE The thumbnails are rendered at the zoom rounded up to a quarter of an octave,
+//! so that resizing the view doesn't render them again on each step
+static constexpr double SCALE_STEPS_PER_OCTAVE = 4.0;
+
+//! NOTE In device pixels. A thumbnail may be as large as the view, so that a large or a HiDPI view isn't blurry,
+//! and may be of the default size in a smaller view
+static constexpr double DEFAULT_MAX_THUMBNAIL_SIZE = 1024.0;
+static constexpr double MAX_THUMBNAIL_SIZE = 4096.0;
+
+static double roundUpToStep(double value)
+{
+    return std::exp2(std::ceil(std::log2(value) * SCALE_STEPS_PER_OCTAVE) / SCALE_STEPS_PER_OCTAVE);
+}
+
+static double maxThumbnailSize(const SizeF& viewSize, double devicePixelRatio)
+{
+    const double viewDeviceSize = std::max(viewSize.width(), viewSize.height()) * devicePixelRatio;
+    if (viewDeviceSize <= DEFAULT_MAX_THUMBNAIL_SIZE) {
+        return DEFAULT_MAX_THUMBNAIL_SIZE;
+    }
+
+    //! NOTE Rounded too, so that resizing the view doesn't render the thumbnails again on each step
+    return std::min(roundUpToStep(viewDeviceSize), MAX_THUMBNAIL_SIZE);
+}
+
+static int64_t thumbnailScaleKey(double deviceScale, const RectF& pageRect, double maxSize)
+{
+    double scale = roundUpToStep(deviceScale);
+
+    const double pageSize = std::max(pageRect.width(), pageRect.height());
+    if (pageSize * scale > maxSize) {
+        scale = maxSize / pageSize;
+    }
+
+    return std::llround(scale * SCALE_KEY_PRECISION);
+}
+
+void NotationThumbnailCache::paint(QPainter* painter, const RectF& frameRect, const Transform& transform,
+                                   const INotationPaintingPtr& painting, const PageList& pages, bool isPrinting)
+{
+    TRACEFUNC;
+
+    beginPaint(painter, pages, isPrinting);
+
+    m_thumbnails.resize(pages.size());
+
+    const double devicePixelRatio = painter->device()->devicePixelRatioF();
+    const double deviceScale = transform.m11() * devicePixelRatio;
+    if (deviceScale <= 0.0) {
+        return;
+    }
+
+    const double maxSize = maxThumbnailSize(viewSize(), devicePixelRatio);
+
+    std::vector<std::pair<int, PageSnapshotPtr> > outdated;
+
+    painter->save();
+    painter->setWorldTransform(Transform::toQTransform(transform));
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        const Page* page = pages.at(i);
+        const int pageNo = static_cast<int>(i);
+        const RectF pageRect = page->ldata()->bbox();
+        const PointF pagePos = page->pos();
+
+        const RectF visibleRect = frameRect.translated(-pagePos).intersected(pageRect);
+        if (visibleRect.isEmpty()) {
+            continue;
+        }
+
+        PageSnapshotPtr snapshot = pageSnapshot(pageNo, page, painting);
+        const int64_t scaleKey = thumbnailScaleKey(deviceScale, pageRect, maxSize);
+
+        Thumbnail& thumbnail = m_thumbnails.at(pageNo);
+        if (!thumbnail.image.isNull()) {
+            //! NOTE May be outdated or of another zoom, it's shown until the new one is ready
+            const double scale = thumbnail.scaleKey / SCALE_KEY_PRECISION;
+            const QRectF sourceRect(0.0, 0.0, pageRect.width() * scale, pageRect.height() * scale);
+            painter->drawImage(pageRect.translated(pagePos).toQRectF(), thumbnail.image, sourceRect);
+        } else {
+            //! NOTE Only the first time the page is shown
+            Transform base = transform;
+            base.translate(pagePos.x(), pagePos.y());
+
+            painter->save();
+            paintSnapshot(painter, *snapshot, base, visibleRect);
+            painter->restore();
+        }
+
+        const bool isUpToDate = thumbnail.revision == snapshot->revision && thumbnail.scaleKey == scaleKey;
+        const bool isPending = thumbnail.pendingRevision == snapshot->revision && thumbnail.pendingScaleKey == scaleKey;
+        if (!isUpToDate && !isPending) {
+            outdated.push_back({ pageNo, snapshot });
+        }
+    }
+
+    painter->restore();
+
+    for (const auto& [pageNo, snapshot] : outdated) {
+        if (!requestThumbnail(pageNo, snapshot, thumbnailScaleKey(deviceScale, snapshot->pageRect, maxSize))) {
+            break;
+        }
+    }
+}
+
+void NotationThumbnailCache::onPageChanged(int, const PageSnapshot*, const PageSnapshot&)
+{
+    //! NOTE The thumbnail is kept until the one of the new recording is ready
+}
+
+void NotationThumbnailCache::onPageRemoved(int pageNo)
+{
+    if (pageNo < static_cast<int>(m_thumbnails.size())) {
+        m_thumbnails.at(pageNo) = Thumbnail();
+    }
+}
+
+void NotationThumbnailCache::onCleared()
+{
+    m_thumbnails.clear();
+}
+
+bool NotationThumbnailCache::requestThumbnail(int pageNo, const PageSnapshotPtr& snapshot, int64_t scaleKey)
+{
+    const uint64_t revision = snapshot->revision;
+    const int dpiX = deviceDpiX();
+    const int dpiY = deviceDpiY();
+
+    auto render = [snapshot, scaleKey, dpiX, dpiY]() {
+        const double scale = scaleKey / SCALE_KEY_PRECISION;
+        const RectF& pageRect = snapshot->pageRect;
+
+        QImage image(std::max(1, static_cast<int>(std::ceil(pageRect.width() * scale))),
+                     std::max(1, static_cast<int>(std::ceil(pageRect.height() * scale))),
+                     QImage::Format_ARGB32_Premultiplied);
+        image.setDotsPerMeterX(std::lrint(dpiX / 0.0254));
+        image.setDotsPerMeterY(std::lrint(dpiY / 0.0254));
+        image.fill(Qt::transparent);
+
+        QPainter qp(&image);
+        const Transform base(scale, 0.0, 0.0, scale, -pageRect.x() * scale, -pageRect.y() * scale);
+        paintSnapshot(&qp, *snapshot, base, pageRect);
+
+        return image;
+    };
+
+    auto apply = [this, pageNo, revision, scaleKey](QImage& image) {
+        applyThumbnail(pageNo, revision, scaleKey, image);
+    };
+
+    if (!pushTask(std::move(render), std::move(apply))) {
+        return false;
+    }
+
+    Thumbnail& thumbnail = m_thumbnails.at(pageNo);
+    thumbnail.pendingRevision = revision;
+    thumbnail.pendingScaleKey = scaleKey;
+
+    return true;
+}
+
+void NotationThumbnailCache::applyThumbnail(int pageNo, uint64_t revision, int64_t scaleKey, QImage& image)
+{
+    if (pageNo >= static_cast<int>(m_thumbnails.size())) {
+        return;
+    }
+
+    //! NOTE Requested again after a change or a zoom in the meantime
+    Thumbnail& thumbnail = m_thumbnails.at(pageNo);
+    if (thumbnail.pendingRevision != revision || thumbnail.pendingScaleKey != scaleKey) {
+        return;
+    }
+
+    thumbnail.image = std::move(image);
+    thumbnail.revision = revision;
+    thumbnail.scaleKey = scaleKey;
+    thumbnail.pendingRevision = 0;
+    thumbnail.pendingScaleKey = 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTHUMBNAILCACHE_H
+#define MU_NOTATION_NOTATIONTHUMBNAILCACHE_H
+
+#include <vector>
+
+#include "abstractnotationpagecache.h"
+
+namespace mu::notation {
+//! NOTE Keeps a downscaled raster of each page, for the views that show the whole score in miniature.
+//! A thumbnail is rendered again in the background only when the layout has changed its page,
+//! until then the previous one is shown
+class NotationThumbnailCache : public AbstractNotationPageCache
+{
+public:
+    NotationThumbnailCache() = default;
+
+    void paint(QPainter* painter, const muse::RectF& frameRect, const muse::draw::Transform& transform,
+               const INotationPaintingPtr& painting, const PageList& pages, bool isPrinting) override;
+
+private:
+    struct Thumbnail {
+        QImage image;
+        uint64_t revision = 0;
+        int64_t scaleKey = 0;
+
+        uint64_t pendingRevision = 0;
+        int64_t pendingScaleKey = 0;
+    };
+
+    void onPageChanged(int pageNo, const PageSnapshot* oldSnapshot, const PageSnapshot& newSnapshot) override;
+    void onPageRemoved(int pageNo) override;
+    void onCleared() override;
+
+    bool requestThumbnail(int pageNo, const PageSnapshotPtr& snapshot, int64_t scaleKey);
+    void applyThumbnail(int pageNo, uint64_t revision, int64_t scaleKey, QImage& image);
+
+    std::vector<Thumbnail> m_thumbnails;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTHUMBNAILCACHE_H
@@ -0,0 +1,306 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QPainter>
+
+#include "engraving/dom/page.h"
+
+#include "log.h"
+
+using namespace mu::notation;
+using namespace muse;
+using namespace muse::draw;
+
+//! NOTE Tiles are only reused at exactly the same zoom
+static constexpr double SCALE_KEY_PRECISION = 1000000.0;
+
+//! NOTE ~128 MB of tiles
+static constexpr size_t MAX_TILES = 512;
+
+NotationTileCache::NotationTileCache()
+    : m_wantedScaleKey(std::make_shared<std::atomic<int64_t> >(0))
+{
+}
+
+NotationTileCache::~NotationTileCache()
+{
+    //! NOTE The queued tiles aren't needed anymore
+    *m_wantedScaleKey = 0;
+}
+
+void NotationTileCache::paint(QPainter* painter, const RectF& frameRect, const Transform& transform,
+                              const INotationPaintingPtr& painting, const PageList& pages, bool isPrinting)
+{
+    TRACEFUNC;
+
+    beginPaint(painter, pages, isPrinting);
+    ++m_paintNo;
+
+    //! NOTE Tiles are painted in device pixels
+    const double dpr = painter->device()->devicePixelRatioF();
+    const QTransform deviceTransform = Transform::toQTransform(transform) * QTransform::fromScale(dpr, dpr);
+    const int64_t scaleKey = std::llround(deviceTransform.m11() * SCALE_KEY_PRECISION);
+    if (scaleKey <= 0) {
+        return;
+    }
+
+    const double scale = scaleKey / SCALE_KEY_PRECISION;
+    const double tileSize = TILE_SIZE / scale; // in page coordinates
+    *m_wantedScaleKey = scaleKey;
+
+    struct MissingTiles {
+        PageSnapshotPtr snapshot;
+        QPoint origin;
+        QRegion region;
+        RectF rect;
+    };
+
+    struct PrefetchTile {
+        TileKey key;
+        RectF rect;
+        PageSnapshotPtr snapshot;
+    };
+
+    std::vector<MissingTiles> missing;
+    std::vector<PrefetchTile> prefetch;
+
+    painter->save();
+    painter->setWorldTransform(QTransform::fromScale(1.0 / dpr, 1.0 / dpr));
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        const Page* page = pages.at(i);
+        const int pageNo = static_cast<int>(i);
+        const RectF pageRect = page->ldata()->bbox();
+        const PointF pagePos = page->pos();
+
+        const RectF visibleRect = frameRect.translated(-pagePos).intersected(pageRect);
+        if (visibleRect.isEmpty()) {
+            continue;
+        }
+
+        PageSnapshotPtr snapshot = pageSnapshot(pageNo, page, painting);
+
+        const QPointF originF = deviceTransform.map(pagePos.toQPointF());
+        const QPoint origin(std::lround(originF.x()), std::lround(originF.y()));
+
+        const int firstCol = static_cast<int>(std::floor(pageRect.left() / tileSize));
+        const int lastCol = static_cast<int>(std::ceil(pageRect.right() / tileSize)) - 1;
+        const int firstRow = static_cast<int>(std::floor(pageRect.top() / tileSize));
+        const int lastRow = static_cast<int>(std::ceil(pageRect.bottom() / tileSize)) - 1;
+
+        const int visibleFirstCol = std::max(firstCol, static_cast<int>(std::floor(visibleRect.left() / tileSize)));
+        const int visibleLastCol = std::min(lastCol, static_cast<int>(std::floor(visibleRect.right() / tileSize)));
+        const int visibleFirstRow = std::max(firstRow, static_cast<int>(std::floor(visibleRect.top() / tileSize)));
+        const int visibleLastRow = std::min(lastRow, static_cast<int>(std::floor(visibleRect.bottom() / tileSize)));
+
+        MissingTiles pageMissing { snapshot, origin, QRegion(), RectF() };
+
+        //! NOTE The ring of tiles around the visible ones is prefetched
+        for (int row = std::max(firstRow, visibleFirstRow - 1); row <= std::min(lastRow, visibleLastRow + 1); ++row) {
+            for (int col = std::max(firstCol, visibleFirstCol - 1); col <= std::min(lastCol, visibleLastCol + 1); ++col) {
+                const TileKey key { pageNo, scaleKey, row, col };
+                const RectF rect(col * tileSize, row * tileSize, tileSize, tileSize);
+
+                auto it = m_tiles.find(key);
+                if (it != m_tiles.end()) {
+                    it->second.lastUsed = m_paintNo;
+                }
+
+                const bool isVisible = row >= visibleFirstRow && row <= visibleLastRow
+                                       && col >= visibleFirstCol && col <= visibleLastCol;
+                if (!isVisible) {
+                    if (it == m_tiles.end()) {
+                        prefetch.push_back({ key, rect, snapshot });
+                    }
+                    continue;
+                }
+
+                const QPoint tilePos(origin.x() + col * TILE_SIZE, origin.y() + row * TILE_SIZE);
+                if (it != m_tiles.end() && it->second.isReady) {
+                    painter->drawImage(tilePos, it->second.image);
+                    continue;
+                }
+
+                pageMissing.region += QRect(tilePos, QSize(TILE_SIZE, TILE_SIZE));
+                pageMissing.rect.unite(rect);
+
+                if (it == m_tiles.end()) {
+                    requestTile(key, rect, snapshot, scale);
+                }
+            }
+        }
+
+        if (!pageMissing.region.isEmpty()) {
+            missing.push_back(std::move(pageMissing));
+        }
+    }
+
+    //! NOTE Until their tiles are ready, the missing parts are painted directly from the recording
+    for (const MissingTiles& m : missing) {
+        painter->save();
+        painter->setClipRegion(m.region, Qt::IntersectClip);
+        const Transform base(scale / dpr, 0.0, 0.0, scale / dpr, m.origin.x() / dpr, m.origin.y() / dpr);
+        paintSnapshot(painter, *m.snapshot, base, m.rect);
+        painter->restore();
+    }
+
+    painter->restore();
+
+    for (const PrefetchTile& t : prefetch) {
+        if (!requestTile(t.key, t.rect, t.snapshot, scale)) {
+            break;
+        }
+    }
+
+    evictTiles();
+}
+
+void NotationTileCache::onPageChanged(int pageNo, const PageSnapshot* oldSnapshot, const PageSnapshot& newSnapshot)
+{
+    if (!oldSnapshot) {
+        onPageRemoved(pageNo);
+        return;
+    }
+
+    const std::vector<RectF> rects = changedRects(*oldSnapshot, newSnapshot);
+
+    auto it = m_tiles.lower_bound(TileKey { pageNo, std::numeric_limits<int64_t>::min(), std::numeric_limits<int>::min(),
+                                            std::numeric_limits<int>::min() });
+    while (it != m_tiles.end() && it->first.pageNo == pageNo) {
+        const RectF& tileRect = it->second.rect;
+        bool changed = std::any_of(rects.cbegin(), rects.cend(), [&tileRect](const RectF& r) {
+            return r.intersects(tileRect);
+        });
+
+        if (changed) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::onPageRemoved(int pageNo)
+{
+    auto first = m_tiles.lower_bound(TileKey { pageNo, std::numeric_limits<int64_t>::min(), std::numeric_limits<int>::min(),
+                                               std::numeric_limits<int>::min() });
+    auto last = first;
+    while (last != m_tiles.end() && last->first.pageNo == pageNo) {
+        ++last;
+    }
+    m_tiles.erase(first, last);
+}
+
+void NotationTileCache::onCleared()
+{
+    m_tiles.clear();
+}
+
+bool NotationTileCache::requestTile(const TileKey& key, const RectF& rect, const PageSnapshotPtr& snapshot, double scale)
+{
+    const uint64_t revision = snapshot->revision;
+    const int dpiX = deviceDpiX();
+    const int dpiY = deviceDpiY();
+
+    auto render = [wantedScaleKey = m_wantedScaleKey, snapshot, key, rect, scale, dpiX, dpiY]() {
+        QImage image;
+        if (wantedScaleKey->load() != key.scaleKey) {
+            return image;
+        }
+
+        image = QImage(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+        image.setDotsPerMeterX(std::lrint(dpiX / 0.0254));
+        image.setDotsPerMeterY(std::lrint(dpiY / 0.0254));
+        image.fill(Qt::transparent);
+
+        QPainter qp(&image);
+        const Transform base(scale, 0.0, 0.0, scale, -key.col * TILE_SIZE, -key.row * TILE_SIZE);
+        paintSnapshot(&qp, *snapshot, base, rect);
+
+        return image;
+    };
+
+    auto apply = [this, key, revision](QImage& image) {
+        applyTile(key, revision, image);
+    };
+
+    if (!pushTask(std::move(render), std::move(apply))) {
+        return false;
+    }
+
+    Tile& tile = m_tiles[key];
+    tile.rect = rect;
+    tile.revision = revision;
+    tile.lastUsed = m_paintNo;
+    tile.isReady = false;
+
+    return true;
+}
+
+void NotationTileCache::applyTile(const TileKey& key, uint64_t revision, QImage& image)
+{
+    auto it = m_tiles.find(key);
+    //! NOTE The tile was dropped or requested again after a change in the meantime
+    if (it == m_tiles.end() || it->second.isReady || it->second.revision != revision) {
+        return;
+    }
+
+    //! NOTE Skipped, because the zoom had changed before it started
+    if (image.isNull()) {
+        m_tiles.erase(it);
+        return;
+    }
+
+    it->second.image = std::move(image);
+    it->second.isReady = true;
+}
+
+void NotationTileCache::evictTiles()
+{
+    if (m_tiles.size() <= MAX_TILES) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, TileKey> > candidates;
+    for (const auto& [key, tile] : m_tiles) {
+        if (tile.lastUsed != m_paintNo) {
+            candidates.push_back({ tile.lastUsed, key });
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    const size_t targetSize = MAX_TILES * 3 / 4;
+    for (const auto& c : candidates) {
+        if (m_tiles.size() <= targetSize) {
+            break;
+        }
+        m_tiles.erase(c.second);
+    }
+}
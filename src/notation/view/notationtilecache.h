@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "abstractnotationpagecache.h"
+
+namespace mu::notation {
+//! NOTE Keeps the score rasterized in tiles, so that scrolling, returning to a zoom level
+//! and following the playback don't repaint the score from the DOM.
+//! Only the tiles whose content differs from the previous recording of their page are dropped
+class NotationTileCache : public AbstractNotationPageCache
+{
+public:
+    //! NOTE In device pixels
+    static constexpr int TILE_SIZE = 256;
+
+    NotationTileCache();
+    ~NotationTileCache() override;
+
+    void paint(QPainter* painter, const muse::RectF& frameRect, const muse::draw::Transform& transform,
+               const INotationPaintingPtr& painting, const PageList& pages, bool isPrinting) override;
+
+private:
+    struct TileKey {
+        int pageNo = 0;
+        int64_t scaleKey = 0;
+        int row = 0;
+        int col = 0;
+
+        bool operator<(const TileKey& o) const
+        {
+            return std::tie(pageNo, scaleKey, row, col) < std::tie(o.pageNo, o.scaleKey, o.row, o.col);
+        }
+    };
+
+    struct Tile {
+        QImage image;
+        muse::RectF rect; // in page coordinates
+        uint64_t revision = 0;
+        uint64_t lastUsed = 0;
+        bool isReady = false;
+    };
+
+    void onPageChanged(int pageNo, const PageSnapshot* oldSnapshot, const PageSnapshot& newSnapshot) override;
+    void onPageRemoved(int pageNo) override;
+    void onCleared() override;
+
+    bool requestTile(const TileKey& key, const muse::RectF& rect, const PageSnapshotPtr& snapshot, double scale);
+    void applyTile(const TileKey& key, uint64_t revision, QImage& image);
+    void evictTiles();
+
+    //! NOTE Shared with the worker tasks, which skip the tiles of another zoom
+    std::shared_ptr<std::atomic<int64_t> > m_wantedScaleKey;
+
+    std::map<TileKey, Tile> m_tiles;
+    uint64_t m_paintNo = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
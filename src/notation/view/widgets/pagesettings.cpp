@@ -337,6 +337,8 @@ void PageSettings::applyToAllParts()
     if (!_changeFlag) {
         return;
     }
+    score()->masterScore()->readDeferredExcerpts();
+
     for (Excerpt* e : score()->masterScore()->excerpts()) {
         applyToScore(e->excerptScore());
     }
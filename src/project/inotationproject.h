@@ -26,6 +26,7 @@
 
 #include "io/path.h"
 #include "types/ret.h"
+#include "async/promise.h"
 
 #include "iprojectaudiosettings.h"
 #include "notation/imasternotation.h"
@@ -70,6 +71,10 @@ public:
     virtual void setNeedAutoSave(bool val) = 0;
 
     virtual muse::Ret save(const muse::io::path_t& path = muse::io::path_t(), SaveMode saveMode = SaveMode::Save) = 0;
+
+    //! NOTE Like save(path, SaveMode::AutoSave), but only the serialization blocks the calling thread,
+    //! the compression and the disk I/O are done on a worker thread
+    virtual muse::async::Promise<muse::Ret> autoSaveInBackground(const muse::io::path_t& path) = 0;
     virtual muse::Ret writeToDevice(QIODevice* device) = 0;
 
     virtual ProjectMeta metaInfo() const = 0;
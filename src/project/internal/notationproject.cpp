@@ -21,6 +21,8 @@
  */
 #include "notationproject.h"
 
+#include <chrono>
+
 #include <QBuffer>
 #include <QDir>
 #include <QFile>
@@ -28,6 +30,7 @@
 #include "global/io/buffer.h"
 #include "global/io/file.h"
 #include "global/io/ioretcodes.h"
+#include "global/concurrency/concurrent.h"
 
 #include "engraving/dom/undo.h"
 
@@ -40,10 +43,12 @@
 #include "engraving/engravingerrors.h"
 #include "engraving/style/defaultstyle.h"
 #include "engraving/rendering/dev/beamlayout.h"
+#include "engraving/types/constants.h"
 
 #include "iprojectautosaver.h"
 #include "notation/notationerrors.h"
 #include "projectaudiosettings.h"
+#include "projectlayoutcache.h"
 #include "projectfileinfoprovider.h"
 #include "projecterrors.h"
 
@@ -57,6 +62,86 @@ using namespace mu::engraving;
 using namespace mu::notation;
 using namespace mu::project;
 
+using Clock = std::chrono::steady_clock;
+
+static int64_t msecsSince(Clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+static std::string autoSaveSuffix(const muse::io::path_t& path)
+{
+    std::string suffix = io::suffix(path);
+    if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
+        suffix = io::suffix(io::completeBasename(path));
+    }
+
+    if (suffix.empty()) {
+        // Then it must be a MSCX folder
+        suffix = engraving::MSCX;
+    }
+
+    return suffix;
+}
+
+static MscWriter::Params saveWriterParams(const muse::io::path_t& path, MscIoMode ioMode, bool deferred)
+{
+    MscWriter::Params params;
+    params.filePath = engraving::containerPath(path).toQString() + "_saving";
+    params.mainFileName = engraving::mainFileName(path).toQString();
+    params.mode = ioMode;
+    params.deferred = deferred;
+
+    return params;
+}
+
+//! NOTE Doesn't use the project, so it can be called on any thread
+static Ret replaceSavedFile(const std::shared_ptr<io::IFileSystem>& fileSystem, const muse::io::path_t& path, MscIoMode ioMode)
+{
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    muse::io::path_t targetMainFilePath = engraving::mainFilePath(path);
+    QString savePath = targetContainerPath + "_saving";
+
+    if (ioMode == MscIoMode::Dir) {
+        RetVal<io::paths_t> filesToBeMoved = fileSystem->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
+        if (!filesToBeMoved.ret) {
+            return filesToBeMoved.ret;
+        }
+
+        Ret ret = muse::make_ok();
+
+        for (const muse::io::path_t& fileToBeMoved : filesToBeMoved.val) {
+            muse::io::path_t destinationFile
+                = muse::io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
+            LOGD() << fileToBeMoved << " to " << destinationFile;
+            ret = fileSystem->move(fileToBeMoved, destinationFile, true);
+            if (!ret) {
+                return ret;
+            }
+        }
+
+        // Try to remove the temp save folder (not problematic if fails)
+        ret = fileSystem->remove(savePath, true);
+        if (!ret) {
+            LOGW() << ret.toString();
+        }
+    } else {
+        Ret ret = fileSystem->move(savePath, targetContainerPath, true);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    // make file readable by all
+    {
+        QFile::setPermissions(targetMainFilePath.toQString(),
+                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+    }
+
+    LOGI() << "success save file: " << targetContainerPath;
+    return make_ret(Ret::Code::Ok);
+}
+
 static void setupScoreMetaTags(mu::engraving::MasterScore* masterScore, const ProjectCreateOptions& projectOptions)
 {
     if (!projectOptions.title.isEmpty()) {
@@ -180,6 +265,9 @@ Ret NotationProject::doLoad(const muse::io::path_t& path, const muse::io::path_t
         return ret;
     }
 
+    //! NOTE Migration changes the version
+    const bool isCurrentVersion = masterScore->mscVersion() == engraving::Constants::MSC_VERSION;
+
     // Migration
     if (migrator()) {
         masterScore->lockUpdates(false); // because migration needs a second layout
@@ -197,12 +285,33 @@ Ret NotationProject::doLoad(const muse::io::path_t& path, const muse::io::path_t
 
     mu::engraving::compat::EngravingCompat::doPreLayoutCompatIfNeeded(m_engravingProject->masterScore());
 
+    // Layout cache, only for files that are laid out exactly as they are written
+    muse::io::path_t layoutCachePath;
+    std::string layoutCacheKey;
+    engraving::LayoutBreaks cachedBreaks;
+    if (configuration()->isLayoutCacheEnabled() && isCurrentVersion) {
+        layoutCachePath = ProjectLayoutCache::cacheFilePath(path);
+        layoutCacheKey = ProjectLayoutCache::makeKey(path, stylePath);
+        cachedBreaks = ProjectLayoutCache::read(layoutCachePath, layoutCacheKey);
+        masterScore->setLayoutBreaksHint(cachedBreaks);
+    }
+
     masterScore->lockUpdates(false);
     masterScore->setLayoutAll();
     masterScore->update();
 
     mu::engraving::compat::EngravingCompat::doPostLayoutCompatIfNeeded(m_engravingProject->masterScore());
 
+    if (!layoutCacheKey.empty()) {
+        engraving::LayoutBreaks breaks = masterScore->layoutBreaks();
+        if (breaks != cachedBreaks) {
+            Ret cacheRet = ProjectLayoutCache::write(layoutCachePath, layoutCacheKey, breaks);
+            if (!cacheRet) {
+                LOGW() << "failed to write layout cache: " << layoutCachePath << ", err: " << cacheRet.toString();
+            }
+        }
+    }
+
     // Load audio settings
     bool tryCompatAudio = false;
     ret = m_projectAudioSettings->read(reader);
@@ -494,17 +603,7 @@ Ret NotationProject::save(const muse::io::path_t& path, SaveMode saveMode)
         return ret;
     }
     case SaveMode::AutoSave:
-        std::string suffix = io::suffix(path);
-        if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
-            suffix = io::suffix(io::completeBasename(path));
-        }
-
-        if (suffix.empty()) {
-            // Then it must be a MSCX folder
-            suffix = engraving::MSCX;
-        }
-
-        return saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/);
+        return saveScore(path, autoSaveSuffix(path), false /*generateBackup*/, false /*createThumbnail*/);
     }
 
     return make_ret(notation::Err::UnknownError);
@@ -565,40 +664,16 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
 {
     TRACEFUNC;
 
-    QString targetContainerPath = engraving::containerPath(path).toQString();
-    muse::io::path_t targetMainFilePath = engraving::mainFilePath(path);
-    muse::io::path_t targetMainFileName = engraving::mainFileName(path);
-    QString savePath = targetContainerPath + "_saving";
-
     // Step 1: check writable
-    {
-        if ((fileSystem()->exists(savePath) && !fileSystem()->isWritable(savePath))
-            || (fileSystem()->exists(targetContainerPath) && !fileSystem()->isWritable(targetContainerPath))) {
-            LOGE() << "failed save, not writable path: " << targetContainerPath;
-            return make_ret(io::Err::FSWriteError);
-        }
-
-        if (ioMode == engraving::MscIoMode::Dir) {
-            // Dir needs to be created, otherwise we can't move to it
-            if (!QDir(targetContainerPath).mkpath(".")) {
-                LOGE() << "Couldn't create container directory: " << targetContainerPath;
-                return make_ret(io::Err::FSMakingError);
-            }
-        }
+    Ret ret = prepareSavePath(path, ioMode);
+    if (!ret) {
+        return ret;
     }
 
     // Step 2: write project
     {
-        MscWriter::Params params;
-        params.filePath = savePath;
-        params.mainFileName = targetMainFileName.toQString();
-        params.mode = ioMode;
-        IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
-            return make_ret(Ret::Code::InternalError);
-        }
-
-        MscWriter msczWriter(params);
-        Ret ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
+        MscWriter msczWriter(saveWriterParams(path, ioMode, false /*deferred*/));
+        ret = writeProject(msczWriter, false /*onlySelection*/, createThumbnail);
         msczWriter.close();
 
         if (!ret) {
@@ -620,46 +695,86 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
     }
 
     // Step 4: replace to saved file
-    {
-        if (ioMode == MscIoMode::Dir) {
-            RetVal<io::paths_t> filesToBeMoved = fileSystem()->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
-            if (!filesToBeMoved.ret) {
-                return filesToBeMoved.ret;
-            }
+    return replaceSavedFile(fileSystem(), path, ioMode);
+}
 
-            Ret ret = muse::make_ok();
+async::Promise<Ret> NotationProject::autoSaveInBackground(const muse::io::path_t& path)
+{
+    return async::Promise<Ret>([this, path](auto resolve, auto /*reject*/) {
+        TRACEFUNC;
 
-            for (const muse::io::path_t& fileToBeMoved : filesToBeMoved.val) {
-                muse::io::path_t destinationFile
-                    = muse::io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
-                LOGD() << fileToBeMoved << " to " << destinationFile;
-                ret = fileSystem()->move(fileToBeMoved, destinationFile, true);
-                if (!ret) {
-                    return ret;
-                }
-            }
+        std::string suffix = autoSaveSuffix(path);
+        if (!isMuseScoreFile(suffix)) {
+            return resolve(exportProject(path, suffix));
+        }
 
-            // Try to remove the temp save folder (not problematic if fails)
-            ret = fileSystem()->remove(savePath, true);
-            if (!ret) {
-                LOGW() << ret.toString();
-            }
-        } else {
-            Ret ret = fileSystem()->move(savePath, targetContainerPath, true);
-            if (!ret) {
-                return ret;
-            }
+        MscIoMode ioMode = mscIoModeBySuffix(suffix);
+
+        // Step 1: check writable
+        Ret ret = prepareSavePath(path, ioMode);
+        if (!ret) {
+            return resolve(ret);
         }
+
+        // Step 2: serialize project, the files are kept in memory
+        Clock::time_point serializeStart = Clock::now();
+
+        std::shared_ptr<MscWriter> msczWriter = std::make_shared<MscWriter>(saveWriterParams(path, ioMode, true /*deferred*/));
+        ret = writeProject(*msczWriter, false /*onlySelection*/, false /*createThumbnail*/);
+        if (!ret) {
+            LOGE() << "failed write project to buffer: " << ret.toString();
+            return resolve(ret);
+        }
+
+        const int64_t blockingMsecs = msecsSince(serializeStart);
+
+        // Step 3: compress, write and replace to saved file, the project isn't used anymore
+        Concurrent::run([fileSystem = fileSystem(), msczWriter, path, ioMode, blockingMsecs, resolve]() {
+            Clock::time_point writeStart = Clock::now();
+
+            msczWriter->close();
+
+            Ret ret = make_ret(Ret::Code::UnknownError);
+            if (msczWriter->hasError()) {
+                LOGE() << "MscWriter has error after writing project";
+            } else {
+                ret = replaceSavedFile(fileSystem, path, ioMode);
+            }
+
+            ret.setData("blockingMsecs", blockingMsecs);
+            ret.setData("backgroundMsecs", msecsSince(writeStart));
+
+            (void)resolve(ret);
+        });
+
+        return async::Promise<Ret>::Result::unchecked();
+    });
+}
+
+Ret NotationProject::prepareSavePath(const muse::io::path_t& path, engraving::MscIoMode ioMode)
+{
+    IF_ASSERT_FAILED(ioMode != MscIoMode::Unknown) {
+        return make_ret(Ret::Code::InternalError);
     }
 
-    // make file readable by all
-    {
-        QFile::setPermissions(targetMainFilePath.toQString(),
-                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    QString savePath = targetContainerPath + "_saving";
+
+    if ((fileSystem()->exists(savePath) && !fileSystem()->isWritable(savePath))
+        || (fileSystem()->exists(targetContainerPath) && !fileSystem()->isWritable(targetContainerPath))) {
+        LOGE() << "failed save, not writable path: " << targetContainerPath;
+        return make_ret(io::Err::FSWriteError);
     }
 
-    LOGI() << "success save file: " << targetContainerPath;
-    return make_ret(Ret::Code::Ok);
+    if (ioMode == engraving::MscIoMode::Dir) {
+        // Dir needs to be created, otherwise we can't move to it
+        if (!QDir(targetContainerPath).mkpath(".")) {
+            LOGE() << "Couldn't create container directory: " << targetContainerPath;
+            return make_ret(io::Err::FSMakingError);
+        }
+    }
+
+    return make_ok();
 }
 
 Ret NotationProject::makeCurrentFileAsBackup()
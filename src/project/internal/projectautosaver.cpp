@@ -21,6 +21,8 @@
  */
 #include "projectautosaver.h"
 
+#include <any>
+
 #include "engraving/infrastructure/mscio.h"
 
 #include "defer.h"
@@ -167,18 +169,41 @@ void ProjectAutoSaver::onTrySave()
         return;
     }
 
-    muse::io::path_t projectPath = this->projectPath(project);
-    muse::io::path_t savePath = project->isNewlyCreated() ? projectPath : projectAutoSavePath(projectPath);
-
-    Ret ret = project->save(savePath, SaveMode::AutoSave);
-    if (!ret) {
-        LOGE() << "[autosave] failed to save project, err: " << ret.toString();
+    if (m_isSaving) {
+        LOGD() << "[autosave] previous save is still in progress";
         return;
     }
 
+    muse::io::path_t projectPath = this->projectPath(project);
+    muse::io::path_t savePath = project->isNewlyCreated() ? projectPath : projectAutoSavePath(projectPath);
+
+    //! NOTE The changes made while the file is being written will be saved next time
+    m_isSaving = true;
     project->setNeedAutoSave(false);
 
-    LOGD() << "[autosave] successfully saved project";
+    project->autoSaveInBackground(savePath).onResolve(this, [this, project, projectPath](const Ret& ret) {
+        m_isSaving = false;
+
+        if (!ret) {
+            LOGE() << "[autosave] failed to save project, err: " << ret.toString();
+            project->setNeedAutoSave(true);
+            return;
+        }
+
+        //! NOTE The project was saved or closed while its autosave was being written
+        if (m_lastProjectPathNeedingAutosave != projectPath) {
+            removeProjectUnsavedChanges(projectPath);
+        }
+
+        std::any blockingMsecs = ret.data("blockingMsecs");
+        std::any backgroundMsecs = ret.data("backgroundMsecs");
+        if (blockingMsecs.has_value() && backgroundMsecs.has_value()) {
+            LOGI() << "[autosave] successfully saved project, blocked the UI for " << std::any_cast<int64_t>(blockingMsecs)
+                   << " ms, written in the background in " << std::any_cast<int64_t>(backgroundMsecs) << " ms";
+        } else {
+            LOGD() << "[autosave] successfully saved project";
+        }
+    });
 }
 
 muse::io::path_t ProjectAutoSaver::projectPath(INotationProjectPtr project) const
@@ -64,6 +64,7 @@ private:
 
     QTimer m_timer;
     muse::io::path_t m_lastProjectPathNeedingAutosave;
+    bool m_isSaving = false;
 };
 }
 
@@ -681,3 +681,13 @@ void ProjectConfiguration::setDisableVersionChecking(bool disable)
 {
     settings()->setSharedValue(DISABLE_VERSION_CHECKING, Val(disable));
 }
+
+bool ProjectConfiguration::isLayoutCacheEnabled() const
+{
+    return m_layoutCacheEnabled;
+}
+
+void ProjectConfiguration::setLayoutCacheEnabled(bool enabled)
+{
+    m_layoutCacheEnabled = enabled;
+}
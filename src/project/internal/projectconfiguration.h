@@ -155,6 +155,9 @@ public:
     bool disableVersionChecking() const override;
     void setDisableVersionChecking(bool disable) override;
 
+    bool isLayoutCacheEnabled() const override;
+    void setLayoutCacheEnabled(bool enabled) override;
+
 private:
     muse::io::path_t appTemplatesPath() const;
     muse::io::path_t legacyCloudProjectsPath() const;
@@ -172,6 +175,8 @@ private:
     muse::async::Channel<bool> m_alsoShareAudioComChanged;
 
     mutable std::map<MigrationType, MigrationOptions> m_migrationOptions;
+
+    bool m_layoutCacheEnabled = false;
 };
 }
 
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "projectlayoutcache.h"
+
+#include <QFontDatabase>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "log.h"
+
+using namespace mu::project;
+using namespace mu::engraving;
+using namespace muse;
+
+static constexpr int LAYOUT_CACHE_VERSION = 1;
+
+static QJsonArray toJsonArray(const std::vector<size_t>& values)
+{
+    QJsonArray arr;
+    for (size_t v : values) {
+        arr.append(static_cast<qint64>(v));
+    }
+    return arr;
+}
+
+static std::vector<size_t> fromJsonArray(const QJsonArray& arr)
+{
+    std::vector<size_t> values;
+    values.reserve(arr.size());
+    for (const QJsonValue& v : arr) {
+        values.push_back(static_cast<size_t>(v.toInteger()));
+    }
+    return values;
+}
+
+//! NOTE The text metrics depend on the installed fonts (system and user ones), and the symbol metrics on the music fonts.
+//! The bundled fonts are covered by the application build
+std::string ProjectLayoutCache::fontsState()
+{
+    std::string state;
+
+    QStringList families = QFontDatabase::families();
+    families.sort();
+    for (const QString& family : families) {
+        state += family.toStdString() + ":" + QFontDatabase::styles(family).join(",").toStdString() + ";";
+    }
+
+    for (const IEngravingFontPtr& font : engravingFonts()->fonts()) {
+        state += font->name() + ":" + font->family() + ";";
+    }
+
+    return state;
+}
+
+io::path_t ProjectLayoutCache::cacheFilePath(const io::path_t& projectPath)
+{
+    return projectPath + ".layoutcache";
+}
+
+std::string ProjectLayoutCache::makeKey(const io::path_t& projectPath, const io::path_t& stylePath)
+{
+    ByteArray data;
+    Ret ret = fileSystem()->readFile(projectPath, data);
+    if (!ret) {
+        LOGE() << "failed to read project file: " << projectPath << ", err: " << ret.toString();
+        return std::string();
+    }
+
+    if (!stylePath.empty()) {
+        ByteArray styleData;
+        ret = fileSystem()->readFile(stylePath, styleData);
+        if (!ret) {
+            LOGE() << "failed to read style file: " << stylePath << ", err: " << ret.toString();
+            return std::string();
+        }
+        data.push_back(styleData);
+    }
+
+    // the layout may change between builds, even for the same version
+    std::string build = application()->fullVersion().toStdString() + "/" + application()->revision().toStdString();
+    data.push_back(reinterpret_cast<const uint8_t*>(build.data()), build.size());
+
+    std::string fonts = fontsState();
+    data.push_back(reinterpret_cast<const uint8_t*>(fonts.data()), fonts.size());
+
+    ByteArray hash = cryptographicHash()->hash(data, ICryptographicHash::Algorithm::Md4);
+    return hash.toQByteArrayNoCopy().toHex().toStdString();
+}
+
+LayoutBreaks ProjectLayoutCache::read(const io::path_t& cachePath, const std::string& key)
+{
+    if (key.empty() || !fileSystem()->exists(cachePath)) {
+        return LayoutBreaks();
+    }
+
+    ByteArray data;
+    Ret ret = fileSystem()->readFile(cachePath, data);
+    if (!ret) {
+        LOGW() << "failed to read layout cache: " << cachePath << ", err: " << ret.toString();
+        return LayoutBreaks();
+    }
+
+    QJsonObject rootObj = QJsonDocument::fromJson(data.toQByteArrayNoCopy()).object();
+    if (rootObj.value("version").toInt() != LAYOUT_CACHE_VERSION
+        || rootObj.value("key").toString().toStdString() != key) {
+        LOGD() << "outdated layout cache: " << cachePath;
+        return LayoutBreaks();
+    }
+
+    LayoutBreaks breaks;
+    breaks.systemMeasureCounts = fromJsonArray(rootObj.value("systems").toArray());
+    breaks.pageSystemCounts = fromJsonArray(rootObj.value("pages").toArray());
+
+    return breaks;
+}
+
+Ret ProjectLayoutCache::write(const io::path_t& cachePath, const std::string& key, const LayoutBreaks& breaks)
+{
+    QJsonObject rootObj;
+    rootObj["version"] = LAYOUT_CACHE_VERSION;
+    rootObj["key"] = QString::fromStdString(key);
+    rootObj["systems"] = toJsonArray(breaks.systemMeasureCounts);
+    rootObj["pages"] = toJsonArray(breaks.pageSystemCounts);
+
+    QByteArray json = QJsonDocument(rootObj).toJson(QJsonDocument::Compact);
+    return fileSystem()->writeFile(cachePath, ByteArray::fromQByteArrayNoCopy(json));
+}
@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2025 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_PROJECT_PROJECTLAYOUTCACHE_H
+#define MU_PROJECT_PROJECTLAYOUTCACHE_H
+
+#include <string>
+
+#include "modularity/ioc.h"
+#include "global/iapplication.h"
+#include "global/icryptographichash.h"
+#include "io/ifilesystem.h"
+#include "types/ret.h"
+
+#include "engraving/iengravingfontsprovider.h"
+#include "engraving/rendering/layoutoptions.h"
+
+namespace mu::project {
+//! NOTE A sidecar file next to the project with the system and page breaks of its last layout.
+//! It is keyed by a hash of the project file, the applied style, the application build and the fonts,
+//! so a re-export of an unchanged score can follow the breaks instead of searching for them.
+class ProjectLayoutCache
+{
+    INJECT_STATIC(muse::IApplication, application)
+    INJECT_STATIC(muse::ICryptographicHash, cryptographicHash)
+    INJECT_STATIC(muse::io::IFileSystem, fileSystem)
+    INJECT_STATIC(engraving::IEngravingFontsProvider, engravingFonts)
+
+public:
+    static muse::io::path_t cacheFilePath(const muse::io::path_t& projectPath);
+    static std::string makeKey(const muse::io::path_t& projectPath, const muse::io::path_t& stylePath);
+
+    static engraving::LayoutBreaks read(const muse::io::path_t& cachePath, const std::string& key);
+    static muse::Ret write(const muse::io::path_t& cachePath, const std::string& key, const engraving::LayoutBreaks& breaks);
+
+private:
+    static std::string fontsState();
+};
+}
+
+#endif // MU_PROJECT_PROJECTLAYOUTCACHE_H
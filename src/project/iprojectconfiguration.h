@@ -160,6 +160,10 @@ public:
 
     virtual bool disableVersionChecking() const = 0;
     virtual void setDisableVersionChecking(bool disable) = 0;
+
+    //! NOTE Follow and update the breaks stored in a sidecar of the loaded file, see ProjectLayoutCache
+    virtual bool isLayoutCacheEnabled() const = 0;
+    virtual void setLayoutCacheEnabled(bool enabled) = 0;
 };
 }
 
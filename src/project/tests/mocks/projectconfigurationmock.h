@@ -137,6 +137,9 @@ public:
 
     MOCK_METHOD(bool, disableVersionChecking, (), (const, override));
     MOCK_METHOD(void, setDisableVersionChecking, (bool), (override));
+
+    MOCK_METHOD(bool, isLayoutCacheEnabled, (), (const, override));
+    MOCK_METHOD(void, setLayoutCacheEnabled, (bool), (override));
 };
 }
 
@@ -494,6 +494,21 @@ void ExportDialogModel::setBitRate(int rate)
     emit bitRateChanged(rate);
 }
 
+bool ExportDialogModel::audioExportStems() const
+{
+    return audioExportConfiguration()->exportStems();
+}
+
+void ExportDialogModel::setAudioExportStems(bool exportStems)
+{
+    if (exportStems == audioExportStems()) {
+        return;
+    }
+
+    audioExportConfiguration()->setExportStems(exportStems);
+    emit audioExportStemsChanged(exportStems);
+}
+
 bool ExportDialogModel::midiExpandRepeats() const
 {
     return midiImportExportConfiguration()->isExpandRepeats();